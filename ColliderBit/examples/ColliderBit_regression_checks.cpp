@@ -0,0 +1,152 @@
+//   GAMBIT: Global and Modular BSM Inference Tool
+//   *********************************************
+///  \file
+///
+///  Regression checks for the parts of ColliderBit
+///  that the event loop runs concurrently or
+///  that were sped up:
+///  - the per-thread detector random number streams
+///  - the per-thread Particle and Jet pools
+///  - the LEP limit averages over the contours
+///
+///  Returns non-zero if any check fails.
+///
+///  *********************************************
+///
+///  Authors (add name and date if you modify):
+///
+///  \author agent
+///          (agent@local)
+///  \date 2026 Oct
+///
+///  *********************************************
+
+#include <cmath>
+#include <random>
+#include <vector>
+#include <memory>
+#include <iostream>
+
+#include <omp.h>
+
+#include "gambit/ColliderBit/Utils.hpp"
+#include "gambit/ColliderBit/limits/ALEPHSleptonLimits.hpp"
+#include "gambit/ColliderBit/limits/L3GauginoLimits.hpp"
+#include "gambit/ColliderBit/limits/OPALGauginoLimits.hpp"
+#include "HEPUtils/Event.h"
+
+using namespace Gambit::ColliderBit;
+using namespace HEPUtils;
+
+using std::cout;
+using std::endl;
+
+namespace
+{
+
+  int failures = 0;
+
+  void check(bool passed, const std::string& what)
+  {
+    cout << (passed ? "  passed: " : "  FAILED: ") << what << endl;
+    if (not passed) failures++;
+  }
+
+  /// Draw a few numbers of each kind from the calling thread's detector stream
+  std::vector<double> draw(int seed_base, int thread)
+  {
+    seed_detector_rng(seed_base, thread);
+    std::vector<double> u, g;
+    random_uniform(u, 50);
+    random_normal(g, 50, 1.0, 0.1);
+    u.insert(u.end(), g.begin(), g.end());
+    u.push_back(random_uniform());
+    return u;
+  }
+
+  /// Whether limitAverage, which only tests the rays that can cross each contour segment,
+  /// gives exactly the same result as limitAverageAllRays at random points in the given box
+  bool same_averages(const BaseLimitContainer& limit, double xmin, double xmax, double ymin, double ymax)
+  {
+    std::mt19937 gen(2016);
+    std::uniform_real_distribution<double> x(xmin, xmax), y(ymin, ymax);
+    for (int i = 0; i < 20000; i++)
+    {
+      double px = x(gen), py = y(gen);
+      if (limit.limitAverage(px, py, 91.1876) != limit.limitAverageAllRays(px, py, 91.1876)) return false;
+    }
+    return true;
+  }
+
+}
+
+int main()
+{
+
+  cout << endl << "Starting ColliderBit regression checks" << endl;
+  cout << "----------" << endl;
+
+  // Detector smearing must be reproducible for a fixed seed, whatever thread runs it
+  cout << endl << "Detector random number streams:" << endl;
+  const int nthreads = 4;
+  std::vector<std::vector<double>> serial(nthreads), parallel(nthreads);
+  for (int t = 0; t < nthreads; t++) serial[t] = draw(12345, t);
+  check(draw(12345, 0) == serial[0], "reseeding a stream reproduces it");
+  check(serial[0] != serial[1], "different threads get different streams");
+  #pragma omp parallel for num_threads(nthreads) schedule(static, 1)
+  for (int t = 0; t < nthreads; t++) parallel[t] = draw(12345, t);
+  check(parallel == serial, "streams drawn concurrently match the serial ones");
+
+  // Objects freed by one thread must be safely reusable by it, whichever thread allocated them
+  cout << endl << "Particle and jet pools:" << endl;
+  bool pools_ok = true;
+  #pragma omp parallel num_threads(nthreads) reduction(&&:pools_ok)
+  {
+    Event e;
+    for (int ev = 0; ev < 200; ev++)
+    {
+      e.clear();
+      for (int i = 0; i < 40; i++)
+      {
+        Particle* p = new Particle(P4::mkXYZM(1.+i, 2., 3., 0.1), 11);
+        p->set_prompt();
+        e.add_particle(p);
+      }
+      for (int i = 0; i < 10; i++) e.add_jet(new Jet(P4::mkXYZM(10.+i, 2., 3., 1.)));
+      std::unique_ptr<Event> copy(e.clone());
+      pools_ok = pools_ok and copy->particles().size() == 40 and copy->jets().size() == 10;
+      for (int i = 0; i < 40; i++) pools_ok = pools_ok and copy->particles()[i]->pid() == 11
+                                                        and copy->particles()[i]->mom().px() == 1.+i;
+    }
+    pools_ok = pools_ok and BlockPool<Particle>::num_free() <= BlockPool<Particle>::max_free()
+                        and BlockPool<Jet>::num_free() <= BlockPool<Jet>::max_free();
+  }
+  check(pools_ok, "events filled, copied and cleared concurrently keep their contents");
+  std::vector<Particle*> handover(1000);
+  for (auto& p : handover) p = new Particle(P4::mkXYZM(1., 0., 0., 0.), 22);
+  #pragma omp parallel for num_threads(nthreads) schedule(static) reduction(&&:pools_ok)
+  for (size_t i = 0; i < handover.size(); i++)
+  {
+    delete handover[i];
+    handover[i] = new Particle(P4::mkXYZM(1.+i, 0., 0., 0.), 13);
+    pools_ok = pools_ok and handover[i]->pid() == 13 and handover[i]->mom().px() == 1.+i;
+  }
+  for (auto& p : handover) delete p;
+  check(pools_ok, "particles allocated on one thread can be freed and reused on others");
+
+  // Skipping the rays that cannot cross a segment must not change the limit averages
+  cout << endl << "LEP limit averages:" << endl;
+  check(same_averages(ALEPHSelectronLimitAt208GeV(), 40, 110, 0, 110), "ALEPH selectron limit");
+  check(same_averages(L3NeutralinoAllChannelsLimitAt188pt6GeV(), 0, 200, 0, 100), "L3 neutralino limit");
+  check(same_averages(OPALCharginoHadronicLimitAt208GeV(), 45, 105, 0, 105), "OPAL chargino limit");
+
+  cout << endl;
+  if (failures > 0)
+  {
+    cout << "ColliderBit regression checks: " << failures << " FAILED." << endl << endl;
+    return 1;
+  }
+  cout << "ColliderBit regression checks passed." << endl << endl;
+  return 0;
+
+}
@@ -11,7 +11,6 @@
 #include "HEPUtils/BinnedFn.h"
 #include "HEPUtils/Event.h"
 
-#include <random>
 
 namespace Gambit {
   namespace ColliderBit {
@@ -104,9 +103,6 @@ namespace Gambit {
           // Function that mimics the DELPHES electron energy resolution
           // We need to smear E, then recalculate pT, then reset 4 vector
 
-          std::random_device rd;
-          std::mt19937 gen(rd());
-
           static HEPUtils::BinnedFn2D<double> coeffE2({{0, 2.5, 3., 5.}}, //< |eta|
                                                       {{0, 0.1, 25., DBL_MAX}}, //< pT
                                                       {{0.,          0.015*0.015, 0.005*0.005,
@@ -125,8 +121,13 @@ namespace Gambit {
                                                        0.25*0.25,0.25*0.25,0.25*0.25,
                                                        0.,       0.,       0.}});
 
+          // Draw all the Gaussian numbers needed for this event at once
+          static thread_local std::vector<double> z;
+          random_normal(z, electrons.size());
+
           // Now loop over the electrons and smear the 4-vectors
-          for (HEPUtils::Particle* e : electrons) {
+          for (size_t i = 0; i < electrons.size(); ++i) {
+            HEPUtils::Particle* e = electrons[i];
             if (e->abseta() > 5) continue;
 
             // Look up / calculate resolution
@@ -136,8 +137,7 @@ namespace Gambit {
             const double resolution = sqrt(c1*HEPUtils::sqr(e->E()) + c2*e->E() + c3);
 
             // Smear by a Gaussian centered on the current energy, with width given by the resolution
-            std::normal_distribution<> d(e->E(), resolution);
-            double smeared_E = d(gen);
+            double smeared_E = e->E() + resolution*z[i];
             if (smeared_E < 0) smeared_E = 0;
             // double smeared_pt = smeared_E/cosh(e->eta()); ///< @todo Should be cosh(|eta|)?
             // std::cout << "BEFORE eta " << electron->eta() << std::endl;
@@ -152,24 +152,25 @@ namespace Gambit {
           // Function that mimics the DELPHES muon momentum resolution
           // We need to smear pT, then recalculate E, then reset 4 vector
 
-          std::random_device rd;
-          std::mt19937 gen(rd());
-
           static HEPUtils::BinnedFn2D<double> _muEff({{0,1.5,2.5}},
                                                      {{0,0.1,1.,10.,200.,DBL_MAX}},
                                                      {{0.,0.03,0.02,0.03,0.05,
                                                        0.,0.04,0.03,0.04,0.05}});
 
+          // Draw all the Gaussian numbers needed for this event at once
+          static thread_local std::vector<double> z;
+          random_normal(z, muons.size());
+
           // Now loop over the muons and smear the 4-vectors
-          for (HEPUtils::Particle* mu : muons) {
+          for (size_t i = 0; i < muons.size(); ++i) {
+            HEPUtils::Particle* mu = muons[i];
             if (mu->abseta() > 2.5) continue;
 
             // Look up resolution
             const double resolution = _muEff.get_at(mu->abseta(), mu->pT());
 
             // Smear by a Gaussian centered on the current energy, with width given by the resolution
-            std::normal_distribution<> d(mu->pT(), resolution*mu->pT());
-            double smeared_pt = d(gen);
+            double smeared_pt = mu->pT()*(1 + resolution*z[i]);
             if (smeared_pt < 0) smeared_pt = 0;
             // const double smeared_E = smeared_pt*cosh(mu->eta()); ///< @todo Should be cosh(|eta|)?
             // std::cout << "Muon pt " << mu_pt << " smeared " << smeared_pt << endl;
@@ -187,12 +188,12 @@ namespace Gambit {
           const double resolution = 0.03;
 
           // Now loop over the jets and smear the 4-vectors
-          std::random_device rd;
-          std::mt19937 gen(rd());
-          std::normal_distribution<> d(1., resolution);
-          for (HEPUtils::Jet* jet : jets) {
-            // Smear by a Gaussian centered on 1 with width given by the (fractional) resolution
-            double smear_factor = d(gen);
+          static thread_local std::vector<double> smear_factors;
+          // Smear by a Gaussian centered on 1 with width given by the (fractional) resolution
+          random_normal(smear_factors, jets.size(), 1., resolution);
+          for (size_t i = 0; i < jets.size(); ++i) {
+            HEPUtils::Jet* jet = jets[i];
+            const double smear_factor = smear_factors[i];
             /// @todo Is this the best way to smear? Should we preserve the mean jet energy, or pT, or direction?
             jet->set_mom(HEPUtils::P4::mkXYZM(jet->mom().px()*smear_factor, jet->mom().py()*smear_factor, jet->mom().pz()*smear_factor, jet->mass()));
           }
@@ -208,12 +209,12 @@ namespace Gambit {
           const double resolution = 0.03;
 
           // Now loop over the jets and smear the 4-vectors
-          std::random_device rd;
-          std::mt19937 gen(rd());
-          std::normal_distribution<> d(1., resolution);
-          for (HEPUtils::Particle* p : taus) {
-            // Smear by a Gaussian centered on 1 with width given by the (fractional) resolution
-            double smear_factor = d(gen);
+          static thread_local std::vector<double> smear_factors;
+          // Smear by a Gaussian centered on 1 with width given by the (fractional) resolution
+          random_normal(smear_factors, taus.size(), 1., resolution);
+          for (size_t i = 0; i < taus.size(); ++i) {
+            HEPUtils::Particle* p = taus[i];
+            const double smear_factor = smear_factors[i];
             /// @todo Is this the best way to smear? Should we preserve the mean jet energy, or pT, or direction?
             p->set_mom(HEPUtils::P4::mkXYZM(p->mom().px()*smear_factor, p->mom().py()*smear_factor, p->mom().pz()*smear_factor, p->mass()));
           }
@@ -11,7 +11,6 @@
 #include "HEPUtils/BinnedFn.h"
 #include "HEPUtils/Event.h"
 
-#include <random>
 #include <algorithm>
 
 namespace Gambit {
@@ -70,7 +69,7 @@ namespace Gambit {
                                              if (!rm)
                                              {
                                                const double eff = 0.95 * (p->abseta() < 1.5 ? 1 : exp(0.5 - 5e-4*p->pT()));
-                                               rm = (HEPUtils::rand01() > eff);
+                                               rm = (random_uniform() > eff);
                                              } 
                                              if (rm) delete p;
                                              return rm;
@@ -92,11 +91,13 @@ namespace Gambit {
       /// We need to smear E, then recalculate pT, then reset the 4-vector.
       inline void smearElectronEnergy(std::vector<HEPUtils::Particle*>& electrons) {
 
-        std::random_device rd;
-        std::mt19937 gen(rd());
+        // Draw all the Gaussian numbers needed for this event at once
+        static thread_local std::vector<double> z;
+        random_normal(z, electrons.size());
 
         // Now loop over the electrons and smear the 4-vectors
-        for (HEPUtils::Particle* e : electrons) {
+        for (size_t i = 0; i < electrons.size(); ++i) {
+          HEPUtils::Particle* e = electrons[i];
 
           // Calculate resolution
           // for pT > 0.1 GeV, E resolution = |eta| < 0.5 -> sqrt(0.06^2 + pt^2 * 1.3e-3^2)
@@ -116,8 +117,7 @@ namespace Gambit {
 
           // Smear by a Gaussian centered on the current energy, with width given by the resolution
           if (resolution > 0) {
-            std::normal_distribution<> d(e->E(), resolution);
-            double smeared_E = d(gen);
+            double smeared_E = e->E() + resolution*z[i];
             if (smeared_E < 0) smeared_E = 0;
             // double smeared_pt = smeared_E/cosh(e->eta()); ///< @todo Should be cosh(|eta|)?
             // std::cout << "BEFORE eta " << electron->eta() << std::std::endl;
@@ -134,11 +134,13 @@ namespace Gambit {
       /// We need to smear pT, then recalculate E, then reset the 4-vector.
       inline void smearMuonMomentum(std::vector<HEPUtils::Particle*>& muons) {
 
-        std::random_device rd;
-        std::mt19937 gen(rd());
+        // Draw all the Gaussian numbers needed for this event at once
+        static thread_local std::vector<double> z;
+        random_normal(z, muons.size());
 
         // Now loop over the muons and smear the 4-vectors
-        for (HEPUtils::Particle* p : muons) {
+        for (size_t i = 0; i < muons.size(); ++i) {
+          HEPUtils::Particle* p = muons[i];
 
           // Calculate resolution
           // for pT > 0.1 GeV, mom resolution = |eta| < 0.5 -> sqrt(0.01^2 + pt^2 * 2.0e-4^2)
@@ -157,8 +159,7 @@ namespace Gambit {
           }
 
           // Smear by a Gaussian centered on the current pT, with width given by the resolution
-          std::normal_distribution<> d(p->pT(), resolution*p->pT());
-          double smeared_pt = d(gen);
+          double smeared_pt = p->pT()*(1 + resolution*z[i]);
           if (smeared_pt < 0) smeared_pt = 0;
           // const double smeared_E = smeared_pt*cosh(mu->eta()); ///< @todo Should be cosh(|eta|)?
           // std::cout << "Muon pt " << mu_pt << " smeared " << smeared_pt << std::endl;
@@ -181,12 +182,12 @@ namespace Gambit {
         const double resolution = 0.03;
 
         // Now loop over the jets and smear the 4-vectors
-        std::random_device rd;
-        std::mt19937 gen(rd());
-        std::normal_distribution<> d(1., resolution);
-        for (HEPUtils::Jet* jet : jets) {
-          // Smear by a Gaussian centered on 1 with width given by the (fractional) resolution
-          double smear_factor = d(gen);
+        static thread_local std::vector<double> smear_factors;
+        // Smear by a Gaussian centered on 1 with width given by the (fractional) resolution
+        random_normal(smear_factors, jets.size(), 1., resolution);
+        for (size_t i = 0; i < jets.size(); ++i) {
+          HEPUtils::Jet* jet = jets[i];
+          const double smear_factor = smear_factors[i];
           /// @todo Is this the best way to smear? Should we preserve the mean jet energy, or pT, or direction?
           jet->set_mom(HEPUtils::P4::mkXYZM(jet->mom().px()*smear_factor, jet->mom().py()*smear_factor, jet->mom().pz()*smear_factor, jet->mass()));
         }
@@ -203,12 +204,12 @@ namespace Gambit {
         const double resolution = 0.03;
 
         // Now loop over the jets and smear the 4-vectors
-        std::random_device rd;
-        std::mt19937 gen(rd());
-        std::normal_distribution<> d(1., resolution);
-        for (HEPUtils::Particle* p : taus) {
-          // Smear by a Gaussian centered on 1 with width given by the (fractional) resolution
-          double smear_factor = d(gen);
+        static thread_local std::vector<double> smear_factors;
+        // Smear by a Gaussian centered on 1 with width given by the (fractional) resolution
+        random_normal(smear_factors, taus.size(), 1., resolution);
+        for (size_t i = 0; i < taus.size(); ++i) {
+          HEPUtils::Particle* p = taus[i];
+          const double smear_factor = smear_factors[i];
           /// @todo Is this the best way to smear? Should we preserve the mean jet energy, or pT, or direction?
           p->set_mom(HEPUtils::P4::mkXYZM(p->mom().px()*smear_factor, p->mom().py()*smear_factor, p->mom().pz()*smear_factor, p->mass()));
         }
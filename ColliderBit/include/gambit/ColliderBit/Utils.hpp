@@ -2,11 +2,48 @@
 #include "HEPUtils/MathUtils.h"
 #include "HEPUtils/BinnedFn.h"
 #include "HEPUtils/Event.h"
+#include <random>
 
 namespace Gambit {
   namespace ColliderBit {
 
 
+    /// @name Per-thread random number streams for the detector simulation
+    ///
+    /// Each OpenMP thread has its own engine, which lives as long as the thread and so is
+    /// reused across events. Seeding every thread's stream from the same seed base as the
+    /// event generator makes the detector simulation reproducible for a fixed seed.
+    /// A thread whose stream has not been seeded uses the engine's default seed.
+    //@{
+
+    /// Random number engine of the calling thread
+    std::mt19937_64& detector_rng();
+
+    /// Seed the calling thread's stream from a seed base and a thread number
+    void seed_detector_rng(int seed_base, int thread);
+
+    /// Draw a number uniformly from [0,1) from the calling thread's stream
+    double random_uniform();
+
+    /// Fill an array with numbers drawn uniformly from [0,1)
+    void random_uniform(double* out, size_t n);
+
+    /// Fill an array with numbers drawn from a Gaussian of the given mean and width
+    void random_normal(double* out, size_t n, double mean=0.0, double sigma=1.0);
+
+    /// Resize a vector to n and fill it with uniform / Gaussian numbers
+    inline void random_uniform(std::vector<double>& out, size_t n) {
+      out.resize(n);
+      if (n > 0) random_uniform(out.data(), n);
+    }
+    inline void random_normal(std::vector<double>& out, size_t n, double mean=0.0, double sigma=1.0) {
+      out.resize(n);
+      if (n > 0) random_normal(out.data(), n, mean, sigma);
+    }
+
+    //@}
+
+
     /// Return a random true/false at a success rate given by a number
     // inline
     bool random_bool(double eff);
@@ -30,6 +67,7 @@ namespace Gambit {
 
 
     /// Utility function for filtering a supplied particle vector by sampling wrt an efficiency scalar
+    /// @note With do_delete, removed particles are handed back to the calling thread's HEPUtils::BlockPool
     void filtereff(std::vector<HEPUtils::Particle*>& particles, double eff, bool do_delete=true);
 
 
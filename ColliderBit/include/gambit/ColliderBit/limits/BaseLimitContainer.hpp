@@ -94,8 +94,12 @@ namespace Gambit
         virtual double specialLimit(double, double) const;
         
         /// @brief Two-pi averaging interpolator to find limits between limit curves
+        /// @note Each contour segment is only tested against the rays that can reach it
         double limitAverage(double x, double y, double mZ) const;
 
+        /// @brief As limitAverage, but testing every ray against every contour segment, for checking
+        double limitAverageAllRays(double x, double y, double mZ) const;
+
         /// @brief Dump limit average data into a file for average debugging
         void dumpPlotData(double xlow, double xhigh, double ylow, double yhigh,
                           double mZ, std::string filename, int ngrid=1000) const;
@@ -104,6 +108,11 @@ namespace Gambit
         void dumpLightPlotData(std::string filename, int nperLine=20) const;
 
       //@}
+
+      private:
+
+        /// @brief Two-pi averaging over the contours, without checking the exclusion region
+        double contourAverage(double x, double y, bool allRays) const;
     };
 
   }
@@ -36,6 +36,7 @@
 #include <fstream>
 #include <memory>
 #include <numeric>
+#include <set>
 #include <sstream>
 #include <vector>
 
@@ -43,6 +44,7 @@
 #include "gambit/ColliderBit/ColliderBit_rollcall.hpp"
 #include "gambit/Elements/mssm_slhahelp.hpp"
 #include "gambit/ColliderBit/lep_mssm_xsecs.hpp"
+#include "gambit/ColliderBit/Utils.hpp"
 #include "HEPUtils/FastJet.h"
 
 //#define COLLIDERBIT_DEBUG
@@ -68,6 +70,27 @@ namespace Gambit
       }
     #endif
 
+    /// Convert lists of final state particle names into DecayTable channel keys, to be made once and reused
+    std::vector<std::multiset<std::pair<int,int> > > channel_keys(const std::vector<std::vector<str> >& final_states)
+    {
+      std::vector<std::multiset<std::pair<int,int> > > result;
+      for (const auto& final_state : final_states)
+      {
+        std::multiset<std::pair<int,int> > key;
+        for (const str& name : final_state) key.insert(Models::ParticleDB().pdg_pair(name));
+        result.push_back(key);
+      }
+      return result;
+    }
+
+    /// Total branching fraction of a particle into a list of final states
+    double totalBF(const DecayTable::Entry& decays, const std::vector<std::multiset<std::pair<int,int> > >& final_states)
+    {
+      double result = 0;
+      for (const auto& final_state : final_states) result += decays.BF(final_state);
+      return result;
+    }
+
     /// LEP limit likelihood function
     double limitLike(double x, double x95, double sigma)
     {
@@ -250,6 +273,7 @@ namespace Gambit
 
         // Update the global Pythia seedBase.
         // The Pythia random number seed will be this, plus the thread number.
+        // The detector simulation random number streams are seeded from it too.
         seedBase = int(Random::draw() * 899990000);
 
         #ifdef COLLIDERBIT_DEBUG
@@ -426,6 +450,9 @@ namespace Gambit
           std::cerr << debug_prefix() << "getPythia: My Pythia seed is: " << std::to_string(seedBase + omp_get_thread_num()) << endl;
         #endif
 
+        // Seed this thread's detector simulation stream from the same seed base
+        seed_detector_rng(seedBase, omp_get_thread_num());
+
         result.resetSpecialization(*iterPythiaNames);
 
         try
@@ -586,6 +613,9 @@ namespace Gambit
           std::cerr << debug_prefix() << "getPythiaFileReader: My Pythia seed is: " << std::to_string(seedBase + omp_get_thread_num()) << endl;
         #endif
 
+        // Seed this thread's detector simulation stream from the same seed base
+        seed_detector_rng(seedBase, omp_get_thread_num());
+
         result.resetSpecialization(*iterPythiaNames);
 
         try
@@ -3190,6 +3220,16 @@ namespace Gambit
       const Spectrum& spec = *Dep::MSSM_spectrum;
 
       const DecayTable& decays = *Dep::decay_rates;
+      static const std::pair<int,int> neut2 = Models::ParticleDB().pdg_pair("~chi0_2");
+      static const std::pair<int,int> neut3 = Models::ParticleDB().pdg_pair("~chi0_3");
+      static const std::pair<int,int> neut4 = Models::ParticleDB().pdg_pair("~chi0_4");
+      // Final states which look like Z* decays of the heavier neutralinos
+      static const std::vector<std::multiset<std::pair<int,int> > > ZstarFinalStates = channel_keys({
+        {"~chi0_1", "Z0"},
+        {"~chi0_1", "ubar", "u"}, {"~chi0_1", "dbar", "d"}, {"~chi0_1", "cbar", "c"},
+        {"~chi0_1", "sbar", "s"}, {"~chi0_1", "bbar", "b"},
+        {"~chi0_1", "e+", "e-"}, {"~chi0_1", "mu+", "mu-"}, {"~chi0_1", "tau+", "tau-"},
+        {"~chi0_1", "nubar_e", "nu_e"}, {"~chi0_1", "nubar_mu", "nu_mu"}, {"~chi0_1", "nubar_tau", "nu_tau"} });
       const double mass_neut1 = spec.get(Par::Pole_Mass,1000022, 0);
       const double mass_neut2 = spec.get(Par::Pole_Mass,1000023, 0);
       const double mass_neut3 = spec.get(Par::Pole_Mass,1000025, 0);
@@ -3207,19 +3247,7 @@ namespace Gambit
 
       xsecWithError = *Dep::LEP188_xsec_chi00_12;
       // Total up all channels which look like Z* decays
-      totalBR = 0;
-      totalBR += decays.at("~chi0_2").BF("~chi0_1", "Z0");
-      totalBR += decays.at("~chi0_2").BF("~chi0_1", "ubar", "u");
-      totalBR += decays.at("~chi0_2").BF("~chi0_1", "dbar", "d");
-      totalBR += decays.at("~chi0_2").BF("~chi0_1", "cbar", "c");
-      totalBR += decays.at("~chi0_2").BF("~chi0_1", "sbar", "s");
-      totalBR += decays.at("~chi0_2").BF("~chi0_1", "bbar", "b");
-      totalBR += decays.at("~chi0_2").BF("~chi0_1", "e+", "e-");
-      totalBR += decays.at("~chi0_2").BF("~chi0_1", "mu+", "mu-");
-      totalBR += decays.at("~chi0_2").BF("~chi0_1", "tau+", "tau-");
-      totalBR += decays.at("~chi0_2").BF("~chi0_1", "nubar_e", "nu_e");
-      totalBR += decays.at("~chi0_2").BF("~chi0_1", "nubar_mu", "nu_mu");
-      totalBR += decays.at("~chi0_2").BF("~chi0_1", "nubar_tau", "nu_tau");
+      totalBR = totalBF(decays.at(neut2), ZstarFinalStates);
       xsecWithError.upper *= totalBR;
       xsecWithError.central *= totalBR;
       xsecWithError.lower *= totalBR;
@@ -3238,19 +3266,7 @@ namespace Gambit
 
       xsecWithError = *Dep::LEP188_xsec_chi00_13;
       // Total up all channels which look like Z* decays
-      totalBR = 0;
-      totalBR += decays.at("~chi0_3").BF("~chi0_1", "Z0");
-      totalBR += decays.at("~chi0_3").BF("~chi0_1", "ubar", "u");
-      totalBR += decays.at("~chi0_3").BF("~chi0_1", "dbar", "d");
-      totalBR += decays.at("~chi0_3").BF("~chi0_1", "cbar", "c");
-      totalBR += decays.at("~chi0_3").BF("~chi0_1", "sbar", "s");
-      totalBR += decays.at("~chi0_3").BF("~chi0_1", "bbar", "b");
-      totalBR += decays.at("~chi0_3").BF("~chi0_1", "e+", "e-");
-      totalBR += decays.at("~chi0_3").BF("~chi0_1", "mu+", "mu-");
-      totalBR += decays.at("~chi0_3").BF("~chi0_1", "tau+", "tau-");
-      totalBR += decays.at("~chi0_3").BF("~chi0_1", "nubar_e", "nu_e");
-      totalBR += decays.at("~chi0_3").BF("~chi0_1", "nubar_mu", "nu_mu");
-      totalBR += decays.at("~chi0_3").BF("~chi0_1", "nubar_tau", "nu_tau");
+      totalBR = totalBF(decays.at(neut3), ZstarFinalStates);
       xsecWithError.upper *= totalBR;
       xsecWithError.central *= totalBR;
       xsecWithError.lower *= totalBR;
@@ -3269,19 +3285,7 @@ namespace Gambit
 
       xsecWithError = *Dep::LEP188_xsec_chi00_14;
       // Total up all channels which look like Z* decays
-      totalBR = 0;
-      totalBR += decays.at("~chi0_4").BF("~chi0_1", "Z0");
-      totalBR += decays.at("~chi0_4").BF("~chi0_1", "ubar", "u");
-      totalBR += decays.at("~chi0_4").BF("~chi0_1", "dbar", "d");
-      totalBR += decays.at("~chi0_4").BF("~chi0_1", "cbar", "c");
-      totalBR += decays.at("~chi0_4").BF("~chi0_1", "sbar", "s");
-      totalBR += decays.at("~chi0_4").BF("~chi0_1", "bbar", "b");
-      totalBR += decays.at("~chi0_4").BF("~chi0_1", "e+", "e-");
-      totalBR += decays.at("~chi0_4").BF("~chi0_1", "mu+", "mu-");
-      totalBR += decays.at("~chi0_4").BF("~chi0_1", "tau+", "tau-");
-      totalBR += decays.at("~chi0_4").BF("~chi0_1", "nubar_e", "nu_e");
-      totalBR += decays.at("~chi0_4").BF("~chi0_1", "nubar_mu", "nu_mu");
-      totalBR += decays.at("~chi0_4").BF("~chi0_1", "nubar_tau", "nu_tau");
+      totalBR = totalBF(decays.at(neut4), ZstarFinalStates);
       xsecWithError.upper *= totalBR;
       xsecWithError.central *= totalBR;
       xsecWithError.lower *= totalBR;
@@ -3315,6 +3319,16 @@ namespace Gambit
       const Spectrum& spec = *Dep::MSSM_spectrum;
 
       const DecayTable& decays = *Dep::decay_rates;
+      static const std::pair<int,int> neut2 = Models::ParticleDB().pdg_pair("~chi0_2");
+      static const std::pair<int,int> neut3 = Models::ParticleDB().pdg_pair("~chi0_3");
+      static const std::pair<int,int> neut4 = Models::ParticleDB().pdg_pair("~chi0_4");
+      static const std::pair<int,int> Z0 = Models::ParticleDB().pdg_pair("Z0");
+      // Leptonic final states, of the Z and of the heavier neutralinos
+      static const std::vector<std::multiset<std::pair<int,int> > > ZLeptonicFinalStates = channel_keys({
+        {"e+", "e-"}, {"mu+", "mu-"}, {"tau+", "tau-"} });
+      static const std::vector<std::multiset<std::pair<int,int> > > ZstarLeptonicFinalStates = channel_keys({
+        {"~chi0_1", "e+", "e-"}, {"~chi0_1", "mu+", "mu-"}, {"~chi0_1", "tau+", "tau-"} });
+      static const std::vector<std::multiset<std::pair<int,int> > > ZFinalState = channel_keys({{"~chi0_1", "Z0"}});
       const double mass_neut1 = spec.get(Par::Pole_Mass,1000022, 0);
       const double mass_neut2 = spec.get(Par::Pole_Mass,1000023, 0);
       const double mass_neut3 = spec.get(Par::Pole_Mass,1000025, 0);
@@ -3333,15 +3347,10 @@ namespace Gambit
       xsecWithError = *Dep::LEP188_xsec_chi00_12;
       // Total up all channels which look like leptonic Z* decays
       // Total up the leptonic Z decays first...
-      totalBR = 0;
-      totalBR += decays.at("Z0").BF("e+", "e-");
-      totalBR += decays.at("Z0").BF("mu+", "mu-");
-      totalBR += decays.at("Z0").BF("tau+", "tau-");
-      totalBR = decays.at("~chi0_2").BF("~chi0_1", "Z0") * totalBR;
+      totalBR = totalBF(decays.at(Z0), ZLeptonicFinalStates);
+      totalBR = totalBF(decays.at(neut2), ZFinalState) * totalBR;
 
-      totalBR += decays.at("~chi0_2").BF("~chi0_1", "e+", "e-");
-      totalBR += decays.at("~chi0_2").BF("~chi0_1", "mu+", "mu-");
-      totalBR += decays.at("~chi0_2").BF("~chi0_1", "tau+", "tau-");
+      totalBR += totalBF(decays.at(neut2), ZstarLeptonicFinalStates);
       xsecWithError.upper *= totalBR;
       xsecWithError.central *= totalBR;
       xsecWithError.lower *= totalBR;
@@ -3361,15 +3370,10 @@ namespace Gambit
       xsecWithError = *Dep::LEP188_xsec_chi00_13;
       // Total up all channels which look like leptonic Z* decays
       // Total up the leptonic Z decays first...
-      totalBR = 0;
-      totalBR += decays.at("Z0").BF("e+", "e-");
-      totalBR += decays.at("Z0").BF("mu+", "mu-");
-      totalBR += decays.at("Z0").BF("tau+", "tau-");
-      totalBR = decays.at("~chi0_3").BF("~chi0_1", "Z0") * totalBR;
+      totalBR = totalBF(decays.at(Z0), ZLeptonicFinalStates);
+      totalBR = totalBF(decays.at(neut3), ZFinalState) * totalBR;
 
-      totalBR += decays.at("~chi0_3").BF("~chi0_1", "e+", "e-");
-      totalBR += decays.at("~chi0_3").BF("~chi0_1", "mu+", "mu-");
-      totalBR += decays.at("~chi0_3").BF("~chi0_1", "tau+", "tau-");
+      totalBR += totalBF(decays.at(neut3), ZstarLeptonicFinalStates);
       xsecWithError.upper *= totalBR;
       xsecWithError.central *= totalBR;
       xsecWithError.lower *= totalBR;
@@ -3389,15 +3393,10 @@ namespace Gambit
       xsecWithError = *Dep::LEP188_xsec_chi00_14;
       // Total up all channels which look like leptonic Z* decays
       // Total up the leptonic Z decays first...
-      totalBR = 0;
-      totalBR += decays.at("Z0").BF("e+", "e-");
-      totalBR += decays.at("Z0").BF("mu+", "mu-");
-      totalBR += decays.at("Z0").BF("tau+", "tau-");
-      totalBR = decays.at("~chi0_4").BF("~chi0_1", "Z0") * totalBR;
+      totalBR = totalBF(decays.at(Z0), ZLeptonicFinalStates);
+      totalBR = totalBF(decays.at(neut4), ZFinalState) * totalBR;
 
-      totalBR += decays.at("~chi0_4").BF("~chi0_1", "e+", "e-");
-      totalBR += decays.at("~chi0_4").BF("~chi0_1", "mu+", "mu-");
-      totalBR += decays.at("~chi0_4").BF("~chi0_1", "tau+", "tau-");
+      totalBR += totalBF(decays.at(neut4), ZstarLeptonicFinalStates);
       xsecWithError.upper *= totalBR;
       xsecWithError.central *= totalBR;
       xsecWithError.lower *= totalBR;
@@ -1,14 +1,67 @@
 #include "gambit/ColliderBit/Utils.hpp"
 #include <iostream>
+#include <cstdint>
 using namespace std;
 
 namespace Gambit {
   namespace ColliderBit {
 
 
+    namespace {
+
+      /// Random number stream of one thread
+      struct DetectorRNG {
+        std::mt19937_64 engine;
+        /// Kept between calls, as it may cache a second Gaussian number from each pair it generates
+        std::normal_distribution<double> normal;
+      };
+
+      DetectorRNG& thread_rng() {
+        static thread_local DetectorRNG rng;
+        return rng;
+      }
+
+      /// Uniform number in [0,1) from the top 53 bits of a 64-bit draw
+      inline double to_unit(std::uint64_t x) {
+        return (x >> 11) * (1.0/9007199254740992.0);
+      }
+
+    }
+
+
+    std::mt19937_64& detector_rng() {
+      return thread_rng().engine;
+    }
+
+
+    void seed_detector_rng(int seed_base, int thread) {
+      DetectorRNG& rng = thread_rng();
+      std::seed_seq seq{unsigned(seed_base), unsigned(thread)};
+      rng.engine.seed(seq);
+      rng.normal.reset();
+    }
+
+
+    double random_uniform() {
+      return to_unit(thread_rng().engine());
+    }
+
+
+    void random_uniform(double* out, size_t n) {
+      std::mt19937_64& engine = thread_rng().engine;
+      for (size_t i = 0; i < n; ++i) out[i] = to_unit(engine());
+    }
+
+
+    void random_normal(double* out, size_t n, double mean, double sigma) {
+      DetectorRNG& rng = thread_rng();
+      for (size_t i = 0; i < n; ++i) out[i] = mean + sigma*rng.normal(rng.engine);
+    }
+
+
     bool random_bool(double eff) {
       /// @todo Handle out-of-range eff values
-      return HEPUtils::rand01() < eff;
+      return random_uniform() < eff;
     }
 
 
@@ -184,7 +184,7 @@ namespace Gambit {
         for (const Jet* j : jets24) {
           if (j->pT() < 50 && j->abseta() > 2.5) continue;
           // b-tag effs: b: 0.55, c: 0.12, l: 0.016
-          const bool btagged = rand01() < (j->btag() ? 0.55 : j->ctag() ? 0.12 : 0.016);
+          const bool btagged = random_uniform() < (j->btag() ? 0.55 : j->ctag() ? 0.12 : 0.016);
           if (btagged) nbj += 1;
         }
         if (nj >= 3 && nbj == 0 && ht >  500 && htmiss > 500) _srnums[ 0] += 1;
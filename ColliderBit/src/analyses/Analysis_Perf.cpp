@@ -183,7 +183,7 @@ namespace Gambit {
         for (HEPUtils::Jet* jet : event->jets()) {
           if (jet->pT() > 20. && jet->abseta() < 5.0) baselineJets.push_back(jet);
           if (jet->abseta() < 2.5 && jet->pT() > 20.) {
-            const double rnum = HEPUtils::rand01();
+            const double rnum = random_uniform();
             /// @todo Add a special higher-rate b-mistag treatment for charm jets?
             const bool btagged = jet->btag() ? (rnum < 0.75) : (rnum < 0.02);
             if (btagged) bJets.push_back(jet);
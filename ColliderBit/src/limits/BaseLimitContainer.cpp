@@ -42,11 +42,22 @@ namespace Gambit
     double BaseLimitContainer::limitAverage(double x, double y, double mZ) const
     {
       if (!isWithinExclusionRegion(x, y, mZ)) return specialLimit(x, y);
+      return contourAverage(x, y, false);
+    }
+
+    double BaseLimitContainer::limitAverageAllRays(double x, double y, double mZ) const
+    {
+      if (!isWithinExclusionRegion(x, y, mZ)) return specialLimit(x, y);
+      return contourAverage(x, y, true);
+    }
+
+    double BaseLimitContainer::contourAverage(double x, double y, bool allRays) const
+    {
       const P2& point = P2(x, y);
       const LineSegment& externalLine = LineSegment(point, _externalPoint);
       P2 rayMaker;
-      LineSegment ray, intersectLine;
-      double r, rmin;
+      LineSegment intersectLine;
+      double r;
       double average, totalWeight, thisLimit, nextBestLimit;
       unsigned intersectCounter, index;
   
@@ -71,47 +82,63 @@ namespace Gambit
       else
         // Otherwise, store the next best limit for the average.
         nextBestLimit = _limitValuesSorted[index-1];
-  
-      // Scan over all the angles around the current point to perform the average.
-      average = 0.;
-      totalWeight = 0.;
-      for (double angle = 0.; angle < 2.*acos(-1); angle += acos(-1)/41.) {
-        // Make a ray for each angle.
+
+      // Make a ray for each of the angles around the current point to average over.
+      const double rayStep = acos(-1)/41.;
+      std::vector<LineSegment> rays;
+      for (double angle = 0.; angle < 2.*acos(-1); angle += rayStep) {
         rayMaker.setxy(1000. * cos(angle), 1000. * sin(angle));
-        ray.init(point, point + rayMaker);
-  
-        // For each ray, look for intersections with the next best limit.
-        rmin = std::numeric_limits<double>::infinity();
-        for (auto segmentIter = _limitContours.at(index-1)->begin();
-                  segmentIter != _limitContours.at(index-1)->end(); ++segmentIter) {
-          intersectLine.init(point, ray.intersectsAt(*segmentIter));
-          r = intersectLine.r();
-          if (r <= rmin) rmin = r;
-        }
-        if (rmin == 0.) {
-          totalWeight = -1.;
-          average = nextBestLimit;
-          break;
-        } else {
-          totalWeight += sqrt(1./rmin);
-          average += sqrt(1./rmin) * nextBestLimit;
-        }
-  
-        // For each ray, also look for intersections with the current limit.
-        rmin = std::numeric_limits<double>::infinity();
-        for (auto segmentIter = _limitContours.at(index)->begin();
-                  segmentIter != _limitContours.at(index)->end(); ++segmentIter) {
-          intersectLine.init(point, ray.intersectsAt(*segmentIter));
-          r = intersectLine.r();
-          if (r <= rmin) rmin = r;
+        rays.push_back(LineSegment(point, point + rayMaker));
+      }
+      const int nRays = rays.size();
+
+      // Find the nearest intersection of each ray with the next best limit (rmin[0]) and the
+      // current limit (rmin[1]). A segment can only be crossed by the rays pointing between its
+      // ends, so each segment is tested against those rays only, plus one more on either side to
+      // be safe against rounding. Segments in line with the point are tested against all the rays.
+      std::vector<double> rmin[2];
+      for (int limit = 0; limit < 2; limit++) {
+        rmin[limit].assign(nRays, std::numeric_limits<double>::infinity());
+        const Contours& contour = *_limitContours.at(index-1+limit);
+        for (auto segmentIter = contour.begin(); segmentIter != contour.end(); ++segmentIter) {
+          const P2 d1 = segmentIter->getp1() - point;
+          const P2 d2 = segmentIter->getp2() - point;
+          const double cross = d1.getx() * d2.gety() - d1.gety() * d2.getx();
+          int first = 0, last = nRays - 1;
+          if (!allRays and std::abs(cross) > 1e-6 * d1.r() * d2.r()) {
+            // The segment covers the angles from the end at startAngle anticlockwise to the other end.
+            const double startAngle = cross > 0 ? atan2(d1.gety(), d1.getx()) : atan2(d2.gety(), d2.getx());
+            const double sweep = acos(std::max(-1., std::min(1., (d1.getx() * d2.getx() + d1.gety() * d2.gety()) / (d1.r() * d2.r()))));
+            first = int(std::floor(startAngle / rayStep)) - 1;
+            last = int(std::ceil((startAngle + sweep) / rayStep)) + 1;
+            if (last - first >= nRays) {
+              first = 0;
+              last = nRays - 1;
+            }
+          }
+          for (int i = first; i <= last; i++) {
+            const int ray = (i % nRays + nRays) % nRays;
+            intersectLine.init(point, rays[ray].intersectsAt(*segmentIter));
+            r = intersectLine.r();
+            if (r <= rmin[limit][ray]) rmin[limit][ray] = r;
+          }
         }
-        if (rmin == 0.) {
-          totalWeight = -1.;
-          average = thisLimit;
-          break;
-        } else {
-          totalWeight += sqrt(1./rmin);
-          average += sqrt(1./rmin) * thisLimit;
+      }
+
+      // Average the two limits over the rays, weighting them by the distances to the intersections.
+      const double limits[2] = {nextBestLimit, thisLimit};
+      average = 0.;
+      totalWeight = 0.;
+      for (int ray = 0; ray < nRays and totalWeight >= 0.; ray++) {
+        for (int limit = 0; limit < 2; limit++) {
+          if (rmin[limit][ray] == 0.) {
+            totalWeight = -1.;
+            average = limits[limit];
+            break;
+          } else {
+            totalWeight += sqrt(1./rmin[limit][ray]);
+            average += sqrt(1./rmin[limit][ray]) * limits[limit];
+          }
         }
       }
   
@@ -28,6 +28,7 @@
 #include <vector>
 #include <map>
 #include <queue>
+#include <omp.h>
 
 #include "gambit/Core/core.hpp"
 #include "gambit/Core/error_handlers.hpp"
@@ -99,6 +100,26 @@ namespace Gambit
       bool printme;
     };
 
+    /// Pre-resolved information required to run a single functor at runtime
+    struct ExecutionStep
+    {
+      /// Functor to be calculated
+      functor* func;
+      /// Does the functor have a non-void result that should be sent to the printer?
+      bool printable;
+      /// Debug log message announcing the call, pre-formatted at plan-compile time
+      str call_msg;
+      /// Depth of the functor in the plan; functors with equal depth do not depend on each other
+      int wave;
+      /// Can the functor be run concurrently with others in its wave (declared THREAD_SAFE, not a loop manager or nested functor)?
+      bool parallel_safe;
+      /// Indices of the backend locks that must be held while the functor runs concurrently (sorted)
+      std::vector<int> locks;
+    };
+
+    /// Flat, topologically sorted list of functors needed to compute a single ObsLike
+    typedef std::vector<ExecutionStep> ExecutionPlan;
+
     /// Check whether s1 (wildcard + regex allowed) matches s2
     bool stringComp(const str &s1, const str &s2, bool with_regex = true);
 
@@ -112,6 +133,9 @@ namespace Gambit
         /// Constructor, provide module and backend functor lists
         DependencyResolver(const gambit_core&, const Models::ModelFunctorClaw&, const IniParser::IniFile&, const Utils::type_equivalency&, Printers::BasePrinter&);
 
+        /// Destructor
+        ~DependencyResolver();
+
         /// The dependency resolution
         void doResolution();
 
@@ -133,6 +157,9 @@ namespace Gambit
         /// Getter for print_timing flag (used by LikelihoodContainer)
         bool printTiming();
 
+        /// Write runtime statistics for all active functors to the logs (if requested in the yaml file)
+        void printTimingSummary();
+
         /// Get the functor corresponding to a single VertexID
         functor* get_functor(VertexID);
 
@@ -220,6 +247,15 @@ namespace Gambit
         /// scanned over.
         std::vector<DRes::VertexID> closestCandidateForModel(std::vector<DRes::VertexID> candidates);
 
+        /// Compile the per-point execution plans for all ObsLike vertices
+        void compileExecutionPlans();
+
+        /// Log, check for invalidation and print the result of a single calculated step of an execution plan
+        void finishStep(const ExecutionStep&, const int);
+
+        /// Calculate a set of mutually independent functors concurrently, holding the relevant backend locks
+        void calculateConcurrently(const std::vector<const ExecutionStep*>&);
+
         //
         // Private data members
         //
@@ -251,6 +287,21 @@ namespace Gambit
         /// Saved calling order for functions required to compute single ObsLike entries
         std::map<VertexID, std::vector<VertexID>> SortedParentVertices;
 
+        /// Compiled execution plans for single ObsLike entries, indexed directly by VertexID
+        std::vector<ExecutionPlan> ExecutionPlans;
+
+        /// Flag for logging the runtime of each functor after it is calculated
+        bool log_runtime = false;
+
+        /// Flag for evaluating independent branches of execution plans concurrently
+        bool parallel_branches = false;
+
+        /// Names of the backends used by each vertex (as the capabilities of their initialisation functions)
+        std::map<VertexID, std::set<str>> backendsUsed;
+
+        /// One lock per backend, serialising concurrent calls into its (global) state
+        std::vector<omp_lock_t> backend_locks;
+
         /// Temporary map for loop manager -> list of nested functions
         std::map<VertexID, std::set<VertexID>> loopManagerMap;
 
@@ -267,6 +318,9 @@ namespace Gambit
         /// Global flag for triggering printing of timing data
         bool print_timing = false;
 
+        /// Global flag for triggering a summary of timing data at the end of the run
+        bool timing_summary = false;
+
   };
   }
 }
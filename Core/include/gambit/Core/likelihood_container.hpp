@@ -40,8 +40,35 @@ namespace Gambit
 
     private:
 
-      /// Graph vertices corresponding to functors in the ObsLike section of yaml file
-      std::vector<DRes::VertexID> target_vertices;
+      /// Signature of functions that add the result of a target functor to the total log-likelihood
+      typedef double (*lnlike_accumulator)(functor*, std::ostringstream*);
+
+      /// Pre-resolved information about a single likelihood component
+      struct target_info
+      {
+        DRes::VertexID vertex;
+        functor* func;
+        lnlike_accumulator accumulate;
+      };
+
+      /// Pre-resolved location of a single model parameter in the array passed by ScannerBit
+      struct parameter_slot
+      {
+        int slot;
+        double* value;
+        bool first_in_model;
+        str model;
+        str name;
+      };
+
+      /// Model parameters, grouped by model, with their slots in the parameter array
+      std::vector<parameter_slot> parameter_slots;
+
+      /// Parameter array for the current point, if provided via setParameterArray
+      const double* parameter_array;
+
+      /// Likelihood components in the ObsLike section of yaml file, with accumulators selected according to their types
+      std::vector<target_info> targets;
 
       /// Graph vertices corresponding to additional functors not in ObsLike part of yaml file
       std::vector<DRes::VertexID> aux_vertices;
@@ -72,9 +99,6 @@ namespace Gambit
       /// Active value for the minimum log likelihood (one of the above two values, whichever is currently in-use)
       double active_min_valid_lnlike;
 
-      /// Map of return types of target functors
-      std::map<DRes::VertexID,str> return_types;
-
       /// Global record of time that last likelihood evaluation began, for computing true total iteration time.
       std::chrono::time_point<std::chrono::system_clock> previous_startL;
       /// Global record of time that last likelihood evaluation ended, for computing intra-iteration overhead time.
@@ -93,6 +117,21 @@ namespace Gambit
       /// Run in likelihood debug mode?
       bool debug;
 
+      /// Number of points between re-optimisations of the likelihood evaluation order (0 = never, the default)
+      long long reorder_period;
+
+      /// Number of points evaluated since the last re-optimisation of the evaluation order
+      long long points_since_reorder;
+
+      /// Re-optimise the order of the likelihood components using their measured runtimes and invalidation rates
+      void reorderTargets();
+
+      /// Choose the accumulator for a target functor, based on its resolved return type
+      lnlike_accumulator select_accumulator(functor*, const str&);
+
+      /// Build a descriptive string identifying a likelihood component
+      str likelihood_tag(functor*);
+
     public:
 
       /// Constructor
@@ -107,6 +146,21 @@ namespace Gambit
       /// Do the prior transformation and populate the parameter map
       void setParameters (const std::unordered_map<std::string, double> &);
 
+      /// Set the model parameters from a contiguous array, using the slots resolved by resolveParameterSlots
+      void setParameters (const double *);
+
+      /// Tell ScannerBit that main can take the parameters from an array instead of the map
+      bool supportsParameterArray () const;
+
+      /// Resolve each scanned model parameter to a fixed slot in the array provided by ScannerBit
+      bool resolveParameterSlots (const std::vector<std::string> &);
+
+      /// Receive the parameter array for the next point from ScannerBit
+      void setParameterArray (const double *);
+
+      /// Notify exceptions of the parameter values, and print them in debug mode
+      void reportParameters (const std::ostringstream &);
+
       /// Evaluate total likelihood function
       double main (std::unordered_map<std::string, double> &in);
 
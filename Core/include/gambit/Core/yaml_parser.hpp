@@ -55,6 +55,7 @@ namespace Gambit
         std::string version;
         bool printme; // Instruction to printer as to whether to write result to disk
         bool weakrule;  // Indicates that rule can be broken
+        bool pinned;  // Keeps an ObsLike at the start of the evaluation order instead of letting it be optimised
         Options options;
         std::vector<Observable> dependencies;
         std::vector<Observable> backends;
@@ -70,6 +71,7 @@ namespace Gambit
           backend(),
           version(),
           printme(true),
+          pinned(false),
           options(),
           dependencies(),
           backends(),
@@ -143,6 +145,9 @@ namespace YAML
       if (node["printme"].IsDefined())
           rhs.printme = node["printme"].as<bool>();
 
+      if (node["pinned"].IsDefined())
+          rhs.pinned = node["pinned"].as<bool>();
+
       if (node["options"].IsDefined())
           rhs.options = Gambit::Options(node["options"]);
       #undef READ
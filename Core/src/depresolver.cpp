@@ -37,6 +37,8 @@
 #include <sstream>
 #include <fstream>
 #include <iomanip>
+#include <algorithm>
+#include <exception>
 #ifdef HAVE_REGEX_H
   #include <regex>
 #endif
@@ -323,6 +325,13 @@ namespace Gambit
     }
 
 
+    // Destructor
+    DependencyResolver::~DependencyResolver()
+    {
+      for (auto it = backend_locks.begin(); it != backend_locks.end(); ++it) omp_destroy_lock(&(*it));
+    }
+
+
     //
     // Initialization stage
     //
@@ -400,6 +409,9 @@ namespace Gambit
         SortedParentVertices[*it] = getSortedParentVertices(*it, masterGraph, function_order);
       }
 
+      // Compile the lists into flat execution plans for use at runtime.
+      compileExecutionPlans();
+
       // Done
     }
 
@@ -574,11 +586,20 @@ namespace Gambit
       std::vector<VertexID> unsorted;
       std::vector<VertexID> sorted;
       std::set<VertexID> parents, colleages, colleages_min;
-      // Copy unsorted vertexIDs --> unsorted
+      // Copy unsorted vertexIDs --> unsorted, except for those pinned by the user,
+      // which go first, in the order in which they appear in the ini file.
       for (std::vector<OutputVertexInfo>::iterator it = outputVertexInfos.begin();
           it != outputVertexInfos.end(); it++)
       {
-        unsorted.push_back(it->vertex);
+        if (it->iniEntry->pinned)
+        {
+          sorted.push_back(it->vertex);
+          getParentVertices(it->vertex, masterGraph, colleages);
+          colleages.insert(it->vertex);
+          logger() << LogTags::dependency_resolver << "Pinned: " << masterGraph[it->vertex]->origin() << "::"
+                   << masterGraph[it->vertex]->name() << EOM;
+        }
+        else unsorted.push_back(it->vertex);
       }
       // Sort iteratively (unsorted --> sorted)
       while (unsorted.size() > 0)
@@ -609,8 +630,8 @@ namespace Gambit
         // Extent list of calculated vertices
         colleages.insert(colleages_min.begin(), colleages_min.end());
         double prop = masterGraph[*it_min]->getInvalidationRate();
-        logger() << LogTags::dependency_resolver << "Estimated T [s]: " << t2p_min*prop << EOM;
-        logger() << LogTags::dependency_resolver << "Estimated p: " << prop << EOM;
+        logger() << LogTags::dependency_resolver << masterGraph[*it_min]->origin() << "::" << masterGraph[*it_min]->name()
+                 << ": estimated T [s]: " << t2p_min*prop << ", estimated p: " << prop << EOM;
         sorted.push_back(*it_min);
         unsorted.erase(it_min);
       }
@@ -623,35 +644,42 @@ namespace Gambit
       // pointID is supplied by the scanner, and is used to tell the printer which model
       // point the results should be associated with.
 
-      if (SortedParentVertices.find(vertex) == SortedParentVertices.end())
+      if (vertex >= ExecutionPlans.size() or ExecutionPlans[vertex].empty())
         core_error().raise(LOCAL_INFO, "Tried to calculate a function not in or not at top of dependency graph.");
-      std::vector<VertexID> order = SortedParentVertices.at(vertex);
+      const ExecutionPlan& plan = ExecutionPlans[vertex];
 
-      for (std::vector<VertexID>::iterator it = order.begin(); it != order.end(); ++it)
+      if (not parallel_branches)
       {
-        std::ostringstream ss;
-        ss << "Calling " << masterGraph[*it]->name() << " from " << masterGraph[*it]->origin() << "...";
-        logger() << LogTags::dependency_resolver << LogTags::info << LogTags::debug << ss.str() << EOM;
-        masterGraph[*it]->calculate();
-        if (boundIniFile->getValueOrDef<bool>(
-              false, "dependency_resolution", "log_runtime") )
+        for (auto it = plan.begin(), end = plan.end(); it != end; ++it)
         {
-          double T = masterGraph[*it]->getRuntimeAverage();
-          logger() << LogTags::dependency_resolver << LogTags::info <<
-            "Runtime, averaged over multiple calls [s]: " << T << EOM;
+          logger() << LogTags::dependency_resolver << LogTags::info << LogTags::debug << it->call_msg << EOM;
+          it->func->calculate();
+          finishStep(*it, pointID);
         }
-        invalid_point_exception* e = masterGraph[*it]->retrieve_invalid_point_exception();
-        if (e != NULL) throw(*e);
-        if (not typeComp(masterGraph[*it]->type(),  "void", *boundTEs, false))
+      }
+      else
+      {
+        // Work through the plan one wave at a time.  Functors within a wave do not depend on each other,
+        // so those that are safe to do so are calculated concurrently first.  The rest are then calculated
+        // in order, and all results are checked and printed from the main thread.
+        auto wave_begin = plan.begin();
+        while (wave_begin != plan.end())
         {
-          // Note that this prints from thread index 0 only, i.e. results created by
-          // threads other than the main one need to be accessed with
-          //   masterGraph[*it]->print(boundPrinter,pointID,index);
-          // where index is some integer s.t. 0 <= index <= number of hardware threads.
-          // At the moment GAMBIT only prints results of thread 0, under the expectation
-          // that nested module functions are all designed to gather their results into
-          // thread 0.
-          masterGraph[*it]->print(boundPrinter,pointID);
+          auto wave_end = wave_begin;
+          std::vector<const ExecutionStep*> concurrent;
+          while (wave_end != plan.end() and wave_end->wave == wave_begin->wave)
+          {
+            if (wave_end->parallel_safe) concurrent.push_back(&(*wave_end));
+            ++wave_end;
+          }
+          if (concurrent.size() > 1) calculateConcurrently(concurrent);
+          for (auto it = wave_begin; it != wave_end; ++it)
+          {
+            logger() << LogTags::dependency_resolver << LogTags::info << LogTags::debug << it->call_msg << EOM;
+            it->func->calculate(); // Does nothing if already calculated concurrently
+            finishStep(*it, pointID);
+          }
+          wave_begin = wave_end;
         }
       }
       // Reset the cout output precision, in case any backends have messed with it during the ObsLike evaluation.
@@ -661,6 +689,43 @@ namespace Gambit
     /// Getter for print_timing flag (used by LikelihoodContainer)
     bool DependencyResolver::printTiming() { return print_timing; }
 
+    /// Write runtime statistics for all active functors to the logs, most expensive first
+    void DependencyResolver::printTimingSummary()
+    {
+      if (not timing_summary) return;
+
+      std::vector<std::pair<double, VertexID> > by_cost;
+      graph_traits<DRes::MasterGraphType>::vertex_iterator vi, vi_end;
+      for (boost::tie(vi, vi_end) = vertices(masterGraph); vi != vi_end; ++vi)
+      {
+        if (masterGraph[*vi]->status() == 2) by_cost.push_back(std::make_pair(masterGraph[*vi]->getRuntimeHistogram().total(), *vi));
+      }
+      std::sort(by_cost.rbegin(), by_cost.rend());
+
+      const str formatString = "%-60s %-10s %-10s %-11s %-11s %-11s %-11s %-11s %-11s\n";
+      const str numberFormatString = "%-60s %-10i %-10i %-11.4e %-11.4e %-11.4e %-11.4e %-11.4e %-11.4e\n";
+      std::ostringstream ss;
+      ss << "Functor runtime summary (times in seconds)" << endl;
+      ss << "------------------------------------------" << endl;
+      ss << boost::format(formatString)% "FUNCTION"% "CALLS"% "INVALID"% "TOTAL"% "MEAN"% "P50"% "P95"% "P99"% "MAX";
+      for (auto it = by_cost.begin(); it != by_cost.end(); ++it)
+      {
+        functor* f = masterGraph[it->second];
+        Utils::LatencyHistogram h = f->getRuntimeHistogram();
+        ss << boost::format(numberFormatString)%
+         (f->origin() + "::" + f->name())%
+         h.count()%
+         f->getInvalidationCount()%
+         h.total()%
+         h.mean()%
+         h.quantile(0.5)%
+         h.quantile(0.95)%
+         h.quantile(0.99)%
+         h.max();
+      }
+      logger() << LogTags::dependency_resolver << LogTags::info << ss.str() << EOM;
+    }
+
     // Get the functor corresponding to a single VertexID
     functor* DependencyResolver::get_functor(VertexID id)
     {
@@ -730,6 +795,157 @@ namespace Gambit
     // Private definitions of DependencyResolver class
     ////////////////////////////////////////////////////
 
+    // Compile the per-point execution plans for all ObsLike vertices
+    void DependencyResolver::compileExecutionPlans()
+    {
+      // Anything that requires the ini file, string formatting or type
+      // comparison is done here once, rather than for every functor at every point.
+      log_runtime = boundIniFile->getValueOrDef<bool>(false, "dependency_resolution", "log_runtime");
+      parallel_branches = boundIniFile->getValueOrDef<bool>(false, "dependency_resolution", "parallel_branches");
+      if (parallel_branches) logger() << LogTags::dependency_resolver << "Independent branches of the dependency tree will be evaluated concurrently." << EOM;
+
+      // Loop managers and the functors nested within them must always run from the main thread.
+      std::set<VertexID> serial_only;
+      for (auto it = loopManagerMap.begin(); it != loopManagerMap.end(); ++it)
+      {
+        serial_only.insert(it->first);
+        serial_only.insert(it->second.begin(), it->second.end());
+      }
+
+      // Backend initialisation functions need the lock of the backend they initialise.
+      for (auto it = SortedParentVertices.begin(); it != SortedParentVertices.end(); ++it)
+      {
+        for (auto jt = it->second.begin(); jt != it->second.end(); ++jt)
+        {
+          if (masterGraph[*jt]->origin() == "BackendIniBit") backendsUsed[*jt].insert(masterGraph[*jt]->capability());
+        }
+      }
+
+      // Assign a lock index to each backend in use.
+      std::map<str, int> lock_index;
+      for (auto it = backendsUsed.begin(); it != backendsUsed.end(); ++it)
+      {
+        for (auto jt = it->second.begin(); jt != it->second.end(); ++jt)
+        {
+          if (lock_index.find(*jt) == lock_index.end())
+          {
+            int n = lock_index.size();
+            lock_index[*jt] = n;
+          }
+        }
+      }
+      if (backend_locks.empty())
+      {
+        backend_locks.resize(lock_index.size());
+        for (auto it = backend_locks.begin(); it != backend_locks.end(); ++it) omp_init_lock(&(*it));
+      }
+
+      ExecutionPlans.clear();
+      ExecutionPlans.resize(num_vertices(masterGraph));
+      for (auto it = SortedParentVertices.begin(); it != SortedParentVertices.end(); ++it)
+      {
+        ExecutionPlan& plan = ExecutionPlans[it->first];
+        std::map<VertexID, int> waves;
+        plan.reserve(it->second.size());
+        for (auto jt = it->second.begin(); jt != it->second.end(); ++jt)
+        {
+          ExecutionStep step;
+          step.func = masterGraph[*jt];
+          step.printable = not typeComp(step.func->type(), "void", *boundTEs, false);
+          step.call_msg = "Calling " + step.func->name() + " from " + step.func->origin() + "...";
+          // Vertices are topologically sorted, so all parents within the plan already have a wave.
+          step.wave = 0;
+          graph_traits<DRes::MasterGraphType>::in_edge_iterator ei, ei_end;
+          for (boost::tie(ei, ei_end) = in_edges(*jt, masterGraph); ei != ei_end; ++ei)
+          {
+            auto parent = waves.find(source(*ei, masterGraph));
+            if (parent != waves.end()) step.wave = std::max(step.wave, parent->second + 1);
+          }
+          waves[*jt] = step.wave;
+          // Only functors declared THREAD_SAFE in their rollcall are ever run concurrently.
+          step.parallel_safe = (step.func->threadSafe() and serial_only.find(*jt) == serial_only.end());
+          if (step.func->threadSafe() and step.func->canBeLoopManager())
+          {
+            str msg = "Functor " + step.func->origin() + "::" + step.func->name() + " is declared THREAD_SAFE,"
+                      "\nbut loop managers open OpenMP regions of their own and cannot be run concurrently.";
+            core_error().raise(LOCAL_INFO, msg);
+          }
+          auto backends = backendsUsed.find(*jt);
+          if (backends != backendsUsed.end())
+          {
+            for (auto kt = backends->second.begin(); kt != backends->second.end(); ++kt) step.locks.push_back(lock_index.at(*kt));
+            std::sort(step.locks.begin(), step.locks.end());
+          }
+          plan.push_back(step);
+        }
+        // Group the plan by wave, keeping the topological order within each wave.
+        if (parallel_branches)
+        {
+          std::stable_sort(plan.begin(), plan.end(), [](const ExecutionStep& a, const ExecutionStep& b) { return a.wave < b.wave; });
+        }
+      }
+    }
+
+    // Log, check for invalidation and print the result of a single calculated step of an execution plan
+    void DependencyResolver::finishStep(const ExecutionStep& step, const int pointID)
+    {
+      if (log_runtime)
+      {
+        double T = step.func->getRuntimeAverage();
+        logger() << LogTags::dependency_resolver << LogTags::info <<
+          "Runtime, averaged over multiple calls [s]: " << T << EOM;
+      }
+      invalid_point_exception* e = step.func->retrieve_invalid_point_exception();
+      if (e != NULL) throw(*e);
+      if (step.printable)
+      {
+        // Note that this prints from thread index 0 only, i.e. results created by
+        // threads other than the main one need to be accessed with
+        //   masterGraph[*it]->print(boundPrinter,pointID,index);
+        // where index is some integer s.t. 0 <= index <= number of hardware threads.
+        // At the moment GAMBIT only prints results of thread 0, under the expectation
+        // that nested module functions are all designed to gather their results into
+        // thread 0.
+        step.func->print(boundPrinter,pointID);
+      }
+    }
+
+    // Calculate a set of mutually independent functors concurrently, holding the relevant backend locks
+    void DependencyResolver::calculateConcurrently(const std::vector<const ExecutionStep*>& steps)
+    {
+      // Each functor runs inside a Parallel_throw_scope, so errors and invalid points raised by it are
+      // thrown rather than causing a hard stop.  Invalid points are then caught and saved by the functor
+      // itself, and raised from the main thread by finishStep; anything else is carried out of the
+      // parallel region here and rethrown from the main thread.
+      // The functors leave cout alone inside the region, so its flags are saved here instead.
+      // Note that an OpenMP region opened by a functor run here would be serialised, and its single
+      // thread would report omp_get_thread_num() == 0, sharing the main thread's slot in the
+      // per-thread LogMaster state.  This is why loop managers, nested functors and anything not
+      // declared THREAD_SAFE are excluded when the execution plans are compiled.
+      FunctorHelp::cout_flags_saver ifs;
+      std::vector<std::exception_ptr> errors(steps.size());
+      #pragma omp parallel for schedule(dynamic)
+      for (int i = 0; i < int(steps.size()); ++i)
+      {
+        const ExecutionStep* step = steps[i];
+        for (auto it = step->locks.begin(); it != step->locks.end(); ++it) omp_set_lock(&backend_locks[*it]);
+        try
+        {
+          Parallel_throw_scope scope;
+          step->func->calculate();
+        }
+        catch (...)
+        {
+          errors[i] = std::current_exception();
+        }
+        for (auto it = step->locks.rbegin(); it != step->locks.rend(); ++it) omp_unset_lock(&backend_locks[*it]);
+      }
+      for (auto it = errors.begin(); it != errors.end(); ++it)
+      {
+        if (*it) std::rethrow_exception(*it);
+      }
+    }
+
     str DependencyResolver::printQuantityToBeResolved(const sspair & quantity, const DRes::VertexID & vertex)
     {
         str s = quantity.first + " (" + quantity.second + ")";
@@ -1408,7 +1624,9 @@ namespace Gambit
       // Read ini entries
       use_regex    = boundIniFile->getValueOrDef<bool>(false, "dependency_resolution", "use_regex");
       print_timing = boundIniFile->getValueOrDef<bool>(false, "print_timing_data");
+      timing_summary = boundIniFile->getValueOrDef<bool>(false, "timing_summary");
       if ( use_regex )    logger() << "Using regex for string comparison." << endl;
+      if ( timing_summary ) logger() << "Will write a summary of functor runtimes to the logs at the end of the run." << endl;
       if ( print_timing ) logger() << "Will output timing information for all functors (via printer system)" << EOM;
 
       //
@@ -2028,6 +2246,8 @@ namespace Gambit
     void DependencyResolver::resolveRequirement(functor* func, VertexID vertex)
     {
       (*masterGraph[vertex]).resolveBackendReq(func);
+      // Note the backend in use, identified by the capability of its initialisation function.
+      backendsUsed[vertex].insert(func->origin() + "_" + func->safe_version() + "_init");
       logger() << LogTags::dependency_resolver;
       logger() << "Resolved by: [" << func->name() << ", ";
       logger() << func->origin() << " (" << func->version() << ")]";
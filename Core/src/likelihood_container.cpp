@@ -29,11 +29,36 @@
 #include "gambit/Utils/signal_helpers.hpp"
 #include "gambit/Utils/signal_handling.hpp"
 
+#include <algorithm>
+
 //#define CORE_DEBUG
 
 namespace Gambit
 {
 
+  /// Add a scalar likelihood result to the total, reading it directly from the functor.
+  template <typename TYPE>
+  double accumulate_scalar_lnlike(functor* f, std::ostringstream* debug_to_cout)
+  {
+    const TYPE& result = (*static_cast<module_functor<TYPE>*>(f))(0);
+    if (debug_to_cout != NULL) *debug_to_cout << result;
+    return result;
+  }
+
+  /// Add a vector of likelihood results to the total, reading them directly from the functor.
+  template <typename TYPE>
+  double accumulate_vector_lnlike(functor* f, std::ostringstream* debug_to_cout)
+  {
+    const std::vector<TYPE>& result = (*static_cast<module_functor<std::vector<TYPE> >*>(f))(0);
+    double lnlike = 0;
+    for (auto it = result.begin(); it != result.end(); ++it)
+    {
+      if (debug_to_cout != NULL) *debug_to_cout << *it << " ";
+      lnlike += *it;
+    }
+    return lnlike;
+  }
+
   // Methods for Likelihood_Container class.
 
   /// Constructor
@@ -47,6 +72,7 @@ namespace Gambit
   : dependencyResolver (dependencyResolver),
     printer            (printer),
     functorMap         (functorMap),
+    parameter_array    (NULL),
     #ifdef WITH_MPI
       errorComm        (comm),
     #endif
@@ -63,10 +89,12 @@ namespace Gambit
     interloopID(Printers::get_main_param_id(interlooptime_label)),
     totalloopID(Printers::get_main_param_id(totallooptime_label)),
     #ifdef CORE_DEBUG
-      debug            (true)
+      debug            (true),
     #else
-      debug            (iniFile.getValueOrDef<bool>(false, "debug") or iniFile.getValueOrDef<bool>(false, "likelihood", "debug"))
+      debug            (iniFile.getValueOrDef<bool>(false, "debug") or iniFile.getValueOrDef<bool>(false, "likelihood", "debug")),
     #endif
+    reorder_period     (iniFile.getValueOrDef<long long>(0, "likelihood", "reorder_every")),
+    points_since_reorder(0)
   {
     // Set the list of valid return types of functions that can be used for 'purpose' by this container class.
     const std::vector<str> allowed_types_for_purpose = initVector<str>("double", "std::vector<double>", "float", "std::vector<float>");
@@ -76,8 +104,10 @@ namespace Gambit
     {
       if (dependencyResolver.getIniEntry(*it)->purpose == purpose)
       {
-        return_types[*it] = dependencyResolver.checkTypeMatch(*it, purpose, allowed_types_for_purpose);
-        target_vertices.push_back(std::move(*it));
+        str rtype = dependencyResolver.checkTypeMatch(*it, purpose, allowed_types_for_purpose);
+        functor* f = dependencyResolver.get_functor(*it);
+        target_info info = {*it, f, select_accumulator(f, rtype)};
+        targets.push_back(info);
       }
       else
       {
@@ -86,6 +116,70 @@ namespace Gambit
     }
   }
 
+  /// Choose the accumulator for a target functor, based on its resolved return type
+  Likelihood_Container::lnlike_accumulator Likelihood_Container::select_accumulator(functor* f, const str& rtype)
+  {
+    // Check the actual functor type once here, so that the accumulators can skip it at every point.
+    bool match = false;
+    lnlike_accumulator acc = NULL;
+    if (rtype == "double")
+    {
+      match = (dynamic_cast<module_functor<double>*>(f) != NULL);
+      acc = &accumulate_scalar_lnlike<double>;
+    }
+    else if (rtype == "std::vector<double>")
+    {
+      match = (dynamic_cast<module_functor<std::vector<double> >*>(f) != NULL);
+      acc = &accumulate_vector_lnlike<double>;
+    }
+    else if (rtype == "float")
+    {
+      match = (dynamic_cast<module_functor<float>*>(f) != NULL);
+      acc = &accumulate_scalar_lnlike<float>;
+    }
+    else if (rtype == "std::vector<float>")
+    {
+      match = (dynamic_cast<module_functor<std::vector<float> >*>(f) != NULL);
+      acc = &accumulate_vector_lnlike<float>;
+    }
+    else core_error().raise(LOCAL_INFO, "Unexpected target functor type.");
+    if (not match)
+    {
+      str msg = "Attempted to retrieve result of " + f->origin() + "::" + f->name() +
+                "\nwith incorrect type.  The type should be: " + f->type() + ".";
+      core_error().raise(LOCAL_INFO, msg);
+    }
+    return acc;
+  }
+
+  /// Re-optimise the order of the likelihood components using their measured runtimes and invalidation rates
+  void Likelihood_Container::reorderTargets()
+  {
+    // The dependency resolver orders by expected time to invalidation, now using measured rather than initial values.
+    std::vector<DRes::VertexID> order = dependencyResolver.getObsLikeOrder();
+    std::map<DRes::VertexID, int> position;
+    for (unsigned int i = 0; i < order.size(); ++i) position[order[i]] = i;
+    std::stable_sort(targets.begin(), targets.end(), [&position](const target_info& a, const target_info& b)
+    {
+      return position.at(a.vertex) < position.at(b.vertex);
+    });
+
+    std::ostringstream ss;
+    ss << "Re-optimised likelihood evaluation order (average runtime [s], invalidation rate):";
+    for (auto it = targets.begin(); it != targets.end(); ++it)
+    {
+      ss << endl << "  " << it->func->origin() << "::" << it->func->name() << " (" << it->func->getRuntimeAverage()
+         << ", " << it->func->getInvalidationRate() << ")";
+    }
+    logger() << LogTags::core << ss.str() << EOM;
+  }
+
+  /// Build a descriptive string identifying a likelihood component
+  str Likelihood_Container::likelihood_tag(functor* f)
+  {
+    return "ikelihood contribution from " + f->origin() + "::" + f->name();
+  }
+
   /// Do the prior transformation and populate the parameter map
   void Likelihood_Container::setParameters (const std::unordered_map<std::string, double> &parameterMap)
   {
@@ -122,6 +216,64 @@ namespace Gambit
       }
     }
 
+    reportParameters(parstream);
+  }
+
+  /// Set the model parameters from a contiguous array, using the slots resolved by resolveParameterSlots
+  void Likelihood_Container::setParameters (const double *parameters)
+  {
+    // Set up a stream containing the parameter values, for diagnostic output
+    std::ostringstream parstream;
+
+    for (auto it = parameter_slots.begin(), end = parameter_slots.end(); it != end; ++it)
+    {
+      if (it->first_in_model) parstream << "  " << it->model << ":" << endl;
+      *(it->value) = parameters[it->slot];
+      parstream << "    " << it->name << ": " << *(it->value) << endl;
+    }
+
+    reportParameters(parstream);
+  }
+
+  /// Tell ScannerBit that main can take the parameters from an array instead of the map
+  bool Likelihood_Container::supportsParameterArray () const
+  {
+    return true;
+  }
+
+  /// Resolve each scanned model parameter to a fixed slot in the array provided by ScannerBit
+  bool Likelihood_Container::resolveParameterSlots (const std::vector<std::string> &names)
+  {
+    parameter_slots.clear();
+    for (auto act_it = functorMap.begin(), act_end = functorMap.end(); act_it != act_end; act_it++)
+    {
+      ModelParameters* params = act_it->second->getcontentsPtr();
+      auto paramkeys = params->getKeys();
+      for (auto par_it = paramkeys.begin(), par_end = paramkeys.end(); par_it != par_end; par_it++)
+      {
+        auto pos = std::find(names.begin(), names.end(), act_it->first + "::" + *par_it);
+        // If any parameter is missing, stick with the map interface, which gives a detailed error at the first point.
+        if (pos == names.end())
+        {
+          parameter_slots.clear();
+          return false;
+        }
+        parameter_slot ps = {int(pos - names.begin()), params->getValuePtr(*par_it), par_it == paramkeys.begin(), act_it->first, *par_it};
+        parameter_slots.push_back(ps);
+      }
+    }
+    return true;
+  }
+
+  /// Receive the parameter array for the next point from ScannerBit
+  void Likelihood_Container::setParameterArray (const double *parameters)
+  {
+    parameter_array = parameters;
+  }
+
+  /// Notify exceptions of the parameter values, and print them in debug mode
+  void Likelihood_Container::reportParameters (const std::ostringstream &parstream)
+  {
     // Notify all exceptions of the values of the parameters for this point.
     exception::set_parameters("\n\nYAML-ready parameter values at failed point:\n"+parstream.str());
 
@@ -180,11 +332,24 @@ namespace Gambit
 
       bool compute_aux = true;
 
+      // Periodically re-optimise the order in which the likelihood components are evaluated.
+      if (reorder_period > 0 and ++points_since_reorder >= reorder_period)
+      {
+        reorderTargets();
+        points_since_reorder = 0;
+      }
+
       // Set the values of the parameter point in the PrimaryParameters functor, and log them to cout and/or the logs if desired.
-      setParameters(in);
+      // Use the array from ScannerBit if one has been provided for this point, otherwise fall back to the map.
+      if (parameter_array != NULL)
+      {
+        setParameters(parameter_array);
+        parameter_array = NULL;
+      }
+      else setParameters(in);
 
       // Logger debug output; things labelled 'LogTags::debug' only get logged if the logger::debug or master debug flags are true, not if only 'likelihood::debug' is true.
-      logger() << LogTags::core << LogTags::debug << "Number of target vertices to calculate:    " << target_vertices.size() << endl
+      logger() << LogTags::core << LogTags::debug << "Number of target vertices to calculate:    " << targets.size() << endl
                                                   << "Number of auxiliary vertices to calculate: " << aux_vertices.size() << EOM;
 
       // Begin timing of total likelihood evaluation
@@ -194,55 +359,22 @@ namespace Gambit
       std::chrono::duration<double> interloop_time = startL - previous_endL;
 
       // First work through the target functors, i.e. the ones contributing to the likelihood.
-      for (auto it = target_vertices.begin(), end = target_vertices.end(); it != end; ++it)
+      for (auto it = targets.begin(), end = targets.end(); it != end; ++it)
       {
         // Log the likelihood being tried.
-        str likelihood_tag = "ikelihood contribution from " + dependencyResolver.get_functor(*it)->origin()
-                             + "::" + dependencyResolver.get_functor(*it)->name();
-        if (debug) logger() << LogTags::core << "Calculating l" << likelihood_tag << "." << EOM;
+        if (debug) logger() << LogTags::core << "Calculating l" << likelihood_tag(it->func) << "." << EOM;
 
         try
         {
           // Set up debug output streams.
           std::ostringstream debug_to_cout;
-          if (debug) debug_to_cout << "  L" << likelihood_tag << ": ";
+          if (debug) debug_to_cout << "  L" << likelihood_tag(it->func) << ": ";
 
           // Calculate the likelihood component. The pointID is passed through to the printer call for each functor.
-          dependencyResolver.calcObsLike(*it,getPtID());
+          dependencyResolver.calcObsLike(it->vertex,getPtID());
 
-          // Switch depending on whether the functor returns floats or doubles and a single likelihood or a vector of them.
-          str rtype = return_types[*it];
-          if (rtype == "double")
-          {
-            double result = dependencyResolver.getObsLike<double>(*it);
-            if (debug) debug_to_cout << result;
-            lnlike += result;
-          }
-          else if (rtype == "std::vector<double>")
-          {
-            std::vector<double> result = dependencyResolver.getObsLike<std::vector<double> >(*it);
-            for (auto jt = result.begin(); jt != result.end(); ++jt)
-            {
-              if (debug) debug_to_cout << *jt << " ";
-              lnlike += *jt;
-            }
-          }
-          else if (rtype == "float")
-          {
-            float result = dependencyResolver.getObsLike<float>(*it);
-            if (debug) debug_to_cout << result;
-            lnlike += result;
-          }
-          else if (rtype == "std::vector<float>")
-          {
-            std::vector<float> result = dependencyResolver.getObsLike<std::vector<float> >(*it);
-            for (auto jt = result.begin(); jt != result.end(); ++jt)
-            {
-              if (debug) debug_to_cout << *jt << " ";
-              lnlike += *jt;
-            }
-          }
-          else core_error().raise(LOCAL_INFO, "Unexpected target functor type.");
+          // Add the result(s) to the total, using the accumulator chosen for this functor's type.
+          lnlike += it->accumulate(it->func, debug ? &debug_to_cout : NULL);
 
           // Print debug info
           if (debug) cout << debug_to_cout.str() << endl;
@@ -250,14 +382,14 @@ namespace Gambit
           // Don't just roll over if it's a NaN, kill the scan and force the developer to fix it.
           if (Utils::isnan(lnlike))
           {
-            core_error().raise(LOCAL_INFO, "L" + likelihood_tag + " is NaN!");
+            core_error().raise(LOCAL_INFO, "L" + likelihood_tag(it->func) + " is NaN!");
           }
 
           // If we've dropped below the likelihood corresponding to effective zero already, skip the rest of the vertices.
-          if (lnlike <= active_min_valid_lnlike) dependencyResolver.invalidatePointAt(*it, false);
+          if (lnlike <= active_min_valid_lnlike) dependencyResolver.invalidatePointAt(it->vertex, false);
 
           // Log completion of this likelihood.
-          if (debug) logger() << LogTags::core << "Computed l" << likelihood_tag << "." << EOM;
+          if (debug) logger() << LogTags::core << "Computed l" << likelihood_tag(it->func) << "." << EOM;
         }
 
         // Catch points that are invalid, either due to low like or pathology.  Skip the rest of the vertices if a point is invalid.
@@ -281,9 +413,13 @@ namespace Gambit
         for (auto it = aux_vertices.begin(), end = aux_vertices.end(); it != end; ++it)
         {
           // Log the observables being tried.
-          str aux_tag = "dditional observable from " + dependencyResolver.get_functor(*it)->origin()
-                               + "::" + dependencyResolver.get_functor(*it)->name();
-          if (debug) logger() << LogTags::core <<  "Calculating a" << aux_tag << "." << EOM;
+          str aux_tag;
+          if (debug)
+          {
+            aux_tag = "dditional observable from " + dependencyResolver.get_functor(*it)->origin()
+                      + "::" + dependencyResolver.get_functor(*it)->name();
+            logger() << LogTags::core <<  "Calculating a" << aux_tag << "." << EOM;
+          }
 
           try
           {
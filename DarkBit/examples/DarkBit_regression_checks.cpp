@@ -0,0 +1,191 @@
+//   GAMBIT: Global and Modular BSM Inference Tool
+//   *********************************************
+///  \file
+///
+///  Regression checks for the DarkBit building
+///  blocks that were sped up or parallelised:
+///  - the daFunk interpolation bin lookup and
+///    vectorised evaluation
+///  - merging the per-thread cascade MC
+///    histograms
+///
+///  Returns non-zero if any check fails.
+///
+///  *********************************************
+///
+///  Authors (add name and date if you modify):
+///
+///  \author agent
+///          (agent@local)
+///  \date 2026 Oct
+///
+///  *********************************************
+
+#include <cmath>
+#include <random>
+#include <algorithm>
+#include <iostream>
+
+#include <omp.h>
+
+#include "gambit/Elements/daFunk.hpp"
+#include "gambit/DarkBit/SimpleHist.hpp"
+
+using namespace Gambit;
+using namespace Gambit::DarkBit;
+
+using std::cout;
+using std::endl;
+
+namespace
+{
+
+  int failures = 0;
+
+  void check(bool passed, const std::string& what)
+  {
+    cout << (passed ? "  passed: " : "  FAILED: ") << what << endl;
+    if (not passed) failures++;
+  }
+
+  std::mt19937 gen(2016);
+
+  /// Interpolation by a linear search for the bin, as FunkInterp used to do it
+  double reference_interp(const std::vector<double>& x, const std::vector<double>& y, const std::string& mode, double x0)
+  {
+    if (x0 < x.front() or x0 > x.back()) return 0;
+    size_t i = 0;
+    while (i+2 < x.size() and x0 >= x[i+1]) i++;
+    if (mode == "log") return y[i]*std::pow(y[i+1]/y[i], std::log(x0/x[i])/std::log(x[i+1]/x[i]));
+    return y[i] + (x0-x[i])*(y[i+1]-y[i])/(x[i+1]-x[i]);
+  }
+
+  bool close(double a, double b)
+  {
+    return std::abs(a - b) <= 1e-12*std::max(std::abs(a), std::abs(b)) + 1e-300;
+  }
+
+  /// Compare eval and vect of interpolations on the given grid against the reference
+  void check_interp(const std::string& grid, std::vector<double> x, const std::string& mode)
+  {
+    std::uniform_real_distribution<double> flat(0.5, 2.0);
+    std::vector<double> y(x.size()), y2(x.size());
+    for (size_t i = 0; i < x.size(); i++) { y[i] = flat(gen)*std::exp(-x[i]/x.back()); y2[i] = flat(gen); }
+
+    daFunk::Funk f(new daFunk::FunkInterp("E", x, y, mode));
+    daFunk::Funk g(new daFunk::FunkInterp("E", x, y2, mode));
+    daFunk::BoundFunk bf = f->bind("E");
+    daFunk::BoundFunk bsum = (f + g*f)->bind("E");
+
+    // Random points across and just beyond the grid, plus every node
+    std::uniform_real_distribution<double> range(x.front()*0.9, x.back()*1.1);
+    std::vector<double> points(x);
+    for (int i = 0; i < 1000; i++) points.push_back(range(gen));
+    std::shuffle(points.begin(), points.end(), gen);
+
+    bool eval_ok = true;
+    std::vector<double> expected(points.size()), expected_sum(points.size());
+    for (size_t i = 0; i < points.size(); i++)
+    {
+      expected[i] = reference_interp(x, y, mode, points[i]);
+      expected_sum[i] = expected[i] + reference_interp(x, y2, mode, points[i])*expected[i];
+      eval_ok = eval_ok and close(bf->eval(points[i]), expected[i]);
+    }
+    check(eval_ok, grid + " grid, " + mode + ": single evaluations match the reference");
+
+    bool vect_ok = true;
+    std::vector<double> unsorted = bf->vect(points);
+    std::vector<double> sum = bsum->vect(points);
+    for (size_t i = 0; i < points.size(); i++)
+    {
+      vect_ok = vect_ok and close(unsorted[i], expected[i]) and close(sum[i], expected_sum[i]);
+    }
+    std::vector<double> sorted_points(points), sorted_expected(points.size());
+    std::sort(sorted_points.begin(), sorted_points.end());
+    for (size_t i = 0; i < points.size(); i++) sorted_expected[i] = reference_interp(x, y, mode, sorted_points[i]);
+    std::vector<double> sorted = bf->vect(sorted_points);
+    for (size_t i = 0; i < points.size(); i++) vect_ok = vect_ok and close(sorted[i], sorted_expected[i]);
+    check(vect_ok, grid + " grid, " + mode + ": vectorised evaluations match the reference");
+
+    // Shared interpolations must be usable from several threads at once
+    bool threads_ok = true;
+    #pragma omp parallel for num_threads(4) reduction(&&:threads_ok)
+    for (size_t i = 0; i < points.size(); i++)
+    {
+      threads_ok = threads_ok and close(bf->eval(points[i]), expected[i]);
+    }
+    check(threads_ok, grid + " grid, " + mode + ": concurrent evaluations match the reference");
+  }
+
+}
+
+int main()
+{
+
+  try
+  {
+
+    cout << endl << "Starting DarkBit regression checks" << endl;
+    cout << "----------" << endl;
+
+    // Uniform, log-uniform and irregular grids, as used for cascade and annihilation spectra
+    cout << endl << "daFunk interpolation:" << endl;
+    std::vector<double> uniform, loguniform, irregular;
+    for (int i = 0; i <= 100; i++)
+    {
+      uniform.push_back(1.0 + 0.5*i);
+      loguniform.push_back(1e-3*std::pow(1e5, i/100.));
+    }
+    std::uniform_real_distribution<double> step(0.01, 3.0);
+    irregular.push_back(0.5);
+    for (int i = 0; i < 100; i++) irregular.push_back(irregular.back() + step(gen));
+    for (const std::string mode : {"lin", "log"})
+    {
+      check_interp("uniform", uniform, mode);
+      check_interp("log-uniform", loguniform, mode);
+      check_interp("irregular", irregular, mode);
+    }
+
+    // Histograms filled per thread and merged must equal one filled by a single thread
+    cout << endl << "Cascade MC histograms:" << endl;
+    const int nthreads = 4;
+    std::vector<double> energies(100000), weights(energies.size());
+    std::uniform_real_distribution<double> logE(-3, 3), weight(0, 2);
+    for (size_t i = 0; i < energies.size(); i++) { energies[i] = std::pow(10, logE(gen)); weights[i] = weight(gen); }
+    SimpleHist serial(150, 1e-3, 1e3, true), merged(150, 1e-3, 1e3, true);
+    std::vector<SimpleHist> local(nthreads, SimpleHist(150, 1e-3, 1e3, true));
+    for (size_t i = 0; i < energies.size(); i++) serial.addEvent(energies[i], weights[i]);
+    #pragma omp parallel num_threads(nthreads)
+    {
+      SimpleHist& mine = local[omp_get_thread_num()];
+      #pragma omp for
+      for (size_t i = 0; i < energies.size(); i++) mine.addEvent(energies[i], weights[i]);
+    }
+    for (int t = 0; t < nthreads; t++) merged.addHist_sameBin(local[t]);
+    bool hist_ok = true;
+    for (int i = 0; i < serial.nBins; i++)
+    {
+      hist_ok = hist_ok and std::abs(merged.binVals[i] - serial.binVals[i]) <= 1e-10*serial.binVals[i]
+                        and std::abs(merged.getError(i) - serial.getError(i)) <= 1e-10*serial.getError(i);
+    }
+    check(hist_ok, "merged per-thread histograms match the serially filled one");
+
+    cout << endl;
+    if (failures > 0)
+    {
+      cout << "DarkBit regression checks: " << failures << " FAILED." << endl << endl;
+      return 1;
+    }
+    cout << "DarkBit regression checks passed." << endl << endl;
+
+  }
+
+  catch (std::exception& e)
+  {
+    cout << "DarkBit regression checks have exited with fatal exception: " << e.what() << endl;
+    return 1;
+  }
+
+  return 0;
+
+}
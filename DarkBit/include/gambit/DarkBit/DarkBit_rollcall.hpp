@@ -200,13 +200,16 @@ START_MODULE
   START_CAPABILITY
     #define FUNCTION RD_fraction_one
       START_FUNCTION(double)
+      THREAD_SAFE
     #undef FUNCTION
     #define FUNCTION RD_fraction_leq_one
       START_FUNCTION(double)
+      THREAD_SAFE
       DEPENDENCY(RD_oh2, double)
     #undef FUNCTION
     #define FUNCTION RD_fraction_rescaled
       START_FUNCTION(double)
+      THREAD_SAFE
       DEPENDENCY(RD_oh2, double)
     #undef FUNCTION
   #undef CAPABILITY
@@ -222,6 +225,14 @@ START_MODULE
     #undef FUNCTION
   #undef CAPABILITY
 
+  // Number of consecutive events generated by each thread of the cascade MC
+  #define CAPABILITY cascadeMC_EventBlockSize
+  START_CAPABILITY
+    #define FUNCTION cascadeMC_EventBlockSize
+      START_FUNCTION(int)
+    #undef FUNCTION
+  #undef CAPABILITY
+
   // Function setting up the decay table used in decay chains
   #define CAPABILITY cascadeMC_DecayTable
   START_CAPABILITY
@@ -238,6 +249,7 @@ START_MODULE
     #define FUNCTION cascadeMC_LoopManager
       START_FUNCTION(void, CAN_MANAGE_LOOPS)
       DEPENDENCY(GA_missingFinalStates, std::vector<std::string>)
+      DEPENDENCY(cascadeMC_EventBlockSize, int)
     #undef FUNCTION
   #undef CAPABILITY
 
@@ -282,6 +294,7 @@ START_MODULE
       DEPENDENCY(TH_ProcessCatalog, DarkBit::TH_ProcessCatalog)
       DEPENDENCY(SimYieldTable, DarkBit::SimYieldTable)
       DEPENDENCY(cascadeMC_FinalStates,std::vector<std::string>)
+      DEPENDENCY(cascadeMC_EventBlockSize, int)
       NEEDS_MANAGER_WITH_CAPABILITY(cascadeMC_LoopManagement)
     #undef FUNCTION
   #undef CAPABILITY
@@ -450,10 +463,12 @@ START_MODULE
   START_CAPABILITY
     #define FUNCTION lnL_oh2_Simple
       START_FUNCTION(double)
+      THREAD_SAFE
       DEPENDENCY(RD_oh2, double)
     #undef FUNCTION
     #define FUNCTION lnL_oh2_upperlimit
       START_FUNCTION(double)
+      THREAD_SAFE
       DEPENDENCY(RD_oh2, double)
     #undef FUNCTION
   #undef CAPABILITY
@@ -464,6 +479,7 @@ START_MODULE
   START_CAPABILITY
     #define FUNCTION lnL_rho0_lognormal
       START_FUNCTION(double)
+      THREAD_SAFE
       DEPENDENCY(LocalHalo, LocalMaxwellianHalo)
     #undef FUNCTION
   #undef CAPABILITY
@@ -472,6 +488,7 @@ START_MODULE
   START_CAPABILITY
     #define FUNCTION lnL_vrot_gaussian
       START_FUNCTION(double)
+      THREAD_SAFE
       DEPENDENCY(LocalHalo, LocalMaxwellianHalo)
     #undef FUNCTION
   #undef CAPABILITY
@@ -480,6 +497,7 @@ START_MODULE
   START_CAPABILITY
     #define FUNCTION lnL_v0_gaussian
       START_FUNCTION(double)
+      THREAD_SAFE
       DEPENDENCY(LocalHalo, LocalMaxwellianHalo)
     #undef FUNCTION
   #undef CAPABILITY
@@ -488,6 +506,7 @@ START_MODULE
   START_CAPABILITY
     #define FUNCTION lnL_vesc_gaussian
       START_FUNCTION(double)
+      THREAD_SAFE
       DEPENDENCY(LocalHalo, LocalMaxwellianHalo)
     #undef FUNCTION
   #undef CAPABILITY
@@ -551,6 +570,7 @@ START_MODULE
   START_CAPABILITY
     #define FUNCTION lnL_sigmas_sigmal
       START_FUNCTION(double)
+      THREAD_SAFE
       ALLOW_MODEL(nuclear_params_sigmas_sigmal)
     #undef FUNCTION
   #undef CAPABILITY
@@ -559,6 +579,7 @@ START_MODULE
   START_CAPABILITY
     #define FUNCTION lnL_deltaq
       START_FUNCTION(double)
+      THREAD_SAFE
       ALLOW_MODELS(nuclear_params_fnq)
     #undef FUNCTION
   #undef CAPABILITY
@@ -994,10 +1015,12 @@ START_MODULE
   START_CAPABILITY
     #define FUNCTION GalacticHalo_gNFW
     START_FUNCTION(GalacticHaloProperties)
+    THREAD_SAFE
     ALLOW_MODEL(Halo_gNFW)
     #undef FUNCTION
     #define FUNCTION GalacticHalo_Einasto
     START_FUNCTION(GalacticHaloProperties)
+    THREAD_SAFE
     ALLOW_MODEL(Halo_Einasto)
     #undef FUNCTION
   #undef CAPABILITY
@@ -1006,6 +1029,7 @@ START_MODULE
   START_CAPABILITY
     #define FUNCTION ExtractLocalMaxwellianHalo
     START_FUNCTION(LocalMaxwellianHalo)
+    THREAD_SAFE
     ALLOW_MODELS(Halo_gNFW, Halo_Einasto)
     #undef FUNCTION
   #undef CAPABILITY
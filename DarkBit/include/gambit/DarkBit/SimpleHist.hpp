@@ -60,6 +60,11 @@ namespace Gambit
         /// Important: Input histogram MUST have identical binning for this to give correct results.
         void addHistAsWeights_sameBin(SimpleHist &in);
 
+        /// Add bin contents and squared weights of input histogram, i.e. merge
+        /// two independently filled histograms.
+        /// Important: Input histogram MUST have identical binning for this to give correct results.
+        void addHist_sameBin(const SimpleHist &in);
+
         /// Get error for a specified bin
         double getError(int bin) const;
 
@@ -18,6 +18,10 @@
 ///
 ///  *********************************************
 
+#include <atomic>
+#include <mutex>
+#include <memory>
+
 #include "gambit/Elements/gambit_module_headers.hpp"
 #include "gambit/DarkBit/DarkBit_rollcall.hpp"
 
@@ -54,6 +58,25 @@ namespace Gambit
       #endif
     }
 
+    /// Function setting the number of consecutive events generated by each thread
+    /// of the cascade MC event loop.  Used by cascadeMC_LoopManager to hand out the
+    /// events, and by cascadeMC_Histograms to check convergence only at the ends
+    /// of blocks.
+    void cascadeMC_EventBlockSize(int &size)
+    {
+      using namespace Pipes::cascadeMC_EventBlockSize;
+      /// Option cMC_eventBlockSize<int>: Number of consecutive events generated by
+      /// a thread before it checks whether the loop is finished (default 1).  The
+      /// convergence checks of cascadeMC_Histograms are aligned with the ends of the
+      /// blocks, so their spacing is rounded up to a multiple of this number.
+      size = runOptions->getValueOrDef<int>(1, "cMC_eventBlockSize");
+      if (size < 1)
+      {
+        DarkBit_error().raise(LOCAL_INFO,
+            "cMC_eventBlockSize must be a positive integer.");
+      }
+    }
+
     /// Function setting up the decay table used in decay chains
     void cascadeMC_DecayTable(DarkBit::DecayChain::DecayTable &table)
     {
@@ -85,7 +108,7 @@ namespace Gambit
       // Get YAML options
       /// Option cMC_maxEvents<int>: Maximum number of cascade MC runs (default 20000)
       int cMC_maxEvents = runOptions->getValueOrDef<int>(20000, "cMC_maxEvents");
-
+      const int cMC_eventBlockSize = *Dep::cascadeMC_EventBlockSize;
 
       // Initialization run
       Loop::executeIteration(MC_INIT);
@@ -100,30 +123,30 @@ namespace Gambit
       for(std::vector<std::string>::const_iterator
           cit =chainList.begin(); cit != chainList.end(); cit++)
       {
-        int it;
-        int counter = 0;
-        bool finished = false;
+        std::atomic<int> counter(0);
+        std::atomic<bool> finished(false);
         // Set next initial state
         Loop::executeIteration(MC_NEXT_STATE);
         // Event generation loop
-        #pragma omp parallel private(it) shared(counter, finished)
+        #pragma omp parallel shared(counter, finished)
         {
           while (!finished)
           {
-            #pragma omp critical (cascadeMC_Counter)
-            {
-              counter++;
-              it = counter;
-            }
-            Loop::executeIteration(it);
-            #pragma omp critical (cascadeMC_Counter)
+            // Reserve the next block of events
+            int first = counter.fetch_add(cMC_eventBlockSize) + 1;
+            int last = std::min(first + cMC_eventBlockSize - 1, cMC_maxEvents);
+            for (int it = first; it <= last; it++)
+              Loop::executeIteration(it);
+            int count = std::min<int>(counter, cMC_maxEvents);
+            if((*Loop::done and ((count >= cMC_minEvents) or piped_errors.inquire()))
+              or (count >= cMC_maxEvents))
+                finished=true;
+            // Only warn from the thread that generated the last allowed event
+            if (last == cMC_maxEvents and first <= last)
             {
-              if((*Loop::done and ((counter >= cMC_minEvents) or piped_errors.inquire()))
-                or (counter >= cMC_maxEvents))
-                  finished=true;
-              if (counter >= cMC_maxEvents)
-                DarkBit_warning().raise(LOCAL_INFO,
-                    "WARNING FCMC: cMC_maxEvents reached without convergence.");
+              #pragma omp critical (cascadeMC_Counter)
+              DarkBit_warning().raise(LOCAL_INFO,
+                  "WARNING FCMC: cMC_maxEvents reached without convergence.");
             }
           }
         }
@@ -236,8 +259,7 @@ namespace Gambit
         const DarkBit::DecayChain::ChainParticle* endpoint,
         std::string finalState,
         const TH_ProcessCatalog &catalog,
-        std::map<std::string, std::map<std::string, SimpleHist> > &histList,
-        std::string initialState,
+        SimpleHist &hist,
         double weight, int cMC_numSpecSamples
         )
     {
@@ -288,7 +310,7 @@ namespace Gambit
       const double msq = m*m;
       // Get histogram edges
       double histEmin, histEmax;
-      histList[initialState][finalState].getEdges(histEmin, histEmax);
+      hist.getEdges(histEmin, histEmax);
 
       // Calculate energies to sample between.  A particle decaying
       // isotropically in its rest frame will give a box spectrum.  This is
@@ -315,7 +337,6 @@ namespace Gambit
         std::cout << "p_lab = " << endpoint->p_Lab() << std::endl;
         std::cout << "Lorentz factors gamma, beta: " << gamma << ", "
           << beta << std::endl;
-        std::cout << "Initial state: " << initialState << std::endl;
         std::cout << "Channel: " << p1 << " " << p2 << std::endl;
         std::cout << "Final particles: " << finalState << std::endl;
         std::cout << "Event weight: "    << weight << std::endl;
@@ -329,7 +350,7 @@ namespace Gambit
 
       double specSum=0;
       int Nsampl=0;
-      SimpleHist spectrum(histList[initialState][finalState].binLower);
+      SimpleHist spectrum(hist.binLower);
       while(Nsampl<cMC_numSpecSamples)
       {
         // Draw an energy in the CoM frame of the endpoint. Logarithmic
@@ -354,8 +375,7 @@ namespace Gambit
         spectrum.multiply(1.0/Nsampl);
         // Add bin contents of spectrum histogram to main histogram as weighted
         // events
-        #pragma omp critical (cascadeMC_histList)
-          histList[initialState][finalState].addHistAsWeights_sameBin(spectrum);
+        hist.addHistAsWeights_sameBin(spectrum);
       }
     }
 
@@ -372,10 +392,41 @@ namespace Gambit
       static double cMC_gammaBGPower;
       static double cMC_gammaRelError;
       static int    cMC_NhistBins;
+      // Convergence criterion for a single final state: the relative error in
+      // the bin with the highest expected signal-to-background must not exceed
+      // relError, assuming a power-law background with slope bgPower.
+      struct EndCondition
+      {
+        size_t finalIndex;
+        double relError;
+        double bgPower;
+      };
+      static std::vector<EndCondition> endConditions;
       static double cMC_binLow;
       static double cMC_binHigh;
-      // Histogram list shared between all threads
-      static std::map<std::string, std::map<std::string, SimpleHist> > histList;
+      // Histograms are accumulated separately by each thread, and only merged
+      // at MC_FINALIZE.  Channels are identified by the integer ID
+      // (initial state index)*(number of final states) + (final state index).
+      static std::vector<std::vector<SimpleHist> > threadHists;
+      // Locks for the per-thread histograms; these are only ever contended
+      // by the convergence checks.
+      static std::unique_ptr<std::mutex[]> threadLocks;
+      // Initial states simulated so far (index is the initial state index)
+      static std::vector<std::string> initialStates;
+      const size_t nFinal = Dep::cascadeMC_FinalStates->size();
+
+      // Merge the histograms of all threads for the given channel
+      auto mergedHist = [&](size_t channel)
+      {
+        SimpleHist hist;
+        for(size_t t=0; t<threadHists.size(); t++)
+        {
+          std::lock_guard<std::mutex> lock(threadLocks[t]);
+          if(t==0) hist = threadHists[t][channel];
+          else hist.addHist_sameBin(threadHists[t][channel]);
+        }
+        return hist;
+      };
 
       switch(*Loop::iteration)
       {
@@ -385,9 +436,18 @@ namespace Gambit
           /// spectra (default 10)
           cMC_numSpecSamples = runOptions->getValueOrDef<int>   (25, "cMC_numSpecSamples");
           /// Option cMC_endCheckFrequency: number of events to wait between successive
-          /// checks of the convergence criteria (default 25)
+          /// checks of the convergence criteria (default 25; rounded up to a multiple
+          /// of cMC_eventBlockSize of cascadeMC_EventBlockSize)
           cMC_endCheckFrequency  =
             runOptions->getValueOrDef<int>   (25,     "cMC_endCheckFrequency");
+          if (cMC_endCheckFrequency < 1)
+          {
+            DarkBit_error().raise(LOCAL_INFO,
+                "cMC_endCheckFrequency must be a positive integer.");
+          }
+          // Blocks of events end at multiples of the block size, so only check there
+          cMC_endCheckFrequency = *Dep::cascadeMC_EventBlockSize *
+            ((cMC_endCheckFrequency + *Dep::cascadeMC_EventBlockSize - 1) / *Dep::cascadeMC_EventBlockSize);
           /// Option cMC_gammaBGPower: power-law slope to assume for astrophysical
           /// background (default -2.5)
           cMC_gammaBGPower       =
@@ -397,6 +457,51 @@ namespace Gambit
           cMC_gammaRelError      =
             runOptions->getValueOrDef<double>(0.20,   "cMC_gammaRelError");
 
+          /// Option cMC_endConditions: convergence criteria per final state, as
+          /// e.g. {gamma: {relError: 0.2, bgPower: -2.5}, e+: {relError: 0.3}}
+          /// (default: gamma only, with cMC_gammaRelError and cMC_gammaBGPower).
+          /// Missing entries default to relError 0.20 and bgPower -2.5.
+          endConditions.clear();
+          if (runOptions->hasKey("cMC_endConditions"))
+          {
+            YAML::Node conditions = runOptions->getNode("cMC_endConditions");
+            for (YAML::const_iterator it = conditions.begin();
+                it != conditions.end(); ++it)
+            {
+              std::string finalState = it->first.as<std::string>();
+              std::vector<std::string>::const_iterator pos = std::find(
+                  Dep::cascadeMC_FinalStates->begin(),
+                  Dep::cascadeMC_FinalStates->end(), finalState);
+              if (pos == Dep::cascadeMC_FinalStates->end())
+              {
+                std::ostringstream msg;
+                msg << "cMC_endConditions given for final state " << finalState
+                  << ", which is not in cascadeMC_FinalStates.";
+                DarkBit_error().raise(LOCAL_INFO, msg.str());
+              }
+              Options condition(it->second);
+              EndCondition c;
+              c.finalIndex = pos - Dep::cascadeMC_FinalStates->begin();
+              c.relError = condition.getValueOrDef<double>(0.20, "relError");
+              c.bgPower  = condition.getValueOrDef<double>(-2.5, "bgPower");
+              endConditions.push_back(c);
+            }
+          }
+          else
+          {
+            std::vector<std::string>::const_iterator pos = std::find(
+                Dep::cascadeMC_FinalStates->begin(),
+                Dep::cascadeMC_FinalStates->end(), "gamma");
+            if (pos != Dep::cascadeMC_FinalStates->end())
+            {
+              EndCondition c;
+              c.finalIndex = pos - Dep::cascadeMC_FinalStates->begin();
+              c.relError = cMC_gammaRelError;
+              c.bgPower  = cMC_gammaBGPower;
+              endConditions.push_back(c);
+            }
+          }
+
           // Note: use same binning for all particle species
           /// Option cMC_NhistBins<int>: Number of histogram bins (default 140)
           cMC_NhistBins = runOptions->getValueOrDef<int>   (140,     "cMC_NhistBins");
@@ -404,10 +509,13 @@ namespace Gambit
           cMC_binLow = runOptions->getValueOrDef<double>(0.001,  "cMC_binLow");
           /// Option cMC_binHigh<double>: Histogram max energy in GeV (default 10000)
           cMC_binHigh = runOptions->getValueOrDef<double>(10000.0,"cMC_binHigh");
-          histList.clear();
+          threadHists.assign(omp_get_max_threads(), std::vector<SimpleHist>());
+          threadLocks.reset(new std::mutex[threadHists.size()]);
+          initialStates.clear();
           return;
         case MC_NEXT_STATE:
           // Initialize histograms
+          initialStates.push_back(*Dep::cascadeMC_InitialState);
           for(std::vector<std::string>::const_iterator it =
               Dep::cascadeMC_FinalStates->begin();
               it!=Dep::cascadeMC_FinalStates->end(); ++it)
@@ -417,16 +525,37 @@ namespace Gambit
             std::cout << "for: " << *Dep::cascadeMC_InitialState
               << " " << *it << std::endl;
 #endif
-            histList[*Dep::cascadeMC_InitialState][*it]=
-              SimpleHist(cMC_NhistBins,cMC_binLow,cMC_binHigh,true);
+            SimpleHist hist(cMC_NhistBins,cMC_binLow,cMC_binHigh,true);
+            for(size_t t=0; t<threadHists.size(); t++)
+              threadHists[t].push_back(hist);
           }
           return;
         case MC_FINALIZE:
           // For performance, only return the actual result once finished
-          result = histList;
+          result.clear();
+          for(size_t i=0; i<initialStates.size(); i++)
+          {
+            for(size_t j=0; j<nFinal; j++)
+            {
+              result[initialStates[i]][(*Dep::cascadeMC_FinalStates)[j]] =
+                mergedHist(i*nFinal+j);
+            }
+          }
           return;
       }
 
+      // Histograms of the current initial state filled by this thread
+      const size_t thread = omp_get_thread_num();
+      if(thread >= threadHists.size())
+      {
+        DarkBit_error().raise(LOCAL_INFO,
+            "cascadeMC_Histograms called from more threads than were "
+            "available at MC_INIT.");
+      }
+      const size_t stateIndex = initialStates.size()-1;
+      std::unique_lock<std::mutex> lock(threadLocks[thread]);
+      SimpleHist* hists = &threadHists[thread][stateIndex*nFinal];
+
       // Get list of endpoint states for this chain
       vector<const ChainParticle*> endpoints;
       (*Dep::cascadeMC_ChainEvent).chain->
@@ -436,6 +565,7 @@ namespace Gambit
           Dep::cascadeMC_FinalStates->begin();
           pit!=Dep::cascadeMC_FinalStates->end(); ++pit)
       {
+        SimpleHist &hist = hists[pit-Dep::cascadeMC_FinalStates->begin()];
         // Iterate over all endpoint states of the decay chain. These can
         // either be final state particles themselves or parents of final state
         // particles.  The reason for not using only final state particles is
@@ -462,8 +592,7 @@ namespace Gambit
             if((*it)->getpID()==*pit)
             {
               double E = (*it)->E_Lab();
-#pragma omp critical (cascadeMC_histList)
-              histList[*Dep::cascadeMC_InitialState][*pit].addEvent(E,weight);
+              hist.addEvent(E,weight);
               ignored = false;
             }
             // Check if tabulated spectra exist for this final state
@@ -471,8 +600,7 @@ namespace Gambit
             {
               cascadeMC_sampleSimYield(
                   *Dep::SimYieldTable, *it, *pit, *Dep::TH_ProcessCatalog,
-                  histList, *Dep::cascadeMC_InitialState, weight,
-                  cMC_numSpecSamples
+                  hist, weight, cMC_numSpecSamples
                   );
               // Check if an error was raised
               ignored = false;
@@ -502,8 +630,7 @@ namespace Gambit
               {
                 hasTabulated = true;
                 cascadeMC_sampleSimYield(*Dep::SimYieldTable, *it, *pit,
-                    *Dep::TH_ProcessCatalog, histList,
-                    *Dep::cascadeMC_InitialState, weight,
+                    *Dep::TH_ProcessCatalog, hist, weight,
                     cMC_numSpecSamples
                     );
                 // Check if an error was raised
@@ -525,9 +652,7 @@ namespace Gambit
                 if(child->getpID()==*pit)
                 {
                   double E = child->E_Lab();
-#pragma omp critical (cascadeMC_histList)
-                  histList[
-                    *Dep::cascadeMC_InitialState][*pit].addEvent(E,weight);
+                  hist.addEvent(E,weight);
                   ignored = false;
                 }
                 // Check if tabulated spectra exist for this final state
@@ -535,8 +660,7 @@ namespace Gambit
                       *pit))
                 {
                   cascadeMC_sampleSimYield(*Dep::SimYieldTable, child, *pit,
-                      *Dep::TH_ProcessCatalog, histList,
-                      *Dep::cascadeMC_InitialState, weight,
+                      *Dep::TH_ProcessCatalog, hist, weight,
                       cMC_numSpecSamples
                       );
                   // Check if an error was raised
@@ -558,53 +682,49 @@ namespace Gambit
           }
         }
       }
+      lock.unlock();
+
       // Check if finished every cMC_endCheckFrequency events
       if((*Loop::iteration % cMC_endCheckFrequency) == 0)
       {
         enum status{untouched,unfinished,finished};
         status cond = untouched;
-        for(std::vector<std::string>::const_iterator it =
-            Dep::cascadeMC_FinalStates->begin();
-            it != Dep::cascadeMC_FinalStates->end(); ++it)
+        for(std::vector<EndCondition>::const_iterator it =
+            endConditions.begin(); it != endConditions.end(); ++it)
         {
-          // End conditions currently only implemented for gamma final state
-          if(*it=="gamma")
-          {
-            SimpleHist hist;
-#pragma omp critical (cascadeMC_histList)
-            hist = histList[*Dep::cascadeMC_InitialState][*it];
+          SimpleHist hist = mergedHist(stateIndex*nFinal + it->finalIndex);
 #ifdef DARKBIT_DEBUG
-            std::cout << "Checking whether convergence is reached" << std::endl;
-            for ( int i = 0; i < hist.nBins; i++ )
-              std::cout << "Estimated error at " << hist.binCenter(i) << " GeV : " << hist.getRelError(i) << std::endl;
+          std::cout << "Checking whether convergence is reached for "
+            << (*Dep::cascadeMC_FinalStates)[it->finalIndex] << std::endl;
+          for ( int i = 0; i < hist.nBins; i++ )
+            std::cout << "Estimated error at " << hist.binCenter(i) << " GeV : " << hist.getRelError(i) << std::endl;
 #endif
-            double sbRatioMax=-1.0;
-            int maxBin=0;
-            for(int i=0; i<hist.nBins; i++)
+          double sbRatioMax=-1.0;
+          int maxBin=0;
+          for(int i=0; i<hist.nBins; i++)
+          {
+            double E = hist.binCenter(i);
+            double background = pow(E,it->bgPower);
+            double sbRatio = hist.binVals[i]/background;
+            if(sbRatio>sbRatioMax)
             {
-              double E = hist.binCenter(i);
-              double background = pow(E,cMC_gammaBGPower);
-              double sbRatio = hist.binVals[i]/background;
-              if(sbRatio>sbRatioMax)
-              {
-                sbRatioMax = sbRatio;
-                maxBin=i;
-              }
+              sbRatioMax = sbRatio;
+              maxBin=i;
             }
+          }
 #ifdef DARKBIT_DEBUG
-            std::cout << "Estimated maxBin: " << maxBin << std::endl;
-            std::cout << "Energy at maxBin: " << hist.binCenter(maxBin) << std::endl;
-            std::cout << "Estimated error at maxBin: " << hist.getRelError(maxBin) << std::endl;
-            std::cout << "Value at maxBin: " << hist.getBinValues()[maxBin];
+          std::cout << "Estimated maxBin: " << maxBin << std::endl;
+          std::cout << "Energy at maxBin: " << hist.binCenter(maxBin) << std::endl;
+          std::cout << "Estimated error at maxBin: " << hist.getRelError(maxBin) << std::endl;
+          std::cout << "Value at maxBin: " << hist.getBinValues()[maxBin];
 #endif
-            // Check if end condition is fulfilled. If not, set cond to
-            // unfinished.
-            if(hist.getRelError(maxBin) > cMC_gammaRelError) cond = unfinished;
+          // Check if end condition is fulfilled. If not, set cond to
+          // unfinished.
+          if(hist.getRelError(maxBin) > it->relError) cond = unfinished;
 
-            // If end condition is fulfilled, set cond to finished, unless
-            // already set to unfinished by another condition.
-            else if(cond != unfinished) cond = finished;
-          }
+          // If end condition is fulfilled, set cond to finished, unless
+          // already set to unfinished by another condition.
+          else if(cond != unfinished) cond = finished;
         }
         // Break Monte Carlo loop if all end conditions are fulfilled.
         if(cond==finished)
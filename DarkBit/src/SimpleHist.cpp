@@ -160,6 +160,21 @@ namespace Gambit {
       }
     }
 
+    void SimpleHist::addHist_sameBin(const SimpleHist &in)
+    {
+      if(in.nBins != nBins)
+      {
+        DarkBit_error().raise(LOCAL_INFO,
+            "SimpleHist::addHist_sameBin requires identically binned\n"
+            "histograms.");
+      }
+      for(int i=0; i<nBins;i++)
+      {
+        binVals[i] += in.binVals[i];
+        wtSq[i]    += in.wtSq[i];
+      }
+    }
+
     double SimpleHist::getError(int bin) const
     {
       return sqrt(wtSq[bin]);
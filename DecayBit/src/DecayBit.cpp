@@ -2167,8 +2167,10 @@ namespace Gambit
       const Spectrum& spec = *Dep::SingletDM_spectrum;
       const SubSpectrum& he = spec.get_HE();
       double mass = spec.get(Par::Pole_Mass,"S");
-      double lambda = he.get(Par::dimensionless,"lambda_hS");
-      double v0 = he.get(Par::mass1,"vev");
+      static const SpecParHandle lambda_hS(Par::dimensionless,"lambda_hS");
+      static const SpecParHandle vev(Par::mass1,"vev");
+      double lambda = lambda_hS.get(he);
+      double v0 = vev.get(he);
       double mhpole = spec.get(Par::Pole_Mass,"h0_1");
 
       // Get the reference SM Higgs decays
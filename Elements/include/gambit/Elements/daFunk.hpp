@@ -320,6 +320,21 @@ namespace daFunk
             // Return value & standard resolve
             virtual double value(const std::vector<double> &, size_t bindID) = 0;
 
+            // Vectorised evaluation at n points, with results appended to
+            // result.  Entry j of the workspace data takes the values coll[j]
+            // (vectors of length one are used for all points).  By default
+            // this calls value() point by point; derived classes can override
+            // it to evaluate all points in one pass.
+            virtual void vvalue(std::vector<double> & result, const std::vector<std::vector<double>> & coll, std::vector<double> & data, size_t n, size_t bindID)
+            {
+                for ( size_t i = 0; i != n; ++i )
+                {
+                    for ( size_t j = 0; j != coll.size(); ++j )
+                        data[j] = coll[j].size() == 1 ? coll[j][0] : coll[j][i];
+                    result.push_back(this->value(data, bindID));
+                }
+            }
+
             // datamap maps the required function arguments onto the specific
             // entries in the double-valued data array generated by eval().
             // datalen acts like a pointer on the last entry of that array, and
@@ -445,15 +460,9 @@ namespace daFunk
             template <typename... Args> inline std::vector<double> vect2(std::vector<std::vector<double>> & coll)
             {
                 size_t size = 1;
-                std::vector<bool> vec_flag;
                 for ( auto it = coll.begin(); it != coll.end(); ++it )
                 {
-                    if ( it->size() == 1 )
-                    {
-                        vec_flag.push_back(false);
-                        continue;
-                    }
-                    vec_flag.push_back(true);
+                    if ( it->size() == 1 ) continue;
                     if ( size == 1 ) size = it->size();
                     if ( size != it->size() )
                     {
@@ -464,17 +473,8 @@ namespace daFunk
                 auto r = vec<double>();
                 auto data = vec<double>();
                 data.resize(datalen);
-                for ( size_t i = 0; i != size; ++i )
-                {
-                    for ( size_t j = 0; j != coll.size(); ++j )
-                    {
-                        if ( vec_flag[j] )
-                            data[j] = coll[j][i];
-                        else
-                            data[j] = coll[j][0];
-                    }
-                    r.push_back(f->value(data, bindID));
-                }
+                r.reserve(size);
+                f->vvalue(r, coll, data, size, bindID);
                 return r;
             }
 
@@ -594,6 +594,14 @@ namespace daFunk
                 return c;
             }
 
+            void vvalue(std::vector<double> & result, const std::vector<std::vector<double>> & coll, std::vector<double> & data, size_t n, size_t bindID)
+            {
+                (void)coll;
+                (void)data;
+                (void)bindID;
+                result.insert(result.end(), n, c);
+            }
+
         private:
             double c;
     };
@@ -915,6 +923,17 @@ namespace daFunk
             {
                 return data[indices[bindID][0]];
             }
+
+            void vvalue(std::vector<double> & result, const std::vector<std::vector<double>> & coll, std::vector<double> & data, size_t n, size_t bindID)
+            {
+                size_t j = indices[bindID][0];
+                if ( j >= coll.size() )  // Not a bound argument; use workspace
+                    return FunkBase::vvalue(result, coll, data, n, bindID);
+                if ( coll[j].size() == 1 )
+                    result.insert(result.end(), n, coll[j][0]);
+                else
+                    result.insert(result.end(), coll[j].begin(), coll[j].begin() + n);
+            }
     };
     inline Funk var(std::string arg) { return Funk(new FunkVar(arg)); }
 
@@ -1215,6 +1234,15 @@ namespace daFunk
             {                                                                                             \
                 return functions[0]->value(data, bindID) SYMBOL functions[1]->value(data, bindID);        \
             }                                                                                             \
+            void vvalue(std::vector<double> & result, const std::vector<std::vector<double>> & coll,      \
+                    std::vector<double> & data, size_t n, size_t bindID)                                  \
+            {                                                                                             \
+                std::vector<double> r0, r1;                                                               \
+                r0.reserve(n); r1.reserve(n);                                                             \
+                functions[0]->vvalue(r0, coll, data, n, bindID);                                          \
+                functions[1]->vvalue(r1, coll, data, n, bindID);                                          \
+                for ( size_t i = 0; i != n; ++i ) result.push_back(r0[i] SYMBOL r1[i]);                   \
+            }                                                                                             \
     };                                                                                                    \
     inline Funk operator SYMBOL (Funk f1, Funk f2) { return Funk(new FunkMath_##OPERATION(f1, f2)); }     \
     inline Funk operator SYMBOL (double x, Funk f) { return Funk(new FunkMath_##OPERATION(x, f)); }       \
@@ -1297,7 +1325,25 @@ namespace daFunk
             double value(const std::vector<double> & data, size_t bindID)
             {
                 functions[0]->value(data, bindID);
-                return (this->*ptr)(data[indices[bindID][0]]);
+                size_t i = 0;
+                return (this->*ptr)(data[indices[bindID][0]], i);
+            }
+
+            // One pass over all points.  Each bin search starts from the bin
+            // of the previous point, so sorted input is handled in O(1) per
+            // point.
+            void vvalue(std::vector<double> & result, const std::vector<std::vector<double>> & coll, std::vector<double> & data, size_t n, size_t bindID)
+            {
+                size_t j = indices[bindID][0];
+                if ( j >= coll.size() or dynamic_cast<FunkVar*>(functions[0].get()) == NULL )
+                    return FunkBase::vvalue(result, coll, data, n, bindID);
+                const std::vector<double> & x = coll[j];
+                size_t i = 0;
+                for ( size_t k = 0; k != n; ++k )
+                {
+                    double xk = x.size() == 1 ? x[0] : x[k];
+                    result.push_back((this->*ptr)(xk, i));
+                }
             }
 
         private:
@@ -1309,40 +1355,106 @@ namespace daFunk
                 arguments = f->getArgs();
                 this->Xgrid = Xgrid;
                 this->Ygrid = Ygrid;
+                this->mode = mode;
                 if ( mode == "lin" ) this->ptr = &FunkInterp::linearInterp;
                 else if ( mode == "log" ) this->ptr = &FunkInterp::logInterp;
+
+                // Slopes of all bins (in log-log space for log interpolation)
+                slopes.resize(Xgrid.size() > 1 ? Xgrid.size() - 1 : 0);
+                for ( size_t i = 0; i < slopes.size(); ++i )
+                {
+                    double x0 = Xgrid[i];
+                    double x1 = Xgrid[i+1];
+                    double y0 = Ygrid[i];
+                    double y1 = Ygrid[i+1];
+                    if ( mode == "log" )
+                        slopes[i] = std::log(y1/y0) / std::log(x1/x0);
+                    else
+                        slopes[i] = (y1-y0)/(x1-x0);
+                }
+
+                // Grids that are uniform in x (or log x) allow to compute the bin directly
+                uniform = uniform_none;
+                if ( Xgrid.size() > 2 )
+                {
+                    if ( is_uniform(Xgrid) ) uniform = uniform_lin;
+                    else if ( Xgrid[0] > 0 )
+                    {
+                        std::vector<double> logX(Xgrid.size());
+                        for ( size_t i = 0; i < Xgrid.size(); ++i ) logX[i] = std::log(Xgrid[i]);
+                        if ( is_uniform(logX) ) uniform = uniform_log;
+                    }
+                    if ( uniform == uniform_lin )
+                    {
+                        offset = Xgrid[0];
+                        invstep = (Xgrid.size() - 1) / (Xgrid.back() - Xgrid[0]);
+                    }
+                    if ( uniform == uniform_log )
+                    {
+                        offset = std::log(Xgrid[0]);
+                        invstep = (Xgrid.size() - 1) / (std::log(Xgrid.back()) - offset);
+                    }
+                }
+            }
+
+            static bool is_uniform(const std::vector<double> & X)
+            {
+                double step = (X.back() - X[0]) / (X.size() - 1);
+                if ( not (step > 0) ) return false;
+                for ( size_t i = 1; i < X.size(); ++i )
+                    if ( std::abs(X[i] - X[0] - i*step) > 1e-6*step ) return false;
+                return true;
+            }
+
+            // Returns index i of the bin [Xgrid[i], Xgrid[i+1]) containing x
+            // (the last bin also contains Xgrid.back()).  hint is a first
+            // guess, e.g. the bin of a previous nearby point.
+            size_t bin(double x, size_t hint) const
+            {
+                size_t imax = Xgrid.size() - 1;
+                size_t i = hint;
+                if ( i >= imax or x < Xgrid[i] or (x >= Xgrid[i+1] and i+1 < imax) )
+                {
+                    // Try the next bin (sorted input), then compute or search the bin
+                    if ( i+1 < imax and x >= Xgrid[i+1] and x < Xgrid[i+2] ) return i+1;
+                    if ( uniform == uniform_none )
+                    {
+                        i = std::upper_bound(Xgrid.begin(), Xgrid.end(), x) - Xgrid.begin();
+                        return std::min(i, imax) - 1;
+                    }
+                    double u = ( uniform == uniform_lin ? x : std::log(x) ) - offset;
+                    i = std::min(static_cast<size_t>(std::max(u*invstep, 0.)), imax - 1);
+                    // Correct for rounding
+                    while ( i+1 < imax and x >= Xgrid[i+1] ) ++i;
+                    while ( i > 0 and x < Xgrid[i] ) --i;
+                }
+                return i;
             }
 
-            double logInterp(double x)
+            // The bin of x is returned in i (which also provides the initial guess)
+            double logInterp(double x, size_t & i)
             {
                 // Linear interpolation in log-log space
-                int i = 0; int imax = Xgrid.size() - 1;
-                if (x<Xgrid[0] or x>Xgrid[imax]) return 0;
-                for (; i < imax; i++) {if (Xgrid[i] > x) break;};
-                double x0 = Xgrid[i-1];
-                double x1 = Xgrid[i];
-                double y0 = Ygrid[i-1];
-                double y1 = Ygrid[i];
-                return y0 * std::exp(std::log(y1/y0) * std::log(x/x0) / std::log(x1/x0));
+                if (x<Xgrid[0] or x>Xgrid.back()) return 0;
+                i = bin(x, i);
+                return Ygrid[i] * std::exp(slopes[i] * std::log(x/Xgrid[i]));
             }
 
-            double linearInterp(double x)
+            double linearInterp(double x, size_t & i)
             {
                 // Linear interpolation in lin-lin space
-                int i = 0; int imax = Xgrid.size() - 1;
-                if (x<Xgrid[0] or x>Xgrid[imax]) return 0;
-                for (; i < imax; i++) {if (Xgrid[i] > x) break;};
-                double x0 = Xgrid[i-1];
-                double x1 = Xgrid[i];
-                double y0 = Ygrid[i-1];
-                double y1 = Ygrid[i];
-                return y0 + (x-x0)/(x1-x0)*(y1-y0);
+                if (x<Xgrid[0] or x>Xgrid.back()) return 0;
+                i = bin(x, i);
+                return Ygrid[i] + (x-Xgrid[i])*slopes[i];
             }
 
-            double(FunkInterp::*ptr)(double);
+            double(FunkInterp::*ptr)(double, size_t &);
             std::vector<double> Xgrid;
             std::vector<double> Ygrid;
+            std::vector<double> slopes;
             std::string mode;
+            enum { uniform_none, uniform_lin, uniform_log } uniform;
+            double offset, invstep;
     };
     template <typename T> inline shared_ptr<FunkInterp> interp(T f, std::vector<double> x, std::vector<double> y) { return shared_ptr<FunkInterp>(new FunkInterp(f, x, y)); }
 
@@ -125,6 +125,9 @@ namespace Gambit
           }
           /// @}
 
+          /// Retrieve the BF and error for a final state, raising an error if the channel is absent
+          const std::pair<double, double>& channel_at(const std::multiset< std::pair<int,int> >&) const;
+
         public:
 
           /// Default constructor
@@ -200,33 +203,25 @@ namespace Gambit
           /// @}
 
           /// Retrieve branching fraction for decay to a given final state.
-          /// Five ways to specify final states: 
+          /// Six ways to specify final states: 
           ///  1. PDG-context integer pairs (vector)
           ///  2. full particle names (vector)
           ///  3. PDG-context integer pairs (arguments)
           ///  4. full particle names (arguments)
           ///  5. short particle names + index integers (arguments)
+          ///  6. PDG-context integer pairs (channel key, as used in channels; for keys made once and reused)
           /// Supports arbitrarily many final state particles.
           /// @{
           double BF(const std::vector<std::pair<int, int> >&) const;
           double BF(const std::vector<str>&) const;
+          double BF(const std::multiset< std::pair<int,int> >& key) const { return channel_at(key).first; }
 
           template <typename... Args>
           double BF(std::pair<int,int> p1, Args... args) const
           {
             std::pair<int,int> particles[] = {p1, args...};
             std::multiset< std::pair<int,int> > key(particles, particles+sizeof...(Args)+1);
-            if (channels.find(key) == channels.end())
-            {
-              std::ostringstream err;
-              err << "No branching fraction exists for the requested final states:";
-              for (auto particle = key.begin(); particle != key.end(); ++particle)
-              {
-                err << " {" << particle->first << ", " << particle->second << "}"; 
-              }
-              model_error().raise(LOCAL_INFO,err.str());
-            }
-            return channels.at(key).first;
+            return channel_at(key).first;
           }
 
           template <typename... Args>
@@ -234,17 +229,7 @@ namespace Gambit
           {
             std::multiset< std::pair<int,int> > key;
             construct_key(key, p1, args...);
-            if (channels.find(key) == channels.end())
-            {
-              std::ostringstream err;
-              err << "No branching fraction exists for the requested final states:";
-              for (auto particle = key.begin(); particle != key.end(); ++particle)
-              {
-                err << " {" << particle->first << ", " << particle->second << "}"; 
-              }
-              model_error().raise(LOCAL_INFO,err.str());
-            }
-            return channels.at(key).first;
+            return channel_at(key).first;
           }
           /// @}
 
@@ -257,17 +242,7 @@ namespace Gambit
           {
             std::pair<int,int> particles[] = {p1, args...};
             std::multiset< std::pair<int,int> > key(particles, particles+sizeof...(Args)+1);
-            if (channels.find(key) == channels.end())
-            {
-              std::ostringstream err;
-              err << "No branching fraction exists for the requested final states:";
-              for (auto particle = key.begin(); particle != key.end(); ++particle)
-              {
-                err << " {" << particle->first << ", " << particle->second << "}"; 
-              }
-              model_error().raise(LOCAL_INFO,err.str());
-            }
-            return channels.at(key).second;
+            return channel_at(key).second;
           }
 
           template <typename... Args>
@@ -275,17 +250,7 @@ namespace Gambit
           {
             std::multiset< std::pair<int,int> > key;
             construct_key(key, p1, args...);
-            if (channels.find(key) == channels.end())
-            {
-              std::ostringstream err;
-              err << "No branching fraction exists for the requested final states:";
-              for (auto particle = key.begin(); particle != key.end(); ++particle)
-              {
-                err << " {" << particle->first << ", " << particle->second << "}"; 
-              }
-              model_error().raise(LOCAL_INFO,err.str());
-            }
-            return channels.at(key).second;
+            return channel_at(key).second;
           }
           /// @}
 
@@ -298,17 +263,7 @@ namespace Gambit
           {
             std::pair<int,int> particles[] = {p1, args...};
             std::multiset< std::pair<int,int> > key(particles, particles+sizeof...(Args)+1);
-            if (channels.find(key) == channels.end())
-            {
-              std::ostringstream err;
-              err << "No branching fraction exists for the requested final states:";
-              for (auto particle = key.begin(); particle != key.end(); ++particle)
-              {
-                err << " {" << particle->first << ", " << particle->second << "}"; 
-              }
-              model_error().raise(LOCAL_INFO,err.str());
-            }
-            return channels.at(key);
+            return channel_at(key);
           }
 
           template <typename... Args>
@@ -316,17 +271,7 @@ namespace Gambit
           {
             std::multiset< std::pair<int,int> > key;
             construct_key(key, p1, args...);
-            if (channels.find(key) == channels.end())
-            {
-              std::ostringstream err;
-              err << "No branching fraction exists for the requested final states:";
-              for (auto particle = key.begin(); particle != key.end(); ++particle)
-              {
-                err << " {" << particle->first << ", " << particle->second << "}"; 
-              }
-              model_error().raise(LOCAL_INFO,err.str());
-            }
-            return channels.at(key);
+            return channel_at(key);
           }
           /// @}
 
@@ -47,7 +47,6 @@
 #endif
 
 #include <boost/preprocessor/seq/for_each.hpp>
-#include <boost/io/ios_state.hpp>
 
 namespace Gambit
 {
@@ -97,8 +96,8 @@ namespace Gambit
         for (auto it = missing_backends.begin(); it != missing_backends.end(); ++it) ss << endl << "  " << *it;
         backend_error().raise(LOCAL_INFO, ss.str());
       }
-      boost::io::ios_flags_saver ifs(cout);        // Don't allow module functions to change the output precision of cout
-      int thread_num = omp_get_thread_num();
+      FunctorHelp::cout_flags_saver ifs;           // Don't allow module functions to change the output precision of cout
+      int thread_num = (iRunNested ? omp_get_thread_num() : 0); // Functors outside loops keep a single result, even if run concurrently with others
       init_memory();                               // Init memory if this is the first run through.
       if (needs_recalculating[thread_num])         // Do the actual calculation if required.
       {
@@ -39,14 +39,17 @@
 
 #include <map>
 #include <set>
+#include <atomic>
 #include <vector>
 #include <chrono>
 #include <sstream>
+#include <iostream>
 #include <algorithm>
 #include <omp.h>
 
 #include "gambit/Utils/util_types.hpp"
 #include "gambit/Utils/util_functions.hpp"
+#include "gambit/Utils/latency_histogram.hpp"
 #include "gambit/Utils/yaml_options.hpp"
 #include "gambit/Utils/model_parameters.hpp"
 #include "gambit/Logs/logger.hpp"
@@ -79,6 +82,18 @@ namespace Gambit
     // bool emergency_shutdown_begun();
     void entering_multithreaded_region(module_functor_common&);
     void leaving_multithreaded_region(module_functor_common&);
+
+    /// Saves the format flags of cout and restores them on destruction, but only outside OpenMP parallel
+    /// regions.  Inside a region cout is shared between threads, so its flags are left to whoever opened it.
+    class cout_flags_saver
+    {
+      public:
+        cout_flags_saver() : active(not omp_in_parallel()), flags(active ? std::cout.flags() : std::ios_base::fmtflags()) {}
+        ~cout_flags_saver() { if (active) std::cout.flags(flags); }
+      private:
+        const bool active;
+        const std::ios_base::fmtflags flags;
+    };
   }
 
   // ======================== Base Functor =====================================
@@ -108,6 +123,8 @@ namespace Gambit
       /// @{
       virtual double getRuntimeAverage();
       virtual double getInvalidationRate();
+      virtual Utils::LatencyHistogram getRuntimeHistogram();
+      virtual long long getInvalidationCount();
       virtual void setFadeRate(double);
       virtual void notifyOfInvalidation(const str&);
       virtual void reset();
@@ -186,6 +203,9 @@ namespace Gambit
       /// Getter for revealing whether this is permitted to be a manager functor
       virtual bool canBeLoopManager();
 
+      /// Getter for revealing whether the wrapped function may be run concurrently with other functions
+      virtual bool threadSafe();
+
       /// Getter for revealing the required capability of the wrapped function's loop manager
       virtual str loopManagerCapability();
       /// Getter for revealing the name of the wrapped function's assigned loop manager
@@ -381,6 +401,12 @@ namespace Gambit
       /// Getter for averaged runtime
       double getRuntimeAverage();
 
+      /// Getter for the distribution of runtimes over all calculations so far
+      Utils::LatencyHistogram getRuntimeHistogram();
+
+      /// Getter for the number of times this functor has invalidated a point
+      long long getInvalidationCount();
+
       /// Reset functor
       void reset();
 
@@ -420,6 +446,11 @@ namespace Gambit
       /// Getter for revealing whether this is permitted to be a manager functor
       virtual bool canBeLoopManager();
 
+      /// Setter for declaring that the wrapped function may be run concurrently with other functions
+      virtual void setThreadSafe (bool);
+      /// Getter for revealing whether the wrapped function may be run concurrently with other functions
+      virtual bool threadSafe();
+
       /// Setter for specifying the capability required of a manager functor, if it is to run this functor nested in a loop.
       virtual void setLoopManagerCapability (str cap);
       /// Getter for revealing the required capability of the wrapped function's loop manager
@@ -554,7 +585,13 @@ namespace Gambit
       void fill_activeModelFlags();
 
       /// Beginning and end timing points
-      std::chrono::time_point<std::chrono::system_clock> *start, *end;
+      std::chrono::time_point<std::chrono::steady_clock> *start, *end;
+
+      /// Runtimes recorded by each thread
+      Utils::LatencyHistogram* runtime_histograms;
+
+      /// Number of times this functor has invalidated a point
+      long long n_invalidations;
 
       /// A flag indicating whether or not this functor has invalidated the current point
       bool point_exception_raised;
@@ -563,13 +600,13 @@ namespace Gambit
       invalid_point_exception raised_point_exception;
 
       /// Averaged runtime in ns
-      double runtime_average;
+      std::atomic<double> runtime_average;
 
       /// Fade rate for average runtime
       double fadeRate;
 
       /// Probability that functors invalidates point in model parameter space
-      double pInvalidation;
+      std::atomic<double> pInvalidation;
 
       /// Needs recalculating or not?
       bool* needs_recalculating;
@@ -583,6 +620,9 @@ namespace Gambit
       /// Flag indicating whether this function can manage a loop over other functions
       bool iCanManageLoops;
 
+      /// Flag indicating whether this function has been declared safe to run concurrently with other functions
+      bool iAmThreadSafe;
+
       /// Flag indicating whether this function is ready to finish its loop (only relevant if iCanManageLoops = true)
       bool myLoopIsDone;
 
@@ -103,6 +103,9 @@ namespace Gambit
   /// Set a backend rule for one or more models.
   int set_backend_rule_for_model(module_functor_common&, str, str);
   
+  /// Declare that a given functor may be run concurrently with other functors.
+  int set_thread_safe(module_functor_common&);
+
   /// Set the classloading requirements of a given functor.
   int set_classload_requirements(module_functor_common&, str, str, str);
 
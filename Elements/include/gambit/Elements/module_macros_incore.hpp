@@ -114,6 +114,13 @@
 /// provide capability \em LOOPMAN.
 #define NEEDS_MANAGER_WITH_CAPABILITY(LOOPMAN)            CORE_NEEDS_MANAGER_WITH_CAPABILITY(LOOPMAN)
 
+/// Declares that the current \link FUNCTION() FUNCTION\endlink of the current
+/// \link MODULE() MODULE\endlink may be run concurrently with other module functions
+/// of the same dependency level.  Only functions that touch no shared state other
+/// than their own result and their (const) dependencies should declare this.  They
+/// must not open OpenMP regions of their own.
+#define THREAD_SAFE                                       CORE_THREAD_SAFE(MODULE, FUNCTION)
+
 /// Indicate that the current \link FUNCTION() FUNCTION\endlink depends on the
 /// presence of another module function that can supply capability \em DEP, with
 /// return type \em TYPE.
@@ -1389,6 +1396,29 @@
   }                                                                            \
 
 
+/// Redirection of THREAD_SAFE when invoked from the Core.
+#define CORE_THREAD_SAFE(MODULE, FUNCTION)                                     \
+                                                                               \
+  IF_TOKEN_UNDEFINED(MODULE,FAIL("You must define MODULE before calling "      \
+   "THREAD_SAFE."))                                                            \
+  IF_TOKEN_UNDEFINED(FUNCTION,FAIL("You must define FUNCTION before calling "  \
+   "THREAD_SAFE. Please check the rollcall header for " STRINGIFY(MODULE) "."))\
+                                                                               \
+  namespace Gambit                                                             \
+  {                                                                            \
+                                                                               \
+    namespace MODULE                                                           \
+    {                                                                          \
+                                                                               \
+      /* Flag the functor as safe to run concurrently. */                      \
+      const int CAT(FUNCTION,_registered_threadsafe) =                         \
+       set_thread_safe(Functown::FUNCTION);                                    \
+                                                                               \
+    }                                                                          \
+                                                                               \
+  }                                                                            \
+
+
 /// Redirection of ACTIVATE_BACKEND_REQ_FOR_MODELS when invoked from the Core.
 #define CORE_BE_MODEL_RULE(MODELS,TAGS)                                        \
                                                                                \
@@ -23,6 +23,8 @@
 #ifndef __SubSpectrum_hpp__
 #define __SubSpectrum_hpp__
 
+#include <typeinfo>
+
 #include "gambit/Utils/safebool.hpp"
 #include "gambit/Elements/spec_head.hpp"
 #include "gambit/Elements/spec_fptrfinder.hpp"
@@ -320,6 +322,87 @@ namespace Gambit {
 
    /// @}
 
+   /// @{ Pre-resolved getters
+
+   /// Result of a lookup in the maps of a Spec<DerivedSpec> object. The finder
+   /// keeps iterators to whatever it found. If that was a function from the getter
+   /// maps, which are shared by all objects of the same wrapper type, the function
+   /// can be called on any such object, so retrieving the value again only costs a
+   /// call through the stored function pointer.
+   template <class DerivedSpec>
+   class SpecResolvedPar : public ResolvedPar
+   {
+      public:
+         SpecResolvedPar(const SetMaps<Spec<DerivedSpec>,MapTag::Get>& maps, const std::type_info& host_type)
+          : finder(maps), host_type(host_type) {}
+
+         double value(const SubSpectrum& spec) const
+         {
+            return finder.callfcn(static_cast<const Spec<DerivedSpec>*>(&spec));
+         }
+
+         bool reusable_for(const SubSpectrum& spec) const
+         {
+            return not finder.found_in_overrides() and typeid(spec) == host_type;
+         }
+
+         /// Must not be copied or moved, as its callfcn member points back to it.
+         /// Its pointers to the object searched are not used after the search.
+         mutable FptrFinder<Spec<DerivedSpec>,MapTag::Get> finder;
+
+      private:
+         /// Dynamic type of the object searched
+         const std::type_info& host_type;
+   };
+
+   template <class DerivedSpec>
+   std::shared_ptr<const ResolvedPar> Spec<DerivedSpec>::resolve_par(const Par::Tags partype, const str& name,
+                                                                     const int n_indices, const int i, const int j,
+                                                                     const SpecOverrideOptions check_overrides,
+                                                                     const bool check_antiparticle) const
+   {
+      bool overrides=true;
+      bool override_only=false;
+      if     (check_overrides == use_overrides) {  overrides=true;  override_only=false; }
+      else if(check_overrides == overrides_only){  overrides=true;  override_only=true; }
+      else if(check_overrides == ignore_overrides){overrides=false; override_only=false;}
+
+      /* Unlike in the getters, the maps must be referred to directly rather than
+         copied, as the finder keeps iterators into them after this function returns. */
+      const OverrideMaps&         overridecoll = override_maps.at(partype);
+      const MapCollection<MTget>& mapcoll      = getter_maps.at(partype);
+      std::shared_ptr<SpecResolvedPar<DerivedSpec>> par(new SpecResolvedPar<DerivedSpec>(
+                       SetMaps<Spec<DerivedSpec>,MapTag::Get>(Par::toString.at(partype),this)
+                              .omap0( overridecoll.m0 )
+                              .omap1( overridecoll.m1 )
+                              .omap2( overridecoll.m2 )
+                              .map0(  mapcoll.map0 )
+                              .map1(  mapcoll.map1 )
+                              .map2(  mapcoll.map2 )
+                              .map0W( mapcoll.map0W )
+                              .map1W( mapcoll.map1W )
+                              .map2W( mapcoll.map2W )
+                              .map0M( mapcoll.map0_extraM )
+                              .map1M( mapcoll.map1_extraM )
+                              .map2M( mapcoll.map2_extraM )
+                              .map0I( mapcoll.map0_extraI )
+                              .map1I( mapcoll.map1_extraI )
+                              .map2I( mapcoll.map2_extraI )
+                              .override_only(override_only)
+                              .no_overrides(not overrides), typeid(*this)));
+      bool found;
+      switch(n_indices)
+      {
+         case 0:  found = par->finder.find(name,true,check_antiparticle); break;
+         case 1:  found = par->finder.find(name,i,true,check_antiparticle); break;
+         default: found = par->finder.find(name,i,j);
+      }
+      if(not found) par->finder.raise_error(LOCAL_INFO);
+      return par;
+   }
+
+   /// @}
+
    /// @}
 
 }
@@ -318,6 +318,10 @@ namespace Gambit {
            , callfcn(this)
          {}
 
+         /// Check whether the search result is an override value (held by the host object itself)
+         /// rather than a function from the getter maps (shared by all host objects of a type)
+         bool found_in_overrides() const { return whichiter >= 0 and whichiter <= 2; }
+
          /// @{ Error reporting
          int          get_error_code(){ return error_code; }
          std::string  get_error_message()
@@ -788,12 +792,19 @@ namespace Gambit {
       {}
 
       double operator()()
+      {
+         return (*this)(ff->const_fakethis);
+      }
+
+      /// Call the function found by the search on another host object of the same type
+      /// (only meaningful if the function was not found in the host's override maps)
+      double operator()(const HostSpec* host)
       {
          double result(-1); // should not be returned in this state
          if(ff->error_code==0)
          {
-            const Model& model = ff->const_fakethis->model();
-            const Input& input = ff->const_fakethis->input();
+            const Model& model = host->model();
+            const Input& input = host->input();
             switch( ff->whichiter )
             {
                // Override retrieval cases
@@ -874,14 +885,14 @@ namespace Gambit {
                  // (and therefore the fakethis pointers) is going to be of 
                  // type Spec<DerivedSpec>. Therefore need to cast to the
                  // derived type to call the function.
-                 const DerivedSpec* wrapper = static_cast<const DerivedSpec*>(ff->const_fakethis);
+                 const DerivedSpec* wrapper = static_cast<const DerivedSpec*>(host);
                  result = (wrapper->*f)();
                  break;}
                case 13: {
                  ff->check(ff->it1W_safe());
                  ff->check_index_initd(LOCAL_INFO,ff->index1,"index1");
                  typename MT::FSptr1W f = ff->it1W->second.fptr;
-                 const DerivedSpec* wrapper = static_cast<const DerivedSpec*>(ff->const_fakethis);
+                 const DerivedSpec* wrapper = static_cast<const DerivedSpec*>(host);
                  result = (wrapper->*f)(ff->index1);
                  break;}
                case 14: {
@@ -889,7 +900,7 @@ namespace Gambit {
                  ff->check_index_initd(LOCAL_INFO,ff->index1,"index1");
                  ff->check_index_initd(LOCAL_INFO,ff->index2,"index2");
                  typename MT::FSptr2W f = ff->it2W->second.fptr;
-                 const DerivedSpec* wrapper = static_cast<const DerivedSpec*>(ff->const_fakethis);
+                 const DerivedSpec* wrapper = static_cast<const DerivedSpec*>(host);
                  result = (wrapper->*f)(ff->index1,ff->index2);
                  break;}
               default:{
@@ -128,6 +128,10 @@ namespace Gambit
          void set(const Par::Tags, const double, const str&, const int, const SafeBool=SafeBool(true));
          void set(const Par::Tags, const double, const str&, const int, const int);
 
+         /// Keep the FptrFinder from a lookup, so that SpecParHandles can call the getter directly
+         std::shared_ptr<const ResolvedPar> resolve_par(const Par::Tags, const str&, const int, const int, const int,
+                                                        const SpecOverrideOptions, const bool) const;
+
          /// @{ Default (empty) map filler functions
          /// Override as needed in derived classes
          static const std::map<Par::Tags,MapCollection<MTget>> fill_getter_maps()
@@ -29,6 +29,8 @@
 #include <map>
 #include <set>
 #include <cfloat>
+#include <memory>
+#include <vector>
 #include <sstream>
 
 #include "gambit/Utils/cats.hpp"
@@ -79,6 +81,118 @@ namespace Gambit
       /* e.g. retrieve like this: contents = m2[name][i][j]; */
    };
 
+   /// Result of locating a parameter in the getter/override maps of a SubSpectrum
+   /// object, so that retrieving its value involves no further string lookups.
+   class ResolvedPar
+   {
+      public:
+         virtual ~ResolvedPar() {}
+
+         /// Value of the parameter in spec, which must be either the object that was
+         /// searched or one for which reusable_for() is true
+         virtual double value(const SubSpectrum& spec) const = 0;
+
+         /// Check whether the result also holds for spec (given that spec has no overrides)
+         virtual bool reusable_for(const SubSpectrum& spec) const = 0;
+   };
+
+   /// Handle to a parameter of whichever SubSpectrum object is passed to get().
+   ///
+   /// A handle holds no reference to any SubSpectrum, so it can be created once (e.g.
+   /// as a static object in a module function) and used at every point, with the
+   /// spectrum of that point. The string lookup is done on the first get(), and its
+   /// result is reused as long as the spectra passed in are of the same wrapper type
+   /// and have no override set for this parameter (overrides of other parameters do
+   /// not matter); otherwise get() does a full lookup, just like the corresponding
+   /// SubSpectrum::get. A handle must not be used by several threads at once.
+   class SpecParHandle
+   {
+      public:
+         /// Arguments are as for the corresponding SubSpectrum getters
+         SpecParHandle(const Par::Tags, const str&,
+              const SpecOverrideOptions=use_overrides,
+              const SafeBool check_antiparticle = SafeBool(true));
+
+         SpecParHandle(const Par::Tags, const str&, const int,
+              const SpecOverrideOptions=use_overrides,
+              const SafeBool check_antiparticle = SafeBool(true));
+
+         SpecParHandle(const Par::Tags, const str&, const int, const int,
+              const SpecOverrideOptions=use_overrides);
+
+         SpecParHandle(const Par::Tags, const std::pair<int,int>,
+              const SpecOverrideOptions=use_overrides,
+              const SafeBool check_antiparticle = SafeBool(true)); /* Input PDG code plus context integer */
+
+         SpecParHandle(const Par::Tags, const std::pair<str,int>,
+              const SpecOverrideOptions=use_overrides,
+              const SafeBool check_antiparticle = SafeBool(true)); /* Input short name plus index */
+
+         /// Retrieve the value of the parameter from spec
+         double get(const SubSpectrum& spec) const;
+
+         /// Check whether get(spec) would reuse the result of an earlier lookup
+         bool reuses_lookup_for(const SubSpectrum& spec) const;
+
+      private:
+         Par::Tags partype;
+         str name;
+         int n_indices;
+         int i;
+         int j;
+         SpecOverrideOptions check_overrides;
+         bool check_antiparticle;
+
+         /// Result of the last lookup that can be reused for other objects
+         mutable std::shared_ptr<const ResolvedPar> par;
+
+         /// @{ Keys of the override maps searched before the getter maps for this
+         /// parameter, i.e. those under which an override would hide the reused lookup
+         mutable std::vector<str> override_keys0;
+         mutable std::vector<std::pair<str,int>> override_keys1;
+         /// @}
+
+         /// Fill the lists of override keys (done once, when a lookup is first kept)
+         void find_override_keys() const;
+
+         /// Check whether spec has an override set under any of the override keys
+         bool overridden_in(const SubSpectrum& spec) const;
+   };
+
+   /// Values of a fixed list of parameters, retrieved together through handles and
+   /// stored contiguously. Add the parameters once (e.g. to a static object in a
+   /// module function), then at each point pass the spectrum of that point to
+   /// update() and read the values out by the position returned from add().
+   class SpecParSnapshot
+   {
+      public:
+         /// Add a parameter to the list; returns its position in the snapshot
+         std::size_t add(const SpecParHandle& handle)
+         {
+            handles.push_back(handle);
+            values.push_back(0.);
+            return handles.size() - 1;
+         }
+
+         /// Retrieve the values of all parameters in the list from spec
+         void update(const SubSpectrum& spec)
+         {
+            for(std::size_t k = 0; k < handles.size(); ++k) values[k] = handles[k].get(spec);
+         }
+
+         /// Value of the parameter at position k, as of the last call to update()
+         double operator[](const std::size_t k) const { return values[k]; }
+
+         /// All values, in the order in which the parameters were added
+         const std::vector<double>& data() const { return values; }
+
+         std::size_t size() const { return handles.size(); }
+
+      private:
+         std::vector<SpecParHandle> handles;
+         std::vector<double> values;
+   };
+
 
 
    /// Virtual base class for interacting with spectrum generator output
@@ -253,11 +367,14 @@ namespace Gambit
          /// TODO: extra PDB overloads to handle all the one and two index cases (well all the ones that are feasible...)
 
 
+
          /// PDG code translation map, for special cases where an SLHA file has been read in and the PDG codes changed.
          virtual const std::map<int, int>& PDG_translator() const { return empty_map; }
 
      private:
 
+         friend class SpecParHandle;
+
          const std::map<int, int> empty_map;
 
          /// Initialiser function for override_maps
@@ -267,8 +384,34 @@ namespace Gambit
          /// Map of override maps
          std::map<Par::Tags,OverrideMaps> override_maps;
 
+         /// Locate a parameter for a SpecParHandle (raising an error if it does not exist).
+         /// This default version just goes through the string-based getters each time;
+         /// Spec<DerivedSpec> overrides it to keep the result of the map search.
+         virtual std::shared_ptr<const ResolvedPar> resolve_par(const Par::Tags, const str&,
+              const int n_indices, const int i, const int j,
+              const SpecOverrideOptions, const bool check_antiparticle) const;
+
    };
 
+   inline bool SpecParHandle::reuses_lookup_for(const SubSpectrum& spec) const
+   {
+      return par and par->reusable_for(spec) and not overridden_in(spec);
+   }
+
+   inline double SpecParHandle::get(const SubSpectrum& spec) const
+   {
+      if(reuses_lookup_for(spec)) return par->value(spec);
+      std::shared_ptr<const ResolvedPar> found = spec.resolve_par(partype, name, n_indices, i, j, check_overrides, check_antiparticle);
+      // A result from the getter maps, which any object of the same type shares, can be kept for
+      // other objects; one from the override maps is only valid for this one.
+      if(found->reusable_for(spec))
+      {
+         if(not par) find_override_keys();
+         par = found;
+      }
+      return found->value(spec);
+   }
+
 } // end namespace Gambit
 
 // Undef the various helper macros to avoid contaminating other files
@@ -315,6 +315,25 @@ namespace Gambit
     }
   }
 
+  /// Retrieve the BF and error for a final state, raising an error if the channel is absent
+  const std::pair<double, double>& DecayTable::Entry::channel_at(const std::multiset< std::pair<int,int> >& key) const
+  {
+    auto channel = channels.find(key);
+    if (channel == channels.end())
+    {
+      std::ostringstream err;
+      err << "No branching fraction exists for the requested final states:";
+      for (auto particle = key.begin(); particle != key.end(); ++particle)
+      {
+        err << " {" << particle->first << ", " << particle->second << "}";
+      }
+      model_error().raise(LOCAL_INFO,err.str());
+      // Only reached if the error is not fatal
+      return channels.at(key);
+    }
+    return channel->second;
+  }
+
   /// Set branching fraction for decay to a given final state. 1. PDG-context integer pairs (vector)
   void DecayTable::Entry::set_BF(double BF, double error, const std::vector<std::pair<int,int> >& daughters)
   {
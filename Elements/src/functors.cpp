@@ -45,12 +45,30 @@
 #include "gambit/Logs/logging.hpp"
 
 #include <boost/preprocessor/seq/for_each.hpp>
-#include <boost/io/ios_state.hpp>
 
 namespace Gambit
 {
   using namespace LogTags;
 
+  // Local helper functions
+
+  namespace
+  {
+    /// Atomically add to a double, without locking
+    void atomic_add(std::atomic<double>& x, double increment)
+    {
+      double old = x.load(std::memory_order_relaxed);
+      while (not x.compare_exchange_weak(old, old + increment, std::memory_order_relaxed)) {}
+    }
+
+    /// Atomically move a running average a fraction 'rate' of the way towards 'value', without locking
+    void fade_towards(std::atomic<double>& average, double value, double rate)
+    {
+      double old = average.load(std::memory_order_relaxed);
+      while (not average.compare_exchange_weak(old, old*(1-rate) + rate*value, std::memory_order_relaxed)) {}
+    }
+  }
+
   // Functor class methods
 
     /// Constructor
@@ -80,6 +98,8 @@ namespace Gambit
     /// @{
     double functor::getRuntimeAverage() { return 0; }
     double functor::getInvalidationRate() { return 0; }
+    Utils::LatencyHistogram functor::getRuntimeHistogram() { return Utils::LatencyHistogram(); }
+    long long functor::getInvalidationCount() { return 0; }
     void functor::setFadeRate(double) {}
     void functor::notifyOfInvalidation(const str&) {}
     void functor::reset() {}
@@ -186,6 +206,9 @@ namespace Gambit
       return false;
     }
 
+    /// Getter for revealing whether the wrapped function may be run concurrently with other functions
+    bool functor::threadSafe() { return false; }
+
     /// Getter for revealing the required capability of the wrapped function's loop manager
     str functor::loopManagerCapability()
     {
@@ -582,6 +605,8 @@ namespace Gambit
       myTimingPrintFlag        (false),
       start                    (NULL),
       end                      (NULL),
+      runtime_histograms       (NULL),
+      n_invalidations          (0),
       point_exception_raised   (false),
       runtime_average          (FUNCTORS_RUNTIME_INIT),           // default 1 micro second
       fadeRate                 (FUNCTORS_FADE_RATE),              // can be set individually for each functor
@@ -590,6 +615,7 @@ namespace Gambit
       already_printed          (NULL),
       already_printed_timing   (NULL),
       iCanManageLoops          (false),
+      iAmThreadSafe            (false),
       iRunNested               (false),
       myLoopManagerCapability  ("none"),
       myLoopManager            (NULL),
@@ -608,6 +634,7 @@ namespace Gambit
     {
       if (start != NULL)                  delete [] start;
       if (end != NULL)                    delete [] end;
+      if (runtime_histograms != NULL)     delete [] runtime_histograms;
       if (needs_recalculating != NULL)    delete [] needs_recalculating;
       if (already_printed != NULL)        delete [] already_printed;
       if (already_printed_timing != NULL) delete [] already_printed_timing;
@@ -634,6 +661,23 @@ namespace Gambit
       return runtime_average;
     }
 
+    /// Getter for the distribution of runtimes over all calculations so far
+    /// (not to be called while the functor may be calculating)
+    Utils::LatencyHistogram module_functor_common::getRuntimeHistogram()
+    {
+      Utils::LatencyHistogram result;
+      if (runtime_histograms == NULL) return result;
+      int n = (iRunNested ? globlMaxThreads : 1);
+      for (int i = 0; i < n; ++i) result.merge(runtime_histograms[i]);
+      return result;
+    }
+
+    /// Getter for the number of times this functor has invalidated a point
+    long long module_functor_common::getInvalidationCount()
+    {
+      return n_invalidations;
+    }
+
     /// Setter for indicating if the timing data for this function's execution should be printed
     void module_functor_common::setTimingPrintRequirement(bool flag)
     {
@@ -678,8 +722,9 @@ namespace Gambit
     /// Acknowledge that this functor invalidated the current point in model space.
     void module_functor_common::acknowledgeInvalidation(invalid_point_exception& e, functor* f)
     {
+      atomic_add(pInvalidation, fadeRate*(1-FUNCTORS_BASE_INVALIDATION_RATE));
       #pragma omp atomic
-      pInvalidation += fadeRate*(1-FUNCTORS_BASE_INVALIDATION_RATE);
+      n_invalidations++;
       if (f==NULL) f = this;
       #pragma omp critical (raised_point_exception)
       {
@@ -837,6 +882,11 @@ namespace Gambit
     /// Getter for revealing whether this is permitted to be a manager functor
     bool module_functor_common::canBeLoopManager() { return iCanManageLoops; }
 
+    /// Setter for declaring that the wrapped function may be run concurrently with other functions
+    void module_functor_common::setThreadSafe (bool safe) { iAmThreadSafe = safe; }
+    /// Getter for revealing whether the wrapped function may be run concurrently with other functions
+    bool module_functor_common::threadSafe() { return iAmThreadSafe; }
+
     /// Setter for specifying the capability required of a manager functor, if it is to run this functor nested in a loop.
     void module_functor_common::setLoopManagerCapability (str cap) { iRunNested = true; myLoopManagerCapability = cap; }
     /// Getter for revealing the required capability of the wrapped function's loop manager
@@ -1493,14 +1543,21 @@ namespace Gambit
       {
         #pragma omp critical(module_functor_common_init_memory_start)
         {
-          if(start==NULL) start = new std::chrono::time_point<std::chrono::system_clock>[n];
+          if(start==NULL) start = new std::chrono::time_point<std::chrono::steady_clock>[n];
         }
       }
       if(end==NULL)
       {
         #pragma omp critical(module_functor_common_init_memory_end)
         {
-          if(end==NULL) end = new std::chrono::time_point<std::chrono::system_clock>[n];
+          if(end==NULL) end = new std::chrono::time_point<std::chrono::steady_clock>[n];
+        }
+      }
+      if(runtime_histograms==NULL)
+      {
+        #pragma omp critical(module_functor_common_init_memory_runtime_histograms)
+        {
+          if(runtime_histograms==NULL) runtime_histograms = new Utils::LatencyHistogram[n];
         }
       }
       if(needs_recalculating==NULL)
@@ -1541,19 +1598,18 @@ namespace Gambit
     /// Do pre-calculate timing things
     void module_functor_common::startTiming(int thread_num)
     {
-      start[thread_num] = std::chrono::system_clock::now();
+      start[thread_num] = std::chrono::steady_clock::now();
     }
 
     /// Do post-calculate timing things
     void module_functor_common::finishTiming(int thread_num)
     {
-      end[thread_num] = std::chrono::system_clock::now();
+      end[thread_num] = std::chrono::steady_clock::now();
       std::chrono::duration<double> runtime = end[thread_num] - start[thread_num];
-      #pragma omp critical(module_functor_common_finishTiming)
-      {
-        runtime_average = runtime_average*(1-fadeRate) + fadeRate*runtime.count();
-        pInvalidation = pInvalidation*(1-fadeRate) + fadeRate*FUNCTORS_BASE_INVALIDATION_RATE;
-      }
+      // Each thread has its own histogram, and the averages are updated atomically, so no locking is needed here
+      runtime_histograms[thread_num].add(runtime.count());
+      fade_towards(runtime_average, runtime.count(), fadeRate);
+      fade_towards(pInvalidation, FUNCTORS_BASE_INVALIDATION_RATE, fadeRate);
       needs_recalculating[thread_num] = false;
     }
 
@@ -1592,8 +1648,8 @@ namespace Gambit
         << " cannot be used" << endl << "because it initialises a backend that you do not have installed!";
         backend_error().raise(LOCAL_INFO, ss.str());
       }
-      boost::io::ios_flags_saver ifs(cout);        // Don't allow module functions to change the output precision of cout
-      int thread_num = omp_get_thread_num();
+      FunctorHelp::cout_flags_saver ifs;           // Don't allow module functions to change the output precision of cout
+      int thread_num = (iRunNested ? omp_get_thread_num() : 0); // Functors outside loops keep a single result, even if run concurrently with others
       fill_activeModelFlags();                     // If activeModels hasn't been populated yet, make sure it is.
       init_memory();                               // Init memory if this is the first run through.
       if (needs_recalculating[thread_num])
@@ -420,6 +420,17 @@ namespace Gambit
     return 0;
   }
 
+  /// Declare that a given functor may be run concurrently with other functors.
+  int set_thread_safe(module_functor_common& f)
+  {
+    try
+    {
+      f.setThreadSafe(true);
+    }
+    catch (std::exception& e) { ini_catch(e); }
+    return 0;
+  }
+
   /// Set the classloading requirements of a given functor.
   int set_classload_requirements(module_functor_common& f, str be, str verstr, str default_ver)
   {
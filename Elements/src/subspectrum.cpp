@@ -25,6 +25,7 @@
 
 #include <fstream>
 #include <string>
+#include <typeinfo>
 
 #include "gambit/Elements/subspectrum.hpp"
 #include "gambit/Elements/mssm_slhahelp.hpp"
@@ -200,6 +201,165 @@ namespace Gambit
 
    /// @}
 
+   /// @{ Parameter handles
+
+   namespace
+   {
+      /// Fallback for SubSpectrum classes that cannot keep the result of a lookup:
+      /// just calls the string-based getter every time.
+      class UnresolvedPar : public ResolvedPar
+      {
+         public:
+            UnresolvedPar(const SubSpectrum& spec, const Par::Tags partype, const str& name,
+                          const int n_indices, const int i, const int j,
+                          const SpecOverrideOptions check_overrides, const bool check_antiparticle)
+             : host_type(typeid(spec)), partype(partype), name(name), n_indices(n_indices), i(i), j(j)
+             , check_overrides(check_overrides), check_antiparticle(check_antiparticle)
+            {}
+
+            double value(const SubSpectrum& spec) const
+            {
+               switch(n_indices)
+               {
+                  case 0: return spec.get(partype, name, check_overrides, SafeBool(check_antiparticle));
+                  case 1: return spec.get(partype, name, i, check_overrides, SafeBool(check_antiparticle));
+                  default: return spec.get(partype, name, i, j, check_overrides);
+               }
+            }
+
+            bool reusable_for(const SubSpectrum& spec) const { return typeid(spec) == host_type; }
+
+         private:
+            const std::type_info& host_type;
+            const Par::Tags partype;
+            const str name;
+            const int n_indices;
+            const int i;
+            const int j;
+            const SpecOverrideOptions check_overrides;
+            const bool check_antiparticle;
+      };
+   }
+
+   std::shared_ptr<const ResolvedPar> SubSpectrum::resolve_par(const Par::Tags partype, const str& name,
+                                                               const int n_indices, const int i, const int j,
+                                                               const SpecOverrideOptions check_overrides,
+                                                               const bool check_antiparticle) const
+   {
+      bool found;
+      switch(n_indices)
+      {
+         case 0:  found = has(partype, name, check_overrides, SafeBool(check_antiparticle)); break;
+         case 1:  found = has(partype, name, i, check_overrides, SafeBool(check_antiparticle)); break;
+         default: found = has(partype, name, i, j, check_overrides);
+      }
+      if(not found)
+      {
+         std::ostringstream errmsg;
+         errmsg << "Could not resolve "<<Par::toString.at(partype)<<" with string reference '"<<name<<"'";
+         if(n_indices > 0) errmsg << " and indices '"<<i<<(n_indices > 1 ? ","+std::to_string(j) : "")<<"'";
+         errmsg << " in SubSpectrum object (name = "<<getName()<<")!";
+         utils_error().raise(LOCAL_INFO,errmsg.str());
+      }
+      return std::make_shared<UnresolvedPar>(*this, partype, name, n_indices, i, j, check_overrides, check_antiparticle);
+   }
+
+   SpecParHandle::SpecParHandle(const Par::Tags partype, const str& name,
+                                const SpecOverrideOptions check_overrides,
+                                const SafeBool check_antiparticle)
+    : partype(partype), name(name), n_indices(0), i(0), j(0)
+    , check_overrides(check_overrides), check_antiparticle(check_antiparticle)
+   {}
+
+   SpecParHandle::SpecParHandle(const Par::Tags partype, const str& name, const int i,
+                                const SpecOverrideOptions check_overrides,
+                                const SafeBool check_antiparticle)
+    : partype(partype), name(name), n_indices(1), i(i), j(0)
+    , check_overrides(check_overrides), check_antiparticle(check_antiparticle)
+   {}
+
+   SpecParHandle::SpecParHandle(const Par::Tags partype, const str& name, const int i, const int j,
+                                const SpecOverrideOptions check_overrides)
+    : partype(partype), name(name), n_indices(2), i(i), j(j)
+    , check_overrides(check_overrides), check_antiparticle(false)
+   {}
+
+   /* Input PDG code plus context integer as pair */
+   SpecParHandle::SpecParHandle(const Par::Tags partype,
+                                const std::pair<int,int> pdgpr,
+                                const SpecOverrideOptions check_overrides,
+                                const SafeBool check_antiparticle)
+    : SpecParHandle(partype, Models::ParticleDB().long_name(pdgpr), check_overrides, check_antiparticle)
+   {}
+
+   /* Input short name plus index as pair */
+   SpecParHandle::SpecParHandle(const Par::Tags partype,
+                                const std::pair<str,int> shortpr,
+                                const SpecOverrideOptions check_overrides,
+                                const SafeBool check_antiparticle)
+    : SpecParHandle(partype, shortpr.first, shortpr.second, check_overrides, check_antiparticle)
+   {}
+
+   /// These are the keys tried by the override part of FptrFinder::find, in the same order
+   void SpecParHandle::find_override_keys() const
+   {
+      if(check_overrides == ignore_overrides) return;
+      const Models::partmap& pdb = Models::ParticleDB();
+      if(n_indices == 0)
+      {
+         override_keys0.push_back(name);
+         if(pdb.has_short_name(name)) override_keys1.push_back(pdb.short_name_pair(name));
+         if(check_antiparticle and pdb.has_particle(name) and pdb.has_antiparticle(name))
+         {
+            str antiname = pdb.get_antiparticle(name);
+            override_keys0.push_back(antiname);
+            if(pdb.has_short_name(antiname)) override_keys1.push_back(pdb.short_name_pair(antiname));
+         }
+      }
+      else if(n_indices == 1)
+      {
+         override_keys1.push_back(std::make_pair(name,i));
+         if(pdb.has_particle(name,i)) override_keys0.push_back(pdb.long_name(name,i));
+         if(check_antiparticle and pdb.has_particle(name,i) and pdb.has_antiparticle(name,i))
+         {
+            std::pair<str,int> anti = pdb.get_antiparticle(name,i);
+            override_keys1.push_back(anti);
+            override_keys0.push_back(pdb.long_name(anti.first,anti.second));
+         }
+      }
+   }
+
+   bool SpecParHandle::overridden_in(const SubSpectrum& spec) const
+   {
+      if(check_overrides == ignore_overrides) return false;
+      const OverrideMaps& overrides = spec.override_maps.at(partype);
+      if(n_indices == 2)
+      {
+         auto it = overrides.m2.find(name);
+         if(it == overrides.m2.end()) return false;
+         auto jt = it->second.find(i);
+         return jt != it->second.end() and jt->second.count(j) != 0;
+      }
+      if(not overrides.m0.empty())
+      {
+         for(auto key = override_keys0.begin(); key != override_keys0.end(); ++key)
+         {
+            if(overrides.m0.count(*key) != 0) return true;
+         }
+      }
+      if(not overrides.m1.empty())
+      {
+         for(auto key = override_keys1.begin(); key != override_keys1.end(); ++key)
+         {
+            auto it = overrides.m1.find(key->first);
+            if(it != overrides.m1.end() and it->second.count(key->second) != 0) return true;
+         }
+      }
+      return false;
+   }
+
+   /// @}
+
    /// @{ Parameter override functions
 
    void SubSpectrum::set_override(const Par::Tags partype,
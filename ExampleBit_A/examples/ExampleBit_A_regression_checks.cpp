@@ -0,0 +1,303 @@
+//   GAMBIT: Global and Modular BSM Inference Tool
+//   *********************************************
+///  \file
+///
+///  Regression checks for the concurrency and
+///  timing machinery of the functors and logger,
+///  using ExampleBit_A in standalone mode:
+///  - THREAD_SAFE functors calculated concurrently,
+///    the way the dependency resolver does it
+///  - invalid points and errors raised by functors
+///    calculated concurrently
+///  - per-functor runtime histograms and
+///    invalidation counts
+///  - the asynchronous log sink
+///
+///  Returns non-zero if any check fails.
+///
+///  *********************************************
+///
+///  Authors (add name and date if you modify):
+///
+///  \author agent
+///          (agent@local)
+///  \date 2026 Oct
+///
+///  *********************************************
+
+// Always required in any standalone module main file
+#include "gambit/Elements/standalone_module.hpp"
+#include "gambit/ExampleBit_A/ExampleBit_A_rollcall.hpp"
+
+// Only needed here
+#include <iomanip>
+#include <thread>
+#include <sstream>
+#include <exception>
+#include "gambit/Utils/util_functions.hpp"
+#include "gambit/Logs/async_log_sink.hpp"
+
+using namespace ExampleBit_A::Functown;     // Functors wrapping the module's actual module functions
+
+QUICK_FUNCTION(ExampleBit_A, xsection, OLD_CAPABILITY, local_xsection, double, (NUHM1))
+QUICK_FUNCTION(ExampleBit_A, broken_observable, NEW_CAPABILITY, local_error, double)
+
+namespace Gambit
+{
+  namespace ExampleBit_A
+  {
+    void local_xsection(double &result) { result = *Pipes::local_xsection::Param["M0"];}
+    void local_error(double &) { ExampleBit_A_error().raise(LOCAL_INFO,"This observable is always broken."); }
+  }
+}
+
+namespace
+{
+
+  int failures = 0;
+
+  void check(bool passed, const std::string& what)
+  {
+    std::cout << (passed ? "  passed: " : "  FAILED: ") << what << std::endl;
+    if (not passed) failures++;
+  }
+
+  /// Calculate a set of functors concurrently, the way DependencyResolver::calculateConcurrently does,
+  /// and return the first exception carried out of the parallel region (if any).
+  std::exception_ptr calculate_concurrently(const std::vector<functor*>& functors)
+  {
+    std::vector<std::exception_ptr> errors(functors.size());
+    #pragma omp parallel for schedule(dynamic)
+    for (int j = 0; j < int(functors.size()); j++)
+    {
+      try
+      {
+        Parallel_throw_scope scope;
+        functors[j]->calculate();
+      }
+      catch (...)
+      {
+        errors[j] = std::current_exception();
+      }
+    }
+    for (auto it = errors.begin(); it != errors.end(); ++it) if (*it) return *it;
+    return std::exception_ptr();
+  }
+
+  /// Push numbered messages from several kinds of threads into a sink, and check what comes out
+  void check_sink(std::size_t buffer_length, bool block_when_full)
+  {
+    const int per_producer = 5000;
+    const int omp_producers = 4;
+    std::vector<std::string> delivered;
+    unsigned long long dropped;
+    {
+      // Messages are only delivered by one thread at a time
+      Logging::AsyncLogSink sink(buffer_length, block_when_full,
+       [&delivered](const Logging::Message& mail) { delivered.push_back(mail.message); });
+      auto produce = [&sink](int producer)
+      {
+        for (int i = 0; i < per_producer; i++)
+        {
+          sink.push(Logging::Message(std::to_string(producer) + " " + std::to_string(i), std::set<int>()));
+        }
+      };
+      // A thread started outside OpenMP has thread number 0 as well, but must get its own buffer
+      std::thread outsider(produce, omp_producers);
+      #pragma omp parallel for num_threads(omp_producers)
+      for (int producer = 0; producer < omp_producers; producer++) produce(producer);
+      outsider.join();
+      sink.flush();
+      dropped = sink.dropped();
+    }
+
+    const int total = (omp_producers + 1)*per_producer;
+    std::vector<int> last(omp_producers + 1, -1);
+    bool in_order = true;
+    for (auto it = delivered.begin(); it != delivered.end(); ++it)
+    {
+      std::istringstream ss(*it);
+      int producer, i;
+      ss >> producer >> i;
+      in_order = in_order and i > last[producer];
+      last[producer] = i;
+    }
+    std::string policy = (block_when_full ? "block" : "drop");
+    if (block_when_full) check(dropped == 0 and int(delivered.size()) == total, policy + ": every message is delivered");
+    else check(int(delivered.size() + dropped) == total, policy + ": every message is delivered or counted as dropped");
+    check(in_order, policy + ": messages from each thread are delivered in order");
+  }
+
+}
+
+int main()
+{
+
+  try
+  {
+
+    std::cout << std::endl << "Starting ExampleBit_A regression checks" << std::endl;
+    std::cout << "----------" << std::endl;
+
+    initialise_standalone_logs("runs/ExampleBit_A_regression_checks/logs/");
+    model_warning().set_fatal(true);
+    Random::create_rng_engine("default");
+
+    ModelParameters* CMSSM_primary_parameters = Models::CMSSM::Functown::primary_parameters.getcontentsPtr();
+
+    // Only functions declared THREAD_SAFE may be run concurrently by the dependency resolver
+    std::cout << std::endl << "THREAD_SAFE declarations:" << std::endl;
+    check(nevents_like.threadSafe() and nevents_pred_rounded.threadSafe() and particle_identity.threadSafe() and test_sigma.threadSafe(),
+     "functions declared THREAD_SAFE are flagged as such");
+    check(not nevents_pred.threadSafe() and not eventLoopManager.threadSafe(), "other functions and loop managers are not");
+
+    // Set up the same dependency tree as the ExampleBit_A standalone example
+    Models::CMSSM::Functown::NUHM1_parameters.notifyOfModel("CMSSM");
+    local_xsection.notifyOfModel("CMSSM");
+    Models::CMSSM::Functown::NUHM1_parameters.resolveDependency(&Models::CMSSM::Functown::primary_parameters);
+    local_xsection.resolveDependency(&Models::CMSSM::Functown::NUHM1_parameters);
+    nevents_pred.resolveDependency(&local_xsection);
+    nevents_pred_rounded.resolveDependency(&nevents_pred);
+    exampleCut.resolveDependency(&exampleEventGen);
+    eventAccumulator.resolveDependency(&exampleCut);
+    exampleEventGen.resolveLoopManager(&eventLoopManager);
+    exampleCut.resolveLoopManager(&eventLoopManager);
+    eventAccumulator.resolveLoopManager(&eventLoopManager);
+    eventLoopManager.setNestedList(initVector<functor*>(&exampleEventGen, &exampleCut, &eventAccumulator));
+    nevents_like.resolveDependency(&nevents_pred);
+    nevents_like.resolveDependency(&eventAccumulator);
+    local_error.setThreadSafe(true);
+    nevents_pred_rounded.setOption<double>("probability_of_validity", 0.5);
+
+    // Calculate the THREAD_SAFE functions concurrently at each point, then again one by one
+    std::cout << std::endl << "Concurrent calculation:" << std::endl;
+    const int npoints = 20;
+    int invalid_points = 0;
+    bool concurrent_ok = true, cout_ok = true;
+    std::vector<functor*> concurrent = initVector<functor*>(&nevents_like, &particle_identity, &test_sigma);
+    for (int i = 0; i < npoints; i++)
+    {
+      CMSSM_primary_parameters->setValue("M0",i*1.);
+      CMSSM_primary_parameters->setValue("A0",i*5.);
+      CMSSM_primary_parameters->setValue("M12",i*2.);
+      CMSSM_primary_parameters->setValue("TanBeta",i*10.);
+      CMSSM_primary_parameters->setValue("SignMu",1.);
+
+      eventLoopManager.reset_and_calculate();
+      Models::CMSSM::Functown::NUHM1_parameters.reset_and_calculate();
+      local_xsection.reset_and_calculate();
+      nevents_pred.reset_and_calculate();
+      try
+      {
+        nevents_pred_rounded.reset_and_calculate();
+      }
+      catch (Gambit::invalid_point_exception&)
+      {
+        invalid_points++;
+      }
+
+      std::cout << std::scientific << std::setprecision(3);
+      for (auto it = concurrent.begin(); it != concurrent.end(); ++it) (*it)->reset();
+      concurrent_ok = concurrent_ok and not calculate_concurrently(concurrent);
+      cout_ok = cout_ok and (std::cout.flags() & std::ios::scientific) and std::cout.precision() == 3;
+      std::cout.unsetf(std::ios::floatfield);
+      std::cout << std::setprecision(6);
+      double like = nevents_like(0);
+      str id = particle_identity(0);
+      double sigma = test_sigma(0);
+
+      for (auto it = concurrent.begin(); it != concurrent.end(); ++it) (*it)->reset_and_calculate();
+      concurrent_ok = concurrent_ok and like == nevents_like(0) and id == particle_identity(0) and sigma == test_sigma(0);
+    }
+    check(concurrent_ok, "results match those calculated serially");
+    check(cout_ok, "the output format of cout is left alone");
+
+    // Every calculation is timed, whether or not it invalidates the point
+    std::cout << std::endl << "Runtime statistics:" << std::endl;
+    Utils::LatencyHistogram like_times = nevents_like.getRuntimeHistogram();
+    Utils::LatencyHistogram rounded_times = nevents_pred_rounded.getRuntimeHistogram();
+    check(like_times.count() == 2*npoints and rounded_times.count() == npoints, "every calculation is recorded");
+    check(like_times.total() > 0 and like_times.quantile(0.5) <= like_times.max() and like_times.mean() <= like_times.max(),
+     "the recorded runtimes are consistent");
+    check(nevents_pred_rounded.getInvalidationCount() == invalid_points, "every invalidated point is counted");
+
+    // A THREAD_SAFE function that vetoes the point must not stop the run when calculated concurrently;
+    // the invalid point is saved by its functor, to be raised from the main thread afterwards.
+    std::cout << std::endl << "Invalid points and errors raised concurrently:" << std::endl;
+    nevents_pred_rounded.setOption<double>("probability_of_validity", 0.0);
+    for (auto it = concurrent.begin(); it != concurrent.end(); ++it) (*it)->reset();
+    nevents_pred_rounded.reset();
+    std::vector<functor*> vetoing = initVector<functor*>(&nevents_pred_rounded, &particle_identity, &test_sigma);
+    check(not calculate_concurrently(vetoing), "an invalid point raised concurrently is not thrown out of the parallel region");
+    invalid_point_exception* e = nevents_pred_rounded.retrieve_invalid_point_exception();
+    check(e != NULL and e->thrower() == &nevents_pred_rounded, "the invalid point is saved by the functor that raised it");
+    check(particle_identity(0) == "fakion" and test_sigma(0) == 1., "the other functions are still calculated");
+    bool rethrown = false;
+    try
+    {
+      if (e != NULL) throw(*e);
+    }
+    catch (invalid_point_exception& caught)
+    {
+      rethrown = (caught.message() == "I don't like this point.");
+    }
+    check(rethrown, "the saved invalid point can be raised again from the main thread");
+
+    // An error raised by a THREAD_SAFE function is carried out of the parallel region and rethrown
+    for (auto it = vetoing.begin(); it != vetoing.end(); ++it) (*it)->reset();
+    vetoing.push_back(&local_error);
+    std::exception_ptr error = calculate_concurrently(vetoing);
+    bool error_rethrown = false;
+    try
+    {
+      if (error) std::rethrow_exception(error);
+    }
+    catch (Gambit::exception& caught)
+    {
+      error_rethrown = (std::string(caught.what()).find("This observable is always broken.") != std::string::npos);
+    }
+    check(error_rethrown, "an error raised concurrently is carried out of the parallel region");
+
+    // Throwing inside a parallel region is only allowed at the level where a scope is open
+    bool outside_scope = true, inside_scope = true, nested = true;
+    #pragma omp parallel num_threads(2)
+    {
+      #pragma omp critical (regression_checks)
+      outside_scope = outside_scope and not Parallel_throw_scope::throw_allowed();
+      Parallel_throw_scope scope;
+      #pragma omp critical (regression_checks)
+      inside_scope = inside_scope and Parallel_throw_scope::throw_allowed();
+      omp_set_nested(1);
+      #pragma omp parallel num_threads(2)
+      {
+        #pragma omp critical (regression_checks)
+        nested = nested and not Parallel_throw_scope::throw_allowed();
+      }
+    }
+    check(outside_scope and inside_scope and nested and Parallel_throw_scope::throw_allowed(),
+     "throwing in a parallel region is allowed only within a scope opened at the same level");
+
+    // The asynchronous log sink must deliver every message, in order for each thread
+    std::cout << std::endl << "Asynchronous log sink:" << std::endl;
+    check_sink(16, true);
+    check_sink(16, false);
+
+    std::cout << std::endl;
+    if (failures > 0)
+    {
+      std::cout << "ExampleBit_A regression checks: " << failures << " FAILED." << std::endl << std::endl;
+      return 1;
+    }
+    std::cout << "ExampleBit_A regression checks passed." << std::endl << std::endl;
+
+  }
+
+  catch (std::exception& e)
+  {
+    std::cout << "ExampleBit_A regression checks have exited with fatal exception: " << e.what() << std::endl;
+    return 1;
+  }
+
+  return 0;
+
+}
@@ -47,6 +47,7 @@ START_MODULE
     #define FUNCTION nevents_pred_rounded   // Name of an observable function: integral number of events in some hypothetical process
     START_FUNCTION(int)                     // Declare that this function calculates the nevents observable as an integer variable
     DEPENDENCY(nevents, double)             // Dependencies: Integral number of events depends on floating-point nevents
+    THREAD_SAFE                             // Draws only from the per-thread random number generator, so may be run concurrently
     #undef FUNCTION
 
   #undef CAPABILITY
@@ -59,6 +60,7 @@ START_MODULE
     START_FUNCTION(double)                  // Function calculates the nevents_like likelihood as a double precision variable
     DEPENDENCY(nevents, double)             // Dependency: Likelihood calculation requires number of events
     DEPENDENCY(eventAccumulation, int)      // Depends on the accumulated events that pass the make-believe cuts in the make-believe event loop
+    THREAD_SAFE                             // Touches nothing but its result and dependencies, so may be run concurrently with other functions
     #undef FUNCTION
 
   #undef CAPABILITY
@@ -108,6 +110,7 @@ START_MODULE
 
     #define FUNCTION particle_identity      // Observable: particle ID
     START_FUNCTION(std::string)             // Function returns the identity of the particle as a string
+    THREAD_SAFE                             // Touches nothing but its result, so may be run concurrently with other functions
     #undef FUNCTION
 
   #undef CAPABILITY
@@ -138,6 +141,7 @@ START_MODULE
   START_CAPABILITY
      #define FUNCTION test_sigma
      START_FUNCTION(double)
+     THREAD_SAFE
      #undef FUNCTION
   #undef CAPABILITY
 
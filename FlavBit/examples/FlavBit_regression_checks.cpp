@@ -0,0 +1,127 @@
+//   GAMBIT: Global and Modular BSM Inference Tool
+//   *********************************************
+///  \file
+///
+///  Regression checks for the cached Cholesky
+///  multivariate Gaussian used by the FlavBit
+///  likelihoods, against the chi^2 computed
+///  with the full inverse of the covariance.
+///
+///  Returns non-zero if any check fails.
+///
+///  *********************************************
+///
+///  Authors (add name and date if you modify):
+///
+///  \author agent
+///          (agent@local)
+///  \date 2026 Oct
+///
+///  *********************************************
+
+#include <cmath>
+#include <random>
+#include <iostream>
+
+#include "gambit/FlavBit/FlavBit_types.hpp"
+#include "gambit/FlavBit/flav_utils.hpp"
+
+using namespace Gambit::FlavBit;
+
+using std::cout;
+using std::endl;
+
+namespace
+{
+
+  int failures = 0;
+
+  void check(bool passed, const std::string& what)
+  {
+    cout << (passed ? "  passed: " : "  FAILED: ") << what << endl;
+    if (not passed) failures++;
+  }
+
+  std::mt19937 gen(2017);
+
+  /// A random symmetric positive-definite n x n matrix, scaled by size
+  ublas::matrix<double> random_cov(int n, double size)
+  {
+    std::normal_distribution<double> normal;
+    ublas::matrix<double> a(n, n);
+    for (int i = 0; i < n; ++i) for (int j = 0; j < n; ++j) a(i,j) = normal(gen);
+    ublas::matrix<double> cov = ublas::prod(a, ublas::trans(a));
+    for (int i = 0; i < n; ++i) cov(i,i) += 0.1*n;
+    return size*cov;
+  }
+
+  /// diff^T (cov_exp + cov_th)^-1 diff, the way the likelihoods used to compute it
+  double chi2_by_inverse(const ublas::matrix<double>& cov_exp, const ublas::matrix<double>& cov_th,
+                         const std::vector<double>& diff)
+  {
+    ublas::matrix<double> cov = cov_exp + cov_th, inv(cov.size1(), cov.size2());
+    InvertMatrix(cov, inv);
+    double chi2 = 0;
+    for (size_t i = 0; i < diff.size(); ++i) for (size_t j = 0; j < diff.size(); ++j) chi2 += diff[i]*inv(i,j)*diff[j];
+    return chi2;
+  }
+
+  template<int N>
+  void check_gaussian()
+  {
+    cout << endl << N << " observables:" << endl;
+    std::normal_distribution<double> normal;
+    MultivariateGaussian<N> gaussian;
+    ublas::matrix<double> cov_exp = random_cov(N, 1.0);
+    check(gaussian.set_exp_cov(cov_exp), "accepts the experimental covariance");
+
+    double worst = 0;
+    ublas::matrix<double> cov_th;
+    for (int point = 0; point < 100; ++point)
+    {
+      // Change the theory covariance at every other point only, so that the cache is used
+      if (point % 2 == 0) cov_th = random_cov(N, 0.3);
+      std::vector<double> diff(N);
+      for (int i = 0; i < N; ++i) diff[i] = 3.0*normal(gen);
+      if (not gaussian.set_th_cov(cov_th))
+      {
+        check(false, "accepts a positive-definite theory covariance");
+        return;
+      }
+      double expected = chi2_by_inverse(cov_exp, cov_th, diff);
+      worst = std::max(worst, std::abs(gaussian.chi2(diff) - expected)/expected);
+    }
+    check(worst < 1e-10, "chi^2 matches the one from the inverse covariance");
+
+    ublas::matrix<double> not_pd = -random_cov(N, 10.0);
+    check(not gaussian.set_th_cov(not_pd), "rejects a total covariance that is not positive definite");
+    cov_th = random_cov(N, 0.3);
+    check(gaussian.set_th_cov(cov_th), "recovers once the covariance is positive definite again");
+
+    ublas::matrix<double> wrong(N+1, N+1);
+    check(not gaussian.fits(wrong) and not gaussian.set_exp_cov(wrong), "rejects a covariance of the wrong size");
+  }
+
+}
+
+int main()
+{
+
+  cout << endl << "Starting FlavBit regression checks" << endl;
+  cout << "----------" << endl;
+
+  // The sizes used by the b->sll, B->ll and semileptonic likelihoods
+  check_gaussian<2>();
+  check_gaussian<8>();
+  check_gaussian<48>();
+
+  cout << endl;
+  if (failures > 0)
+  {
+    cout << "FlavBit regression checks: " << failures << " FAILED." << endl << endl;
+    return 1;
+  }
+  cout << "FlavBit regression checks passed." << endl << endl;
+  return 0;
+
+}
@@ -66,6 +66,7 @@ START_MODULE
 
     #define FUNCTION SI_bsgamma
     START_FUNCTION(double)
+    THREAD_SAFE
     DEPENDENCY(SuperIso_modelinfo, parameters)
     BACKEND_REQ(bsgamma_CONV, (libsuperiso), double,(const parameters*, double))
     BACKEND_OPTION( (SuperIso, 3.6), (libsuperiso) )
@@ -73,6 +74,7 @@ START_MODULE
 
     #define FUNCTION FH_bsgamma
     START_FUNCTION(double)
+    THREAD_SAFE
     DEPENDENCY(FH_FlavourObs, fh_FlavourObs)
     #undef FUNCTION
 
@@ -84,6 +86,7 @@ START_MODULE
 
     #define FUNCTION SI_Bsmumu_untag
     START_FUNCTION(double)
+    THREAD_SAFE
     DEPENDENCY(SuperIso_modelinfo, parameters)
     BACKEND_REQ(Bsll_untag_CONV, (libsuperiso),  double, (const parameters*, int))
     BACKEND_OPTION( (SuperIso, 3.6), (libsuperiso) )
@@ -91,6 +94,7 @@ START_MODULE
 
     #define FUNCTION FH_Bsmumu
     START_FUNCTION(double)
+    THREAD_SAFE
     DEPENDENCY(FH_FlavourObs, fh_FlavourObs)
     #undef FUNCTION
 
@@ -101,6 +105,7 @@ START_MODULE
   START_CAPABILITY
     #define FUNCTION SI_Bsee_untag
     START_FUNCTION(double)
+    THREAD_SAFE
     DEPENDENCY(SuperIso_modelinfo, parameters)
     BACKEND_REQ(Bsll_untag_CONV, (libsuperiso),  double, (const parameters*, int))
     BACKEND_OPTION( (SuperIso, 3.6), (libsuperiso) )
@@ -112,6 +117,7 @@ START_MODULE
   START_CAPABILITY
     #define FUNCTION SI_Bmumu
     START_FUNCTION(double)
+    THREAD_SAFE
     DEPENDENCY(SuperIso_modelinfo, parameters)
     BACKEND_REQ(Bll_CONV, (libsuperiso),  double, (const parameters*, int))
     BACKEND_OPTION( (SuperIso, 3.6), (libsuperiso) )
@@ -123,6 +129,7 @@ START_MODULE
   START_CAPABILITY
     #define FUNCTION SI_Btaunu
     START_FUNCTION(double)
+    THREAD_SAFE
     DEPENDENCY(SuperIso_modelinfo, parameters)
     BACKEND_REQ(Btaunu, (libsuperiso), double, (const parameters*))
     BACKEND_OPTION( (SuperIso, 3.6), (libsuperiso) )
@@ -134,6 +141,7 @@ START_MODULE
   START_CAPABILITY
     #define FUNCTION SI_RD
     START_FUNCTION(double)
+    THREAD_SAFE
     DEPENDENCY(SuperIso_modelinfo, parameters)
     BACKEND_REQ(BDtaunu_BDenu, (libsuperiso), double, (const parameters*))
     BACKEND_OPTION( (SuperIso, 3.6), (libsuperiso) )
@@ -145,6 +153,7 @@ START_MODULE
   START_CAPABILITY
     #define FUNCTION SI_RDstar
     START_FUNCTION(double)
+    THREAD_SAFE
     DEPENDENCY(SuperIso_modelinfo, parameters)
     BACKEND_REQ(BDstartaunu_BDstarenu, (libsuperiso), double, (const parameters*))
     BACKEND_OPTION( (SuperIso, 3.6), (libsuperiso) )
@@ -156,6 +165,7 @@ START_MODULE
   START_CAPABILITY
     #define FUNCTION SI_Rmu
     START_FUNCTION(double)
+    THREAD_SAFE
     DEPENDENCY(SuperIso_modelinfo, parameters)
     BACKEND_REQ(Kmunu_pimunu, (libsuperiso), double, (const parameters*))
     BACKEND_OPTION( (SuperIso, 3.6), (libsuperiso) )
@@ -167,6 +177,7 @@ START_MODULE
   START_CAPABILITY
     #define FUNCTION SI_Rmu23
     START_FUNCTION(double)
+    THREAD_SAFE
     DEPENDENCY(SuperIso_modelinfo, parameters)
     BACKEND_REQ(Rmu23, (libsuperiso), double, (const parameters*))
     BACKEND_OPTION( (SuperIso, 3.6), (libsuperiso) )
@@ -178,6 +189,7 @@ START_MODULE
   START_CAPABILITY
     #define FUNCTION SI_Dstaunu
     START_FUNCTION(double)
+    THREAD_SAFE
     DEPENDENCY(SuperIso_modelinfo, parameters)
     BACKEND_REQ(Dstaunu, (libsuperiso), double, (const parameters*))
     BACKEND_OPTION( (SuperIso, 3.6), (libsuperiso) )
@@ -189,6 +201,7 @@ START_MODULE
   START_CAPABILITY
     #define FUNCTION SI_Dsmunu
     START_FUNCTION(double)
+    THREAD_SAFE
     DEPENDENCY(SuperIso_modelinfo, parameters)
     BACKEND_REQ(Dsmunu, (libsuperiso), double, (const parameters*))
     BACKEND_OPTION( (SuperIso, 3.6), (libsuperiso) )
@@ -200,6 +213,7 @@ START_MODULE
   START_CAPABILITY
     #define FUNCTION SI_Dmunu
     START_FUNCTION(double)
+    THREAD_SAFE
     DEPENDENCY(SuperIso_modelinfo, parameters)
     BACKEND_REQ(Dmunu, (libsuperiso), double, (const parameters*))
     BACKEND_OPTION( (SuperIso, 3.6), (libsuperiso) )
@@ -211,6 +225,7 @@ START_MODULE
   START_CAPABILITY
     #define FUNCTION SI_BDtaunu
     START_FUNCTION(double)
+    THREAD_SAFE
     DEPENDENCY(SuperIso_modelinfo, parameters)
     BACKEND_REQ(BRBDlnu, (libsuperiso), double, (int, int, double,  double, double*, const parameters*))
     BACKEND_OPTION( (SuperIso, 3.6), (libsuperiso) )
@@ -222,6 +237,7 @@ START_MODULE
   START_CAPABILITY
     #define FUNCTION SI_BDmunu
     START_FUNCTION(double)
+    THREAD_SAFE
     DEPENDENCY(SuperIso_modelinfo, parameters)
     BACKEND_REQ(BRBDlnu, (libsuperiso), double, (int, int, double,  double, double*, const parameters*))
     BACKEND_OPTION( (SuperIso, 3.6), (libsuperiso) )
@@ -233,6 +249,7 @@ START_MODULE
   START_CAPABILITY
     #define FUNCTION SI_BDstartaunu
     START_FUNCTION(double)
+    THREAD_SAFE
     DEPENDENCY(SuperIso_modelinfo, parameters)
     BACKEND_REQ(BRBDstarlnu, (libsuperiso), double, (int, int, double,  double, double*, const parameters*))
     BACKEND_OPTION( (SuperIso, 3.6), (libsuperiso) )
@@ -244,6 +261,7 @@ START_MODULE
   START_CAPABILITY
     #define FUNCTION SI_BDstarmunu
     START_FUNCTION(double)
+    THREAD_SAFE
     DEPENDENCY(SuperIso_modelinfo, parameters)
     BACKEND_REQ(BRBDstarlnu, (libsuperiso), double, (int, int, double,  double, double*, const parameters*))
     BACKEND_OPTION( (SuperIso, 3.6), (libsuperiso) )
@@ -255,6 +273,7 @@ START_MODULE
   START_CAPABILITY
     #define FUNCTION SI_delta0
     START_FUNCTION(double)
+    THREAD_SAFE
     DEPENDENCY(SuperIso_modelinfo, parameters)
     BACKEND_REQ(delta0_CONV, (libsuperiso),  double, (const parameters*))
     BACKEND_OPTION( (SuperIso, 3.6), (libsuperiso) )
@@ -266,6 +285,7 @@ START_MODULE
   START_CAPABILITY
     #define FUNCTION SI_BRBXsmumu_lowq2
     START_FUNCTION(double)
+    THREAD_SAFE
     DEPENDENCY(SuperIso_modelinfo, parameters)
     BACKEND_REQ(BRBXsmumu_lowq2_CONV, (libsuperiso),  double, (const parameters*))
     BACKEND_OPTION( (SuperIso, 3.6), (libsuperiso) )
@@ -277,6 +297,7 @@ START_MODULE
   START_CAPABILITY
     #define FUNCTION SI_BRBXsmumu_highq2
     START_FUNCTION(double)
+    THREAD_SAFE
     DEPENDENCY(SuperIso_modelinfo, parameters)
     BACKEND_REQ(BRBXsmumu_highq2_CONV, (libsuperiso),  double, (const parameters*))
     BACKEND_OPTION( (SuperIso, 3.6), (libsuperiso) )
@@ -288,6 +309,7 @@ START_MODULE
   START_CAPABILITY
     #define FUNCTION SI_A_BXsmumu_lowq2
     START_FUNCTION(double)
+    THREAD_SAFE
     DEPENDENCY(SuperIso_modelinfo, parameters)
     BACKEND_REQ(A_BXsmumu_lowq2_CONV, (libsuperiso),  double, (const parameters*))
     BACKEND_OPTION( (SuperIso, 3.6), (libsuperiso) )
@@ -299,6 +321,7 @@ START_MODULE
   START_CAPABILITY
     #define FUNCTION SI_A_BXsmumu_highq2
     START_FUNCTION(double)
+    THREAD_SAFE
     DEPENDENCY(SuperIso_modelinfo, parameters)
     BACKEND_REQ(A_BXsmumu_highq2_CONV, (libsuperiso),  double, (const parameters*))
     BACKEND_OPTION( (SuperIso, 3.6), (libsuperiso) )
@@ -310,6 +333,7 @@ START_MODULE
   START_CAPABILITY
     #define FUNCTION SI_A_BXsmumu_zero
     START_FUNCTION(double)
+    THREAD_SAFE
     DEPENDENCY(SuperIso_modelinfo, parameters)
     BACKEND_REQ(A_BXsmumu_zero_CONV, (libsuperiso),  double, (const parameters*))
     BACKEND_OPTION( (SuperIso, 3.6), (libsuperiso) )
@@ -321,6 +345,7 @@ START_MODULE
   START_CAPABILITY
     #define FUNCTION SI_BRBXstautau_highq2
     START_FUNCTION(double)
+    THREAD_SAFE
     DEPENDENCY(SuperIso_modelinfo, parameters)
     BACKEND_REQ(BRBXstautau_highq2_CONV, (libsuperiso),  double, (const parameters*))
     BACKEND_OPTION( (SuperIso, 3.6), (libsuperiso) )
@@ -332,6 +357,7 @@ START_MODULE
   START_CAPABILITY
     #define FUNCTION SI_A_BXstautau_highq2
     START_FUNCTION(double)
+    THREAD_SAFE
     DEPENDENCY(SuperIso_modelinfo, parameters)
     BACKEND_REQ(A_BXstautau_highq2_CONV, (libsuperiso),  double, (const parameters*))
     BACKEND_OPTION( (SuperIso, 3.6), (libsuperiso) )
@@ -341,6 +367,7 @@ START_MODULE
   // Helper macro to make the following declarations quicker
   #define KSTARMUMU_BINS                                                                                   \
     START_FUNCTION(Flav_KstarMuMu_obs)                                                                     \
+    THREAD_SAFE                                                                                            \
     DEPENDENCY(SuperIso_modelinfo, parameters)                                                             \
     BACKEND_OPTION( (SuperIso, 3.6), (libsuperiso) )                                                       \
     BACKEND_REQ(BKstarmumu_CONV, (libsuperiso), Flav_KstarMuMu_obs, (const parameters*, double, double))
@@ -398,6 +425,7 @@ START_MODULE
   START_CAPABILITY
     #define FUNCTION SI_AI_BKstarmumu
     START_FUNCTION(double)
+    THREAD_SAFE
     DEPENDENCY(SuperIso_modelinfo, parameters)
     BACKEND_REQ(SI_AI_BKstarmumu_CONV, (libsuperiso),  double, (const parameters*))
     #undef FUNCTION
@@ -408,6 +436,7 @@ START_MODULE
   START_CAPABILITY
     #define FUNCTION SI_AI_BKstarmumu_zero
     START_FUNCTION(double)
+    THREAD_SAFE
     DEPENDENCY(SuperIso_modelinfo, parameters)
     BACKEND_REQ(SI_AI_BKstarmumu_zero_CONV, (libsuperiso),  double, (const parameters*))
     #undef FUNCTION
@@ -418,6 +447,7 @@ START_MODULE
   START_CAPABILITY
     #define FUNCTION FH_FlavourObs
     START_FUNCTION(fh_FlavourObs)
+    THREAD_SAFE
     BACKEND_REQ(FHFlavour, (libfeynhiggs), void, (int&,fh_real&,fh_real&,fh_real&,fh_real&,fh_real&,fh_real&))
     BACKEND_OPTION( (FeynHiggs), (libfeynhiggs) )
     ALLOW_MODELS(MSSM63atQ, MSSM63atMGUT)
@@ -429,6 +459,7 @@ START_MODULE
   START_CAPABILITY
     #define FUNCTION FH_DeltaMs
     START_FUNCTION(double)
+    THREAD_SAFE
     DEPENDENCY(FH_FlavourObs, fh_FlavourObs)
     #undef FUNCTION
   #undef CAPABILITY
@@ -21,6 +21,9 @@
 #ifndef __flav_utils_hpp__
 #define __flav_utils_hpp__
 
+#include <cmath>
+#include <vector>
+
 #include <boost/numeric/ublas/lu.hpp>
 #include <boost/numeric/ublas/matrix.hpp>
 
@@ -56,6 +59,101 @@ namespace Gambit
       return true;
     }
 
+    /// Correlated Gaussian likelihood for a fixed number N of observables.
+    /// The covariance is the sum of a fixed experimental part, set once, and a
+    /// theory part. Its Cholesky factor is cached and only recomputed when the
+    /// theory covariance changes, so that a point with unchanged theory errors
+    /// only costs a triangular solve. All storage is fixed-size.
+    template<int N>
+    class MultivariateGaussian
+    {
+      public:
+
+        MultivariateGaussian() : exp_cov(), th_cov(), chol(), factorised(false) {}
+
+        /// Check that a covariance matrix is N x N
+        static bool fits(const boost::numeric::ublas::matrix<double>& cov)
+        {
+          return cov.size1() == N and cov.size2() == N;
+        }
+
+        /// Set the experimental covariance. Returns false if it is not N x N.
+        bool set_exp_cov(const boost::numeric::ublas::matrix<double>& cov_exp)
+        {
+          if (not fits(cov_exp)) return false;
+          for (int i = 0; i < N; ++i)
+            for (int j = 0; j < N; ++j)
+              exp_cov[i][j] = cov_exp(i,j);
+          factorised = false;
+          return true;
+        }
+
+        /// Set the theory covariance (which must be N x N; see fits), refactorising
+        /// the total covariance if it has changed. Returns false if the total
+        /// covariance is not positive definite. Only the lower triangle of cov_th
+        /// is used.
+        bool set_th_cov(const boost::numeric::ublas::matrix<double>& cov_th)
+        {
+          bool changed = not factorised;
+          for (int i = 0; i < N; ++i)
+          {
+            for (int j = 0; j <= i; ++j)
+            {
+              if (th_cov[i][j] != cov_th(i,j))
+              {
+                th_cov[i][j] = cov_th(i,j);
+                changed = true;
+              }
+            }
+          }
+          if (changed) factorised = factorise();
+          return factorised;
+        }
+
+        /// chi^2 of the differences between measurements and predictions
+        /// (requires a successful set_th_cov)
+        double chi2(const std::vector<double>& diff) const
+        {
+          // Solve L y = diff; then chi^2 = diff^T (L L^T)^-1 diff = y^T y
+          double y[N];
+          double result = 0.0;
+          for (int i = 0; i < N; ++i)
+          {
+            double sum = diff[i];
+            for (int k = 0; k < i; ++k) sum -= chol[i][k]*y[k];
+            y[i] = sum / chol[i][i];
+            result += y[i]*y[i];
+          }
+          return result;
+        }
+
+      private:
+
+        /// Cholesky decomposition of exp_cov + th_cov into chol (lower triangle)
+        bool factorise()
+        {
+          for (int j = 0; j < N; ++j)
+          {
+            double sum = exp_cov[j][j] + th_cov[j][j];
+            for (int k = 0; k < j; ++k) sum -= chol[j][k]*chol[j][k];
+            if (not (sum > 0.0)) return false;
+            chol[j][j] = std::sqrt(sum);
+            for (int i = j+1; i < N; ++i)
+            {
+              double s = exp_cov[i][j] + th_cov[i][j];
+              for (int k = 0; k < j; ++k) s -= chol[i][k]*chol[j][k];
+              chol[i][j] = s / chol[j][j];
+            }
+          }
+          return true;
+        }
+
+        double exp_cov[N][N];
+        double th_cov[N][N];
+        double chol[N][N];
+        bool factorised;
+    };
+
   }
 
 }
@@ -1082,35 +1082,29 @@ namespace Gambit
     void b2sll_likelihood(double &result)
     {
       using namespace Pipes::b2sll_likelihood;
+      // 8 angular observables in each of 6 q^2 bins
+      static MultivariateGaussian<48> gaussian;
+      static bool first = true;
 
       if (flav_debug) cout<<"Starting b2sll_likelihood"<<endl;
 
-      // Get experimental measurements
-      predictions_measurements_covariances pmc=*Dep::b2sll_M;
-
-      // Get experimental covariance
-      boost::numeric::ublas::matrix<double> cov=pmc.cov_exp;
-
-      // adding theory and experimenta covariance
-      cov+=pmc.cov_th;
-
-      //calculating a diff
-      vector<double> diff;
-      diff=pmc.diff;
-      boost::numeric::ublas::matrix<double> cov_inv(pmc.dim, pmc.dim);
-      InvertMatrix(cov, cov_inv);
+      const predictions_measurements_covariances& pmc = *Dep::b2sll_M;
 
-      double Chi2=0;
-
-      for (int i=0; i < pmc.dim; ++i)
+      // Set the experimental covariance once; the Cholesky factor of the total
+      // covariance is only recomputed when the theory covariance changes.
+      if (first)
       {
-        for (int j=0; j<pmc.dim; ++j)
-        {
-          Chi2+= diff[i] * cov_inv(i,j)*diff[j] ;
-        }
+        if (not gaussian.set_exp_cov(pmc.cov_exp))
+          FlavBit_error().raise(LOCAL_INFO, "Unexpected number of observables in b2sll_likelihood.");
+        first = false;
       }
+      if (not gaussian.fits(pmc.cov_th))
+        FlavBit_error().raise(LOCAL_INFO, "Unexpected number of observables in b2sll_likelihood.");
+      // The theory covariance depends on the point, so failing to factorise it invalidates the point.
+      if (not gaussian.set_th_cov(pmc.cov_th))
+        invalid_point().raise("Covariance matrix in b2sll_likelihood is not positive definite.");
 
-      result=-0.5*Chi2;
+      result = -0.5*gaussian.chi2(pmc.diff);
 
       if (flav_debug) cout<<"Finished b2sll_likelihood"<<endl;
       if (flav_debug_LL) cout<<"Likelihood result b2sll_likelihood : "<< result<<endl;
@@ -1264,35 +1258,28 @@ namespace Gambit
     void b2ll_likelihood(double &result)
     {
       using namespace Pipes::b2ll_likelihood;
+      // BR(Bs->mumu) and BR(B0->mumu)
+      static MultivariateGaussian<2> gaussian;
+      static bool first = true;
 
       if (flav_debug) cout<<"Starting b2ll_likelihood"<<endl;
 
-      predictions_measurements_covariances pmc = *Dep::b2ll_M;
-
-      boost::numeric::ublas::matrix<double> cov=pmc.cov_exp;
-
-      // adding theory and experimental covariance
-      cov+=pmc.cov_th;
-
-      //calculating a diff
-      vector<double> diff;
-      diff=pmc.diff;
-
-      boost::numeric::ublas::matrix<double> cov_inv(pmc.dim, pmc.dim);
-      InvertMatrix(cov, cov_inv);
+      const predictions_measurements_covariances& pmc = *Dep::b2ll_M;
 
-      // calculating the chi2
-      double Chi2=0;
-
-      for (int i=0; i < pmc.dim; ++i)
+      // Set the experimental covariance once; the Cholesky factor of the total
+      // covariance is only recomputed when the theory covariance changes.
+      if (first)
       {
-        for (int j=0; j<pmc.dim; ++j)
-        {
-          Chi2+= diff[i] * cov_inv(i,j)*diff[j];
-        }
+        if (not gaussian.set_exp_cov(pmc.cov_exp))
+          FlavBit_error().raise(LOCAL_INFO, "Unexpected number of observables in b2ll_likelihood.");
+        first = false;
       }
+      if (not gaussian.fits(pmc.cov_th))
+        FlavBit_error().raise(LOCAL_INFO, "Unexpected number of observables in b2ll_likelihood.");
+      if (not gaussian.set_th_cov(pmc.cov_th))
+        invalid_point().raise("Covariance matrix in b2ll_likelihood is not positive definite.");
 
-      result=-0.5*Chi2;
+      result = -0.5*gaussian.chi2(pmc.diff);
 
       if (flav_debug) cout<<"Finished b2ll_likelihood"<<endl;
       if (flav_debug_LL) cout<<"Likelihood result b2ll_likelihood : "<< result<<endl;
@@ -1401,33 +1388,28 @@ namespace Gambit
     void SL_likelihood(double &result)
     {
       using namespace Pipes::SL_likelihood;
+      // See SL_measurements for the list of observables
+      static MultivariateGaussian<8> gaussian;
+      static bool first = true;
 
       if (flav_debug) cout<<"Starting SL_likelihood"<<endl;
 
-      predictions_measurements_covariances pmc = *Dep::SL_M;
-
-      boost::numeric::ublas::matrix<double> cov=pmc.cov_exp;
+      const predictions_measurements_covariances& pmc = *Dep::SL_M;
 
-      // adding theory and experimental covariance
-      cov+=pmc.cov_th;
-
-      //calculating a diff
-      vector<double> diff;
-      diff=pmc.diff;
-
-      boost::numeric::ublas::matrix<double> cov_inv(pmc.dim, pmc.dim);
-      InvertMatrix(cov, cov_inv);
-
-      double Chi2=0;
-      for (int i=0; i < pmc.dim; ++i)
+      // Set the experimental covariance once; the Cholesky factor of the total
+      // covariance is only recomputed when the theory covariance changes.
+      if (first)
       {
-        for (int j=0; j<pmc.dim; ++j)
-        {
-          Chi2+= diff[i] * cov_inv(i,j)*diff[j];
-        }
+        if (not gaussian.set_exp_cov(pmc.cov_exp))
+          FlavBit_error().raise(LOCAL_INFO, "Unexpected number of observables in SL_likelihood.");
+        first = false;
       }
+      if (not gaussian.fits(pmc.cov_th))
+        FlavBit_error().raise(LOCAL_INFO, "Unexpected number of observables in SL_likelihood.");
+      if (not gaussian.set_th_cov(pmc.cov_th))
+        invalid_point().raise("Covariance matrix in SL_likelihood is not positive definite.");
 
-      result=-0.5*Chi2;
+      result = -0.5*gaussian.chi2(pmc.diff);
 
       if (flav_debug) cout<<"Finished SL_likelihood"<<endl;
 
@@ -0,0 +1,117 @@
+//   GAMBIT: Global and Modular BSM Inference Tool
+//   *********************************************
+///  \file
+///
+///  Asynchronous delivery of log messages to the
+///  loggers, via per-thread ring buffers drained
+///  by a dedicated writer thread.
+///
+///  *********************************************
+///
+///  Authors (add name and date if you modify):
+///
+///  \author agent
+///          (agent@local)
+///  \date 2026 Oct
+///
+///  *********************************************
+
+#ifndef __async_log_sink_hpp__
+#define __async_log_sink_hpp__
+
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <functional>
+#include <condition_variable>
+
+#include "gambit/Logs/logging.hpp"
+
+namespace Gambit
+{
+
+  namespace Logging
+  {
+
+    /// Collects log messages from many threads and hands them to a delivery
+    /// function on a single writer thread.
+    ///
+    /// Each thread that pushes a message is given its own fixed-length
+    /// single-producer/single-consumer ring buffer the first time it does so
+    /// (whatever its OpenMP thread number, which is not unique across nested
+    /// regions or threads started outside OpenMP), so pushing a message never
+    /// takes a lock after that. When a buffer is full, the pushing thread either
+    /// waits for the writer to make space or drops the message (and counts it),
+    /// depending on the policy. The buffers live as long as the sink.
+    class AsyncLogSink
+    {
+      public:
+        typedef std::function<void(const Message&)> Delivery;
+
+        /// Starts the writer thread
+        AsyncLogSink(std::size_t buffer_length, bool block_when_full, const Delivery& deliver);
+
+        /// Delivers all queued messages and stops the writer thread
+        ~AsyncLogSink();
+
+        /// Queue a message in the calling thread's buffer
+        void push(Message&& mail);
+
+        /// Deliver all messages queued so far, on the calling thread, before returning
+        void flush();
+
+        /// Number of messages dropped so far because a buffer was full
+        unsigned long long dropped() const { return n_dropped; }
+
+      private:
+        struct Ring
+        {
+          Ring(std::size_t length) : slots(length, Message(std::string(), std::set<int>())), head(0), tail(0) {}
+          std::vector<Message> slots;
+          /// Number of messages taken out by the writer thread
+          std::atomic<std::size_t> head;
+          /// Number of messages put in by the owning thread
+          std::atomic<std::size_t> tail;
+        };
+
+        /// The calling thread's buffer, created and registered on first use
+        Ring& local_ring();
+
+        /// Deliver all messages currently queued; returns false if there were none.
+        /// Must be called with drain_mtx held.
+        bool drain();
+
+        /// Main loop of the writer thread
+        void run();
+
+        /// Number identifying this sink to the threads' cached buffer pointers
+        const unsigned long long id;
+        const std::size_t length;
+        const bool block;
+        const Delivery deliver;
+        std::atomic<unsigned long long> n_dropped;
+        std::atomic<bool> stop;
+
+        /// Buffers of all threads that have pushed messages, guarded by rings_mtx
+        std::vector<std::unique_ptr<Ring>> rings;
+        std::mutex rings_mtx;
+
+        /// Held by whichever thread is delivering messages (normally the writer thread)
+        std::mutex drain_mtx;
+        /// Buffers being drained; only used with drain_mtx held
+        std::vector<Ring*> draining;
+
+        /// Used only to put the writer thread to sleep when there is nothing to do
+        std::mutex mtx;
+        std::condition_variable wake;
+
+        std::thread thread;
+    };
+
+  }
+
+}
+
+#endif
@@ -67,6 +67,10 @@ namespace Gambit
      LogMaster& operator<<(LogMaster&, const manip2);
      LogMaster& operator<<(LogMaster&, const manip3);
 
+     // Check whether the message being streamed on this thread can still be
+     // logged (if not, there is no point formatting anything more into it)
+     bool accepting_input(LogMaster&);
+
      // Stream function to convert everything else to strings before
      // feeding into LogMaster (this way no-one needs to have the full
      // declaration of the LogMaster class; I think the overhead
@@ -77,6 +81,7 @@ namespace Gambit
      LogMaster& operator << (LogMaster& logobj, const TYPE& input)
      {
        using ::Gambit::operator<<; // Unhide operator overloads in Gambit scope
+       if (not accepting_input(logobj)) return logobj;
        std::stringstream ss;
        ss << input;
        logobj << ss.str();
@@ -43,6 +43,7 @@ namespace Gambit
     /// Forward declarations
     class Message;
     class BaseLogger;
+    class AsyncLogSink;
 
     /// Logging "controller" object
     /// Keeps track of the various "Logger" objects
@@ -94,6 +95,10 @@ namespace Gambit
         void input(const manip2);
         void input(const manip3);
 
+        /// Check whether the message being streamed on this thread can still be
+        /// logged; if not, further input to it need not even be formatted
+        bool accepting_input();
+
         /// Main logging function (user-friendly overloaded version)
         // Need a bunch of overloads of this to deal with
         void send(const std::string&);
@@ -122,6 +127,9 @@ namespace Gambit
         void send(const std::ostringstream&, std::set<LogTag>&);
         void send(const std::ostringstream&, std::set<int>&);
 
+        /// Write out all messages waiting to be delivered (call before stopping the program abruptly)
+        void flush();
+
         /// Set the internal variables tracking which module and/or backend is currently running
         void entering_module(int);
         void leaving_module();
@@ -137,18 +145,47 @@ namespace Gambit
         /// Choose whether "Debug" tagged log messages will be ignored (i.e. not logged)
         void set_log_debug_messages(bool flag) {log_debug_messages=flag;}
 
+        /// Choose whether messages are written out by a separate writer thread, with
+        /// a buffer of the given length for each thread, and whether threads wait
+        /// (rather than dropping messages) when their buffer is full
+        void set_async_logging(bool flag, std::size_t buffer_length, bool block_when_full)
+        {
+          async_logging=flag;
+          async_buffer_length=buffer_length;
+          async_block_when_full=block_when_full;
+        }
+
         /// @}
 
       private:
         /// Empty the backlog buffer to the 'send' function
         void empty_backlog();
 
+        /// Rebuild the tag bitmasks used for filtering messages; must be called
+        /// whenever the loggers or the ignore set change
+        void build_tag_masks();
+
+        /// Bitmask of the filter-relevant tags in a set of tags
+        unsigned long long tag_mask(const std::set<int>&) const;
+
+        /// Check whether a message with the given tag bitmask would be logged anywhere
+        bool wanted(unsigned long long) const;
+
         /// Map to identify loggers
         std::map<std::set<int>,BaseLogger*> loggers;
 
         /// Global ignore set; if these tags/integers are seen, ignore messages containing them.
         std::set<int> ignore;
 
+        /// @{ Bitmask versions of the above, so that messages can be filtered
+        /// without any set operations. Each tag that appears in a logger key, in
+        /// the ignore set or as an echo tag gets its own bit; all others get none.
+        std::vector<unsigned long long> tag_bits;
+        unsigned long long ignore_mask;
+        unsigned long long echo_mask;
+        std::vector<std::pair<unsigned long long, BaseLogger*>> logger_masks;
+        /// @}
+
         /// Flag to set whether loggers have been initialised not
         bool loggers_readyQ;
 
@@ -161,6 +198,13 @@ namespace Gambit
         /// Flag to ignore Debug tagged messages
         bool log_debug_messages;
 
+        /// @{ Asynchronous delivery options, and the sink doing it (NULL if synchronous)
+        bool async_logging;
+        std::size_t async_buffer_length;
+        bool async_block_when_full;
+        AsyncLogSink* sink;
+        /// @}
+
         /// MPI variables
         int MPIrank;
         int MPIsize;
@@ -177,6 +221,8 @@ namespace Gambit
         /// Buffer variables needed for stream logging
         std::ostringstream* stream;
         std::set<int>* streamtags;
+        /// Flags marking the message being streamed as one that will not be logged
+        bool* streamdiscard;
 
         /// Messages sent before logger objects are created will be buffered
         /// Same for messages sent while inside omp parallel blocks
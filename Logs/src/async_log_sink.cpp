@@ -0,0 +1,151 @@
+//   GAMBIT: Global and Modular BSM Inference Tool
+//   *********************************************
+///  \file
+///
+///  Asynchronous delivery of log messages to the
+///  loggers, via per-thread ring buffers drained
+///  by a dedicated writer thread.
+///
+///  *********************************************
+///
+///  Authors (add name and date if you modify):
+///
+///  \author agent
+///          (agent@local)
+///  \date 2026 Oct
+///
+///  *********************************************
+
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+
+#include "gambit/Logs/async_log_sink.hpp"
+
+namespace Gambit
+{
+
+  namespace Logging
+  {
+
+    /// Source of the numbers identifying sinks
+    static std::atomic<unsigned long long>& next_sink_id()
+    {
+      static std::atomic<unsigned long long> next(1);
+      return next;
+    }
+
+    AsyncLogSink::AsyncLogSink(std::size_t buffer_length, bool block_when_full, const Delivery& deliver)
+      : id       (next_sink_id()++)
+      , length   (buffer_length > 0 ? buffer_length : 1)
+      , block    (block_when_full)
+      , deliver  (deliver)
+      , n_dropped(0)
+      , stop     (false)
+    {
+      thread = std::thread(&AsyncLogSink::run, this);
+    }
+
+    AsyncLogSink::~AsyncLogSink()
+    {
+      stop = true;
+      wake.notify_one();
+      thread.join();
+    }
+
+    AsyncLogSink::Ring& AsyncLogSink::local_ring()
+    {
+      // Sinks are told apart by id rather than address, so that a thread never
+      // uses a buffer cached from an earlier sink that has since been deleted.
+      static thread_local unsigned long long owner = 0;
+      static thread_local Ring* ring = NULL;
+      if(owner != id)
+      {
+        std::lock_guard<std::mutex> lock(rings_mtx);
+        rings.emplace_back(new Ring(length));
+        ring = rings.back().get();
+        owner = id;
+      }
+      return *ring;
+    }
+
+    void AsyncLogSink::push(Message&& mail)
+    {
+      Ring& ring = local_ring();
+      const std::size_t tail = ring.tail.load(std::memory_order_relaxed);
+      while(tail - ring.head.load(std::memory_order_acquire) >= length)
+      {
+        if(not block)
+        {
+          n_dropped++;
+          return;
+        }
+        wake.notify_one();
+        std::this_thread::yield();
+      }
+      ring.slots[tail % length] = std::move(mail);
+      ring.tail.store(tail + 1, std::memory_order_release);
+    }
+
+    void AsyncLogSink::flush()
+    {
+      std::lock_guard<std::mutex> lock(drain_mtx);
+      drain();
+    }
+
+    bool AsyncLogSink::drain()
+    {
+      {
+        std::lock_guard<std::mutex> lock(rings_mtx);
+        draining.clear();
+        for(auto& ring : rings) draining.push_back(ring.get());
+      }
+      bool delivered = false;
+      for(Ring* ring : draining)
+      {
+        const std::size_t head = ring->head.load(std::memory_order_relaxed);
+        const std::size_t tail = ring->tail.load(std::memory_order_acquire);
+        for(std::size_t j = head; j != tail; j++)
+        {
+          // An exception cannot be passed back to whoever logged the message, so just report it.
+          try { deliver(ring->slots[j % length]); }
+          catch(std::exception& e)
+          {
+            std::cerr << "Error delivering log message: " << e.what() << std::endl;
+          }
+        }
+        // Only release the slots once their messages have been written out
+        if(tail != head)
+        {
+          ring->head.store(tail, std::memory_order_release);
+          delivered = true;
+        }
+      }
+      return delivered;
+    }
+
+    void AsyncLogSink::run()
+    {
+      while(true)
+      {
+        bool delivered;
+        {
+          std::lock_guard<std::mutex> lock(drain_mtx);
+          delivered = drain();
+        }
+        if(delivered) continue;
+        // Nothing was queued; finish if asked to (one last drain catches any
+        // message pushed in the meantime), otherwise wait a little.
+        if(stop)
+        {
+          flush();
+          return;
+        }
+        std::unique_lock<std::mutex> lock(mtx);
+        wake.wait_for(lock, std::chrono::milliseconds(10));
+      }
+    }
+
+  }
+
+}
@@ -88,6 +88,12 @@ namespace Gambit
         return logobj;
      }
 
+     /// Check whether streamed input is still wanted
+     bool accepting_input(LogMaster& logobj)
+     {
+        return logobj.accepting_input();
+     }
+
      /// @}
   }
  
@@ -32,6 +32,7 @@
 // Gambit
 #include "gambit/Logs/logmaster.hpp"
 #include "gambit/Logs/logging.hpp"
+#include "gambit/Logs/async_log_sink.hpp"
 #include "gambit/Utils/signal_helpers.hpp"
 #include "gambit/Utils/util_functions.hpp"
 #include "gambit/Utils/standalone_error_handlers.hpp"
@@ -57,16 +58,24 @@ namespace Gambit
       , silenced       (false)
       , separate_file_per_process(true)
       , log_debug_messages(false)
+      , async_logging  (false)
+      , async_buffer_length(1024)
+      , async_block_when_full(true)
+      , sink           (NULL)
       , MPIrank        (0)
       , MPIsize        (1)
       , globlMaxThreads(omp_get_max_threads())
       , current_module (NULL)
       , current_backend(NULL)
+      , ignore_mask    (0)
+      , echo_mask      (0)
       , stream         (NULL)
       , streamtags     (NULL)
+      , streamdiscard  (NULL)
       , backlog        (NULL)
     {
       // Note! MPIrank and MPIsize will not be correct until initialisation occurs!
+      build_tag_masks();
     }
 
     /// Alternate constructor
@@ -77,16 +86,24 @@ namespace Gambit
       , silenced       (false)
       , separate_file_per_process(true)
       , log_debug_messages(false)
+      , async_logging  (false)
+      , async_buffer_length(1024)
+      , async_block_when_full(true)
+      , sink           (NULL)
       , MPIrank        (0)
       , MPIsize        (1)
       , globlMaxThreads(omp_get_max_threads())
       , current_module (NULL)
       , current_backend(NULL)
+      , ignore_mask    (0)
+      , echo_mask      (0)
       , stream         (NULL)
       , streamtags     (NULL)
+      , streamdiscard  (NULL)
       , backlog        (NULL)
     {
       // Note! MPIrank and MPIsize will not be correct until initialisation occurs!
+      build_tag_masks();
     }
 
     // Initialise dynamic memory required for thread safety
@@ -108,6 +125,18 @@ namespace Gambit
           if(streamtags==NULL) streamtags = new std::set<int>[n];
         }
       }
+      if(streamdiscard==NULL)
+      {
+        #pragma omp critical(logmaster_common_init_memory_streamdiscard)
+        {
+          if(streamdiscard==NULL)
+          {
+            bool* flags = new bool[n];
+            std::fill(flags, flags+n, false);
+            streamdiscard = flags;
+          }
+        }
+      }
       if(backlog==NULL)
       {
         #pragma omp critical(logmaster_common_init_memory_backlog)
@@ -154,6 +183,7 @@ namespace Gambit
              std::set<int> deftag;
              deftag.insert(def);
              loggers[deftag] = deflogger;
+             build_tag_masks();
              loggers_readyQ = true;
              if (verbose) std::cout<<"Log messages will be delivered to '" << GAMBIT_DIR << "/scratch/default.log'"<<std::endl;
            }
@@ -195,12 +225,25 @@ namespace Gambit
            }
          }
 
+         // Write out everything still queued for asynchronous delivery, and go back to delivering synchronously
+         if (sink != NULL)
+         {
+           unsigned long long dropped = sink->dropped();
+           delete sink;
+           sink = NULL;
+           if (dropped > 0)
+           {
+             *this << "Asynchronous logging dropped " << dropped << " messages because the buffers were full." << warn << EOM;
+           }
+         }
+
          // Output the message backlogs if needed
          emit_backlog(true);
 
        }
 
        // Delete logger objects
+       if (sink != NULL) delete sink;
        for(std::map<std::set<int>,BaseLogger*>::iterator keyvalue = loggers.begin(); keyvalue != loggers.end(); ++keyvalue)
        {
          // Ensure their filestreams have been flushed before we delete them.
@@ -213,6 +256,7 @@ namespace Gambit
        // Delete the thread variables
        if (stream != NULL)         delete [] stream;
        if (streamtags != NULL)     delete [] streamtags;
+       if (streamdiscard != NULL)  delete [] streamdiscard;
        if (backlog != NULL)        delete [] backlog;
        if (current_module !=NULL)  delete [] current_module;
        if (current_backend !=NULL) delete [] current_backend;
@@ -321,8 +365,18 @@ namespace Gambit
        }
        *this << EOM; // End message about loggers.
        // Set logger objects ready for use and dump any buffered messages
+       build_tag_masks();
        loggers_readyQ = true;
        empty_backlog();
+
+       // From now on, hand messages over to a writer thread if requested
+       if(async_logging and sink == NULL)
+       {
+         sink = new AsyncLogSink(async_buffer_length, async_block_when_full,
+                                 [this](const Message& mail) { finalsend(mail); });
+         *this << LogTag::logs << LogTag::debug << "Log messages will be delivered by a separate writer thread (buffer length "
+               << async_buffer_length << " per thread; " << (async_block_when_full ? "waiting" : "dropping messages") << " when full)." << EOM;
+       }
     }
 
     // Overload for initialise to allow input of logging instructions via maps
@@ -398,6 +452,66 @@ namespace Gambit
        }
     }
 
+    /// Rebuild the tag bitmasks used for filtering messages
+    void LogMaster::build_tag_masks()
+    {
+       // Collect all tags that can influence where (or whether) a message goes
+       std::set<int> relevant(ignore);
+       relevant.insert(repeat_to_cout);
+       relevant.insert(repeat_to_cerr);
+       for(std::map<std::set<int>,BaseLogger*>::iterator keyvalue = loggers.begin(); keyvalue != loggers.end(); ++keyvalue)
+       {
+         relevant.insert(keyvalue->first.begin(), keyvalue->first.end());
+       }
+       if(relevant.size() > std::numeric_limits<unsigned long long>::digits)
+       {
+         std::ostringstream errormsg;
+         errormsg << "Too many different LogTags (" << relevant.size() << ") used in the logger redirection rules; at most "
+                  << std::numeric_limits<unsigned long long>::digits << " are supported.";
+         logging_error().raise(LOCAL_INFO,errormsg.str());
+       }
+
+       // Give each of them a bit
+       tag_bits.assign(relevant.empty() ? 0 : *relevant.rbegin()+1, 0);
+       unsigned long long bit = 1;
+       for(std::set<int>::iterator tag = relevant.begin(); tag != relevant.end(); ++tag, bit <<= 1)
+       {
+         if(*tag >= 0) tag_bits[*tag] = bit;
+       }
+
+       ignore_mask = tag_mask(ignore);
+       echo_mask = tag_bits[repeat_to_cout] | tag_bits[repeat_to_cerr];
+       logger_masks.clear();
+       for(std::map<std::set<int>,BaseLogger*>::iterator keyvalue = loggers.begin(); keyvalue != loggers.end(); ++keyvalue)
+       {
+         logger_masks.push_back(std::make_pair(tag_mask(keyvalue->first), keyvalue->second));
+       }
+    }
+
+    /// Bitmask of the filter-relevant tags in a set of tags
+    unsigned long long LogMaster::tag_mask(const std::set<int>& tags) const
+    {
+       unsigned long long mask = 0;
+       for(std::set<int>::const_iterator tag = tags.begin(); tag != tags.end(); ++tag)
+       {
+         if(*tag >= 0 and *tag < (int)tag_bits.size()) mask |= tag_bits[*tag];
+       }
+       return mask;
+    }
+
+    /// Check whether a message with the given tag bitmask would be logged anywhere
+    bool LogMaster::wanted(unsigned long long mask) const
+    {
+       if(silenced or (mask & ignore_mask)) return false;
+       if(mask & echo_mask) return true;
+       // A logger takes the message if all of its tags are among the message tags
+       for(std::vector<std::pair<unsigned long long, BaseLogger*>>::const_iterator lm = logger_masks.begin(); lm != logger_masks.end(); ++lm)
+       {
+         if((lm->first & ~mask) == 0) return true;
+       }
+       return false;
+    }
+
     /// Main logging function (user-friendly overloaded version)
     // Need a bunch of overloads of this to deal with
     void LogMaster::send(const std::string& message)
@@ -554,6 +668,19 @@ namespace Gambit
          tags.insert(current_backend[i]);
        }
 
+       // Once the loggers exist, drop unwanted messages before building anything from them
+       if(loggers_readyQ and not wanted(tag_mask(tags))) return;
+
+       // If delivery is asynchronous, queue the message for the writer thread (also from parallel blocks)
+       if(sink != NULL)
+       {
+         const bool is_fatal = tags.find(fatal) != tags.end();
+         sink->push(Message(message,tags)); //time stamp automatically added NOW
+         // Make sure a fatal error (and everything logged before it) is written out before anything stops the program
+         if(is_fatal) sink->flush();
+         return;
+       }
+
        // If the loggers have not yet been initialised, buffer the message
        if(omp_get_level()!=0 or not loggers_readyQ)
        {
@@ -566,13 +693,21 @@ namespace Gambit
        }
     } // end LogHub::send
 
+    /// Deliver all messages queued for asynchronous delivery, and (outside parallel blocks) the backlog
+    void LogMaster::flush()
+    {
+       if(sink != NULL) sink->flush();
+       if(loggers_readyQ and omp_get_level()==0) empty_backlog();
+    }
+
     /// Version of send function used by buffer dump; skips all the tag modification stuff
     void LogMaster::finalsend(const Message& mail)
     {
        // Check the 'ignore' set; if any of the specified tags are in this set, then do nothing more, i.e. ignore the message.
        // (need to add extra stuff to ignore modules and backends, since these cannot be normal tags)
-       // Also ignore the message if logs have been 'silenced'.
-       if( silenced or not Utils::is_disjoint(mail.tags, ignore) )
+       // Also ignore the message if logs have been 'silenced', or if no logger would take it.
+       const unsigned long long mask = tag_mask(mail.tags);
+       if( not wanted(mask) )
        {
          //std::cout<<"Ignoring message..."<<std::endl;
          return;
@@ -589,15 +724,13 @@ namespace Gambit
 
        // Main loop for message distribution
 
-       // Loop through the map of loggers and see if any of them match subsets of 'key'.
-       for(std::map<std::set<int>,BaseLogger*>::iterator keyvalue = loggers.begin(); keyvalue != loggers.end(); ++keyvalue)
+       // Loop through the loggers and see if any of their keys are subsets of the message tags.
+       for(std::vector<std::pair<unsigned long long, BaseLogger*>>::iterator lm = logger_masks.begin(); lm != logger_masks.end(); ++lm)
        {
-         // if set1 includes set2
-         if( std::includes(mail.tags.begin(), mail.tags.end(),
-                           (keyvalue->first).begin(), (keyvalue->first).end()) )
+         if( (lm->first & ~mask) == 0 )
          {
            // Matching logger object found! Send it the sorted message object
-           (keyvalue->second)->write(sortedmsg);
+           (lm->second)->write(sortedmsg);
          }
        } //end loop over loggers
     } // end LogMaster::finalsend
@@ -648,7 +781,22 @@ namespace Gambit
     void LogMaster::input(const LogTag& tag)
     {
        init_memory();
-       streamtags[omp_get_thread_num()].insert(tag);
+       int i = omp_get_thread_num();
+       streamtags[i].insert(tag);
+       // If this tag means the message will never be logged, stop collecting its text
+       const unsigned long long bit = (tag >= 0 and tag < (int)tag_bits.size()) ? tag_bits[tag] : 0;
+       if(not streamdiscard[i] and (silenced or (bit & ignore_mask)))
+       {
+         streamdiscard[i] = true;
+         stream[i].str(std::string());
+       }
+    }
+
+    /// Check whether the message being streamed on this thread can still be logged
+    bool LogMaster::accepting_input()
+    {
+       init_memory();
+       return not streamdiscard[omp_get_thread_num()];
     }
 
     /// Handle end of message character
@@ -656,37 +804,46 @@ namespace Gambit
     {
        init_memory();
        size_t i = omp_get_thread_num();
-       // Collect the stream and tags, then send the message
-       send(stream[i].str(), streamtags[i]);
+       // Collect the stream and tags, then send the message (unless it is already known to be unwanted)
+       if(not streamdiscard[i]) send(stream[i].str(), streamtags[i]);
        // Clear stream and tags for next message;
        stream[i].str(std::string()); //TODO: check that this works properly on all compilers...
        streamtags[i].clear();
+       streamdiscard[i] = false;
     }
 
     /// Handle strings
     void LogMaster::input(const std::string& in)
     {
        init_memory();
-       stream[omp_get_thread_num()] << in;
+       int i = omp_get_thread_num();
+       if(streamdiscard[i]) return;
+       stream[i] << in;
     }
 
     /// Handle various stream manipulators
     void LogMaster::input(const manip1 fp)
     {
        init_memory();
-       stream[omp_get_thread_num()] << fp;
+       int i = omp_get_thread_num();
+       if(streamdiscard[i]) return;
+       stream[i] << fp;
     }
 
     void LogMaster::input(const manip2 fp)
     {
        init_memory();
-       stream[omp_get_thread_num()] << fp;
+       int i = omp_get_thread_num();
+       if(streamdiscard[i]) return;
+       stream[i] << fp;
     }
 
     void LogMaster::input(const manip3 fp)
     {
        init_memory();
-       stream[omp_get_thread_num()] << fp;
+       int i = omp_get_thread_num();
+       if(streamdiscard[i]) return;
+       stream[i] << fp;
     }
 
     /// @}
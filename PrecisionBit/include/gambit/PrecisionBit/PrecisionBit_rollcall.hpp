@@ -46,6 +46,7 @@ START_MODULE
   START_CAPABILITY
     #define FUNCTION FH_PrecisionObs
     START_FUNCTION(fh_PrecisionObs)
+    THREAD_SAFE
     DEPENDENCY(FH_Couplings_output, fh_Couplings)
     BACKEND_REQ(FHConstraints, (libfeynhiggs), void, (int&,fh_real&,fh_real&,fh_real&,fh_real&,
                 fh_real&,fh_real&,fh_real&,fh_real&,fh_real&,int&))
@@ -113,6 +114,7 @@ START_MODULE
   START_CAPABILITY
     #define FUNCTION lnL_W_mass_chi2
     START_FUNCTION(double)
+    THREAD_SAFE
     DEPENDENCY(mw, triplet<double>)
     #undef FUNCTION
   #undef CAPABILITY
@@ -122,6 +124,7 @@ START_MODULE
   START_CAPABILITY
     #define FUNCTION lnL_h_mass_chi2
     START_FUNCTION(double)
+    THREAD_SAFE
     DEPENDENCY(mh, triplet<double>)
     #undef FUNCTION
   #undef CAPABILITY
@@ -131,6 +134,7 @@ START_MODULE
   START_CAPABILITY
     #define FUNCTION lnL_sinW2_eff_chi2
     START_FUNCTION(double)
+    THREAD_SAFE
     DEPENDENCY(prec_sinW2_eff, triplet<double>)
     #undef FUNCTION
   #undef CAPABILITY
@@ -141,6 +145,7 @@ START_MODULE
   START_CAPABILITY
     #define FUNCTION lnL_gm2_chi2
     START_FUNCTION(double)
+    THREAD_SAFE
     DEPENDENCY(muon_gm2, triplet<double>)
     DEPENDENCY(muon_gm2_SM, triplet<double>)
     #undef FUNCTION
@@ -151,6 +156,7 @@ START_MODULE
   START_CAPABILITY
     #define FUNCTION lnL_deltarho_chi2
     START_FUNCTION(double)
+    THREAD_SAFE
     DEPENDENCY(deltarho, triplet<double>)
     #undef FUNCTION
   #undef CAPABILITY
@@ -175,6 +181,7 @@ START_MODULE
     // Muon g-2 -- Using SuperIso
     #define FUNCTION SI_muon_gm2
     START_FUNCTION(triplet<double>)
+    THREAD_SAFE
     DEPENDENCY(SuperIso_modelinfo, parameters)
     BACKEND_REQ(muon_gm2, (libsuperiso), double, (const parameters*))
     BACKEND_OPTION( (SuperIso, 3.6), (libsuperiso) )
@@ -183,6 +190,7 @@ START_MODULE
     // Muon g-2 -- Using gm2calc
     #define FUNCTION GM2C_SUSY
     START_FUNCTION(triplet<double>)
+    THREAD_SAFE
     NEEDS_CLASSES_FROM(gm2calc, default)
     DEPENDENCY(MSSM_spectrum, Spectrum)
     BACKEND_REQ(calculate_amu_1loop, (libgm2calc), double, (const gm2calc::MSSMNoFV_onshell&))
@@ -201,11 +209,13 @@ START_MODULE
     // SM muon g-2, based on e+e- data
     #define FUNCTION gm2_SM_ee
     START_FUNCTION(triplet<double>)
+    THREAD_SAFE
     #undef FUNCTION
 
     // SM muon g-2, based on tau+tau- data
     #define FUNCTION gm2_SM_tautau
     START_FUNCTION(triplet<double>)
+    THREAD_SAFE
     #undef FUNCTION
 
   #undef CAPABILITY
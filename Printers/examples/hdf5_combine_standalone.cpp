@@ -0,0 +1,121 @@
+//  GAMBIT: Global and Modular BSM Inference Tool
+//  *********************************************
+///  \file
+///
+///  Standalone driver for the HDF5 combine
+///  tools. Combines the temporary per-rank output
+///  files of the hdf5 printer ('<file>_temp_<i>')
+///  into a single file, outside of GAMBIT, e.g.
+///  after a run was killed before finalisation.
+///
+///  *********************************************
+///
+///  Authors (add name and date if you modify):
+///
+///  \author agent
+///          (agent@local)
+///  \date 2026 Oct
+///
+///  *********************************************
+
+#include <string>
+#include <cstdlib>
+#include <iostream>
+
+#include <stdlib.h>
+#include <getopt.h>
+
+#include "gambit/Printers/printers/hdf5printer/hdf5_combine_tools.hpp"
+#include "gambit/Utils/util_functions.hpp"
+
+using namespace Gambit;
+using namespace Gambit::Printers;
+
+void usage(const char* name)
+{
+  std::cout << "Usage: " << name << " [options] <file> <group> <N>" << std::endl
+            << std::endl
+            << "Combines the temporary hdf5 printer output files <file>_temp_0 ... <file>_temp_<N-1>" << std::endl
+            << "(datasets in <group>) into a single file. The temporary files are deleted afterwards." << std::endl
+            << std::endl
+            << "Options:" << std::endl
+            << "  -o/--output <name>          Combined output file (default: <file>_temp_combined, as" << std::endl
+            << "                              used by the hdf5 printer when resuming)" << std::endl
+            << "  -r/--resume                 Merge with the existing combined output file" << std::endl
+            << "  -j/--threads <n>            Number of datasets to copy concurrently (default 1)" << std::endl
+            << "  -c/--chunk_length <n>       Chunk length of the output datasets (default: contiguous)" << std::endl
+            << "  -z/--gzip <level>           Compress the output datasets with gzip (level 1-9)" << std::endl
+            << "  -s/--shuffle                Apply the shuffle filter before compression" << std::endl
+            << "  -h/--help                   Show this message" << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+  std::string output;
+  bool resume = false;
+  int n_threads = 1;
+  DataSetLayout layout;
+
+  const struct option options[] =
+  {
+    {"output",       required_argument, 0, 'o'},
+    {"resume",       no_argument,       0, 'r'},
+    {"threads",      required_argument, 0, 'j'},
+    {"chunk_length", required_argument, 0, 'c'},
+    {"gzip",         required_argument, 0, 'z'},
+    {"shuffle",      no_argument,       0, 's'},
+    {"help",         no_argument,       0, 'h'},
+    {0, 0, 0, 0}
+  };
+
+  int index, iarg = 0;
+  while(iarg != -1)
+  {
+    iarg = getopt_long(argc, argv, "o:rj:c:z:sh", options, &index);
+    switch (iarg)
+    {
+      case 'o': output = optarg; break;
+      case 'r': resume = true; break;
+      case 'j': n_threads = std::atoi(optarg); break;
+      case 'c': layout.chunklength = std::strtoul(optarg, NULL, 10); break;
+      case 'z': layout.deflate_level = std::atoi(optarg); break;
+      case 's': layout.shuffle = true; break;
+      case 'h': usage(argv[0]); return EXIT_SUCCESS;
+      case '?': usage(argv[0]); return EXIT_FAILURE;
+    }
+  }
+
+  if(argc - optind != 3)
+  {
+    usage(argv[0]);
+    return EXIT_FAILURE;
+  }
+  const std::string file  = argv[optind];
+  const std::string group = argv[optind+1];
+  const int num = std::atoi(argv[optind+2]);
+  if(output.empty()) output = file + "_temp_combined";
+
+  if(num < 1 or n_threads < 1)
+  {
+    std::cerr << "Error: the number of files and the number of threads must both be positive." << std::endl;
+    return EXIT_FAILURE;
+  }
+  if(layout.filtered() and layout.chunklength == 0)
+  {
+    std::cerr << "Error: compressed output requires a chunk length (--chunk_length)." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  try
+  {
+    HDF5::checkFiltersAvailable(layout);
+    HDF5::combine_hdf5_files(output, file, group, num, resume and Utils::file_exists(output), layout, n_threads);
+  }
+  catch (std::exception& e)
+  {
+    std::cerr << "Error combining hdf5 files: " << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::cout << "Combined output written to " << output << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -23,8 +23,11 @@
 #define __VertexBufferNumeric1D_hpp__
 
 #include <cstddef>
+#include <algorithm>
 #include <sstream>
 #include <iostream>
+#include <vector>
+#include <valarray>
 
 // HDF5 C bindings
 #include <hdf5.h> 
@@ -89,14 +92,19 @@ namespace Gambit {
       };
  
       /// VertexBuffer for simple numerical types
-      template<class T, std::size_t LENGTH>
+      /// The buffer length is chosen at runtime, and the storage is allocated
+      /// once on construction (only for the role, sync or random access, that
+      /// the buffer actually plays, and not at all for silenced buffers) and
+      /// then reused for the life of the buffer.
+      template<class T>
       class VertexBufferNumeric1D : public VertexBufferBase
       {
         protected:
           /// @{ Buffer variables for sequential writing
-          // Using arrays as these are easier to write to hdf5
-          bool  buffer_valid[LENGTH]; // Array telling us which buffer entries are properly filled
-          T     buffer_entries[LENGTH];
+          // Contiguous storage as this is easier to write to hdf5. The validity
+          // flags live in a valarray because std::vector<bool> is bit-packed.
+          std::valarray<bool> buffer_valid; // Array telling us which buffer entries are properly filled
+          std::vector<T>      buffer_entries;
 
           // DEPRECATED! No more MPI stuff needed.
           // /// Buffers to store data waiting to be sent via MPI
@@ -120,9 +128,9 @@ namespace Gambit {
  
           /// @{ Buffer variables for random access writing
           /// Queue for random access writes to dataset (independent of main buffer)
-          T     RA_write_queue[LENGTH];
+          std::vector<T> RA_write_queue;
           /// Target pointIDs for RA writes.
-          PPIDpair RA_write_locations[LENGTH];
+          std::vector<PPIDpair> RA_write_locations;
           /// Current length of the RA write queue
           uint  RA_queue_length = 0;
 
@@ -152,8 +160,10 @@ namespace Gambit {
           /// MPI rank for this process
           uint myRank = 0;
 
+          /// Number of entries held by the buffer before it must be emptied
+          std::size_t bufferlength;
+
         private:
-          static const std::size_t bufferlength = LENGTH;
 
           /// Variable to check that "append" is not called twice in a row for the same scan point
           PPIDpair PPID_of_last_append;
@@ -167,6 +177,9 @@ namespace Gambit {
             : VertexBufferBase()
             , buffer_valid()
             , buffer_entries()
+            , RA_write_queue()
+            , RA_write_locations()
+            , bufferlength(0)
             , PPID_of_last_append(null_PPID)
           {}
 
@@ -213,15 +226,25 @@ namespace Gambit {
               , const bool sil
               , const bool resume
               , const char access
+              , const std::size_t length
            ): VertexBufferBase(label,vID,i,sync,sil,resume,false,access)
-            , buffer_valid() 
-            , buffer_entries()
+            , buffer_valid(false, (sync and not sil) ? length : 0) 
+            , buffer_entries((sync and not sil) ? length : 0)
+            , RA_write_queue((sync or sil) ? 0 : length)
+            , RA_write_locations((sync or sil) ? 0 : length)
             // #ifdef WITH_MPI
             // , myTags()
             // , printerComm()
             // #endif
+            , bufferlength(length)
             , PPID_of_last_append(null_PPID)
           {
+             if(length==0)
+             {
+                std::ostringstream errmsg;
+                errmsg << "Error! Tried to create buffer "<<label<<" with a length of zero! This is a bug in the calling code (probably the printer); please report it.";
+                printer_error().raise(LOCAL_INFO, errmsg.str());
+             }
              // #ifdef WITH_MPI
              // myRank = printerComm.Get_rank();
              // #endif
@@ -266,7 +289,8 @@ namespace Gambit {
           virtual void RA_write_to_disk(const std::map<PPIDpair, ulong>& PPID_to_dsetindex) = 0;
 
           /// Write externally-supplied buffer to HDF5 dataset
-          virtual void write_external_to_disk(const T (&values)[LENGTH], const bool (&isvalid)[LENGTH]) = 0;
+          /// (both arrays must have get_bufferlength() entries)
+          virtual void write_external_to_disk(const T* values, const bool* isvalid) = 0;
 
           // #ifdef WITH_MPI
           // // Probe for a sync buffer MPI message from a process
@@ -290,6 +314,9 @@ namespace Gambit {
           // Report queue length (e.g. for checking that it is empty during finalise)
           virtual uint get_RA_queue_length() { return RA_queue_length; }
 
+          /// Report the (runtime) length of the buffer
+          std::size_t get_bufferlength() const { return bufferlength; }
+
           /// Extract (copy) a record
           T get_entry(const std::size_t i) const;
  
@@ -301,16 +328,16 @@ namespace Gambit {
       /// @{ Static member definitions
   
       /// Use to skip the double-append check (for receiving many points via MPI)
-      template<class T, std::size_t L>
-      const PPIDpair VertexBufferNumeric1D<T,L>::null_PPID = PPIDpair(-1,-1); 
+      template<class T>
+      const PPIDpair VertexBufferNumeric1D<T>::null_PPID = PPIDpair(-1,-1); 
 
       /// @}
 
       /// @{ VertexBufferNumeric1D function definitions
 
       /// Append a record to the buffer
-      template<class T, std::size_t L>
-      void VertexBufferNumeric1D<T,L>::append(const T& data, const PPIDpair pID)
+      template<class T>
+      void VertexBufferNumeric1D<T>::append(const T& data, const PPIDpair pID)
       {
          if(not this->is_silenced())
          {
@@ -336,7 +363,7 @@ namespace Gambit {
             if(this->get_label()==MONITOR_BUF) {
             #endif
             std::cout<<"-------------------------------------"<<std::endl;
-            std::cout<<"rank "<<myRank<<": Called 'VertexBufferNumeric1D<T,L>::append'"<<std::endl;
+            std::cout<<"rank "<<myRank<<": Called 'VertexBufferNumeric1D<T>::append'"<<std::endl;
             std::cout<<"rank "<<myRank<<": Dump from buffer '"<<this->get_label()<<"'"<<std::endl;
             std::cout<<"rank "<<myRank<<": dset_head_pos()  = "<<dset_head_pos()<<std::endl;
             std::cout<<"rank "<<myRank<<": donepoint() = "<<this->donepoint()<<std::endl;
@@ -369,8 +396,8 @@ namespace Gambit {
       }
 
       /// No data to append this iteration; skip this slot
-      template<class T, std::size_t L>
-      void VertexBufferNumeric1D<T,L>::skip_append()
+      template<class T>
+      void VertexBufferNumeric1D<T>::skip_append()
       {
          if(not this->is_silenced()) {
             //std::cout<<"rank "<<myRank<<": Buffer "<<this->get_label()<<", head_position ("<<this->get_head_position()<<"): running skip_append()"<<std::endl;
@@ -401,8 +428,8 @@ namespace Gambit {
       }
 
       /// Either send sync buffer data to master node via MPI, or trigger the write to disk
-      template<class T, std::size_t L>
-      void VertexBufferNumeric1D<T,L>::flush()
+      template<class T>
+      void VertexBufferNumeric1D<T>::flush()
       {
          if(not this->is_silenced()) {
             // #ifdef WITH_MPI
@@ -464,8 +491,8 @@ namespace Gambit {
       } 
 
       /// Either send random-access buffer data to master node via MPI, or trigger the write to disk
-      template<class T, std::size_t L>
-      void VertexBufferNumeric1D<T,L>::RA_flush(const std::map<PPIDpair, ulong>& PPID_to_dsetindex)
+      template<class T>
+      void VertexBufferNumeric1D<T>::RA_flush(const std::map<PPIDpair, ulong>& PPID_to_dsetindex)
       {
         if(this->is_synchronised())
         {
@@ -536,22 +563,21 @@ namespace Gambit {
 
 
       /// Queue up a desynchronised ("random access") dataset write to previous scan iteration
-      template<class T, std::size_t L>
-      void VertexBufferNumeric1D<T,L>::RA_write(const T& value, const PPIDpair pID, const std::map<PPIDpair, ulong>& PPID_to_dsetindex)
+      template<class T>
+      void VertexBufferNumeric1D<T>::RA_write(const T& value, const PPIDpair pID, const std::map<PPIDpair, ulong>& PPID_to_dsetindex)
       {
-         uint i = RA_queue_length;
-         if(i>L)
-         {
-            std::ostringstream errmsg;
-            errmsg << "Error! Attempted to do RA_write beyond end of RA buffer ("<<i<<" > "<<L<<")! (buffer name="<<this->get_label()<<")";
-            printer_error().raise(LOCAL_INFO, errmsg.str());
-         }
-
          if(not this->is_silenced()) {
+            uint i = RA_queue_length;
+            if(i>=RA_write_queue.size())
+            {
+               std::ostringstream errmsg;
+               errmsg << "Error! Attempted to do RA_write beyond end of RA buffer ("<<i<<" >= "<<RA_write_queue.size()<<")! (buffer name="<<this->get_label()<<")";
+               printer_error().raise(LOCAL_INFO, errmsg.str());
+            }
             RA_write_queue[i]     = value;
             RA_write_locations[i] = pID;
             RA_queue_length += 1;
-            if(RA_queue_length==L)
+            if(RA_queue_length==bufferlength)
             {
                RA_flush(PPID_to_dsetindex);
             }
@@ -561,8 +587,8 @@ namespace Gambit {
       // DEPECATED! No longer passing data around via MPI. Each process just writes independently and we combine it at the end.
       // #ifdef WITH_MPI
       // // Probe for a sync buffer MPI message from a process
-      // template<class T, std::size_t L>
-      // bool VertexBufferNumeric1D<T,L>::probe_sync_mpi_message(uint source, int* msgsize)
+      // template<class T>
+      // bool VertexBufferNumeric1D<T>::probe_sync_mpi_message(uint source, int* msgsize)
       // {
       //    this->MPImode_only(LOCAL_INFO); // throws error if MPI_mode()==false
       //    if(not myTags.valid)
@@ -590,8 +616,8 @@ namespace Gambit {
       // }
 
       // // Probe for a random-access buffer MPI message from a process
-      // template<class T, std::size_t L>
-      // bool VertexBufferNumeric1D<T,L>::probe_RA_mpi_message(uint source)
+      // template<class T>
+      // bool VertexBufferNumeric1D<T>::probe_RA_mpi_message(uint source)
       // {
       //    this->MPImode_only(LOCAL_INFO); // throws error if MPI_mode()==false
       //    if(not myTags.valid)
@@ -754,8 +780,8 @@ namespace Gambit {
       // }
 
       // // Update myTags with valid values
-      // template<class T, std::size_t L>
-      // void VertexBufferNumeric1D<T,L>::update_myTags(uint first_tag)
+      // template<class T>
+      // void VertexBufferNumeric1D<T>::update_myTags(uint first_tag)
       // {
       //   this->MPImode_only(LOCAL_INFO); // throws error if MPI_mode()==false
       //   if(myTags.valid)
@@ -771,8 +797,8 @@ namespace Gambit {
       // #endif
 
       /// Extract (copy) a record
-      template<class T, std::size_t L>
-      T VertexBufferNumeric1D<T,L>::get_entry(const std::size_t i) const
+      template<class T>
+      T VertexBufferNumeric1D<T>::get_entry(const std::size_t i) const
       {
          if(this->is_silenced()) {
            std::string errmsg = "Error! Attempted to retrieve data from a silenced buffer!";
@@ -790,8 +816,8 @@ namespace Gambit {
       }
 
       /// Clear the buffer
-      template<class T, std::size_t L>
-      void VertexBufferNumeric1D<T,L>::clear()
+      template<class T>
+      void VertexBufferNumeric1D<T>::clear()
       {
          if(not this->is_silenced()) {
             #ifdef BUF_DEBUG
@@ -804,11 +830,8 @@ namespace Gambit {
             #endif
             #endif
 
-            for(std::size_t i=0; i<bufferlength; i++)
-            {
-               buffer_valid[i] = false;
-               buffer_entries[i] = 0;
-            }
+            buffer_valid = false;
+            std::fill(buffer_entries.begin(), buffer_entries.end(), T());
             this->reset_head(); 
             this->sync_buffer_full = false;
             this->sync_buffer_empty = true;
@@ -820,8 +843,8 @@ namespace Gambit {
       /// NOTE! This is meant for initialising new buffers to the correct
       /// position. If buffer overflows it will be cleared without data
       /// being written, so don't use this in other contexts.
-      template<class T, std::size_t L>
-      void VertexBufferNumeric1D<T,L>::N_skip_append(ulong N)
+      template<class T>
+      void VertexBufferNumeric1D<T>::N_skip_append(ulong N)
       {
          //std::cout << "rank "<<myRank<<": Pushing forward (new?) buffer '"<<this->get_label()<<"' by "<<N<<" positions"<<std::endl; 
          for(ulong i=0; i<N; i++)
@@ -20,6 +20,7 @@
 
 // Standard libraries
 #include <map>
+#include <memory>
 #include <vector>
 #include <algorithm>
 #include <sstream>
@@ -33,6 +34,7 @@
 #include "gambit/Printers/VertexBuffer_mpitags.hpp"
 #include "gambit/Printers/printers/hdf5types.hpp"
 #include "gambit/Printers/printers/hdf5printer/hdf5tools.hpp"
+#include "gambit/Printers/printers/hdf5printer/hdf5_async_writer.hpp"
 #include "gambit/Printers/printers/hdf5printer/VertexBufferNumeric1D_HDF5.hpp"
 #include "gambit/Printers/printers/hdf5printer/DataSetInterfaceScalar.hpp"
 #include "gambit/Utils/yaml_options.hpp"
@@ -56,12 +58,21 @@ namespace Gambit
   namespace Printers
   {
 
-    // Parameter controlling the length of all the standard buffers
-    static const std::size_t BUFFERLENGTH = 100; // Change to 10000 or something. Currently cannot change this dynamically though, sorry.
+    /// Default length of all the standard buffers (used unless 'buffer_length'
+    /// or 'buffer_memory_MB' is given in the printer options)
+    static const std::size_t DEFAULT_BUFFERLENGTH = 100;
+    /// Limits on the buffer length chosen automatically from 'buffer_memory_MB'.
+    /// Automatic lengths are also rounded down to a multiple of the minimum.
+    static const std::size_t MIN_AUTO_BUFFERLENGTH = 100;
+    static const std::size_t MAX_AUTO_BUFFERLENGTH = 100000;
+    /// gzip level used if 'compression: gzip' is given without a 'compression_level'
+    static const unsigned int DEFAULT_GZIP_LEVEL = 4;
     /// Max number of PPIDpairs to be tracked
     /// i.e. chunks of RA output longer than this can potentially contain multiple writes to the same point.
     /// It is up to the combine script to apply the last scheduled write preferentially.
-    static const unsigned long MAX_PPIDPAIRS = 10*BUFFERLENGTH;
+    /// (Must match 'max_ppidpairs' in Printers/scripts/combine_hdf5.py, so this does not
+    /// follow the runtime buffer length)
+    static const unsigned long MAX_PPIDPAIRS = 1000;
 
     /// @{ Helpful typedefs
 
@@ -183,6 +194,22 @@ namespace Gambit
         /// (should correspond to the number of "appends" each active buffer has received)
         unsigned long get_sync_pos() const { return sync_pos; }
 
+        /// Get the length of the buffers (the primary printer sets this for all printers,
+        /// since every synchronised buffer has to fill up and be emptied at the same time)
+        std::size_t get_bufferlength() const { return primary_printer->bufferlength; }
+
+        /// Get the chunking and compression settings for the output datasets (also set by
+        /// the primary printer). By default every buffer flush writes exactly one chunk.
+        DataSetLayout get_dataset_layout() const
+        {
+          DataSetLayout layout(primary_printer->dataset_layout);
+          if(layout.chunklength==0) layout.chunklength = get_bufferlength();
+          return layout;
+        }
+
+        /// Get the background writer shared by all buffers (NULL if writes are synchronous)
+        HDF5AsyncWriter* get_async_writer() const { return primary_printer->async_writer.get(); }
+
      private:
 
         /// Buffer manager objects
@@ -191,7 +218,7 @@ namespace Gambit
         //  defined outside the class declaration, so they can be found below.
         //  Could create all these with a macro, but I am sick of macros so
         //  will just do it the "old-fashioned" way.
-        #define BT(TYPE) VertexBufferNumeric1D_HDF5<TYPE,BUFFERLENGTH>
+        #define BT(TYPE) VertexBufferNumeric1D_HDF5<TYPE>
         H5P_LocalBufferManager<BT(int      )> hdf5_localbufferman_int;
         H5P_LocalBufferManager<BT(uint     )> hdf5_localbufferman_uint;
         H5P_LocalBufferManager<BT(long     )> hdf5_localbufferman_long;
@@ -224,6 +251,12 @@ namespace Gambit
         /// Function to ensure buffers are all synchronised to the same absolute position
         void synchronise_buffers();
 
+        /// Choose the buffer length from the memory budget and the number of output streams
+        void choose_bufferlength(const std::size_t n_streams);
+
+        /// Check that the chosen chunk length (if any) divides the buffer length
+        void check_chunklength() const;
+
         /// For debugging: check that buffers are synced correctly
         /// Flag sets whether "perfect" sync is required, or whether
         /// some buffers can be ahead by one slot (due to having
@@ -369,6 +402,24 @@ namespace Gambit
         /// Label for printer, mostly for more helpful error messages
         std::string printer_name;
 
+        /// Length of all buffers created by this printer (only the primary printer's value is used)
+        std::size_t bufferlength = DEFAULT_BUFFERLENGTH;
+
+        /// Memory budget (in MB) from which to choose the buffer length automatically
+        /// (zero if the length was fixed by the user, or if the default is to be used)
+        double buffer_memory_MB = 0;
+
+        /// Chunking and compression settings for the output datasets (only the primary printer's
+        /// value is used; a zero chunk length means "one chunk per buffer flush")
+        DataSetLayout dataset_layout;
+
+        /// Number of datasets to copy concurrently while combining the temporary output files
+        int combine_threads = 1;
+
+        /// Background thread performing the dataset writes (primary printer only; NULL
+        /// unless the 'async_write' option is set)
+        std::unique_ptr<HDF5AsyncWriter> async_writer;
+
         /// MPI rank and size
         unsigned int myRank;  // Needed even without MPI available, for some default behaviour.
         unsigned int mpiSize; //            "                           "
@@ -417,7 +468,7 @@ namespace Gambit
     // types which can not form part of a valid variable name.
     #define DEFINE_BUFFMAN_GETTER(TYPE)                                        \
       template<>                                                               \
-      inline H5P_LocalBufferManager<VertexBufferNumeric1D_HDF5<TYPE,BUFFERLENGTH>>& \
+      inline H5P_LocalBufferManager<VertexBufferNumeric1D_HDF5<TYPE>>&       \
        HDF5Printer::get_mybuffermanager<TYPE>(ulong pointID, uint mpirank) \
       {                                                                        \
          /* If the buffermanger hasn't been initialised, do so now */          \
@@ -527,6 +578,9 @@ namespace Gambit
                                       , silence
                                       , false /*printer->get_resume() -- In this new version of the HDF5Printer we write temporary files and then combine them at the end of the scan, so each individual buffer no longer needs to be in 'resume' mode, it can just start anew and be combined with the old data later on */
                                       , access /* r/w mode. Buffers can now be used for reading also. */
+                                      , printer->get_bufferlength()
+                                      , printer->get_dataset_layout()
+                                      , printer->get_async_writer()
                                       );
 
         // Get the new (possibly silenced) buffer back out of the map
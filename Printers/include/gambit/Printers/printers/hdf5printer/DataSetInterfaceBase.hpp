@@ -30,6 +30,8 @@
 #include <hdf5.h> 
  
 // Gambit
+#include "gambit/Printers/printers/hdf5printer/hdf5tools.hpp"
+#include "gambit/Printers/printers/hdf5printer/hdf5_async_writer.hpp"
 #include "gambit/Utils/standalone_error_handlers.hpp"
 #include "gambit/Logs/logger.hpp"
 
@@ -41,13 +43,14 @@ namespace Gambit {
       // Mostly just creates the dataset and holds metadata about it
       // Would be nice to extend to handle writing as well, but currently
       // I have to do it differently depending on the RANK.
-      template<class T, std::size_t RECORDRANK, std::size_t CHUNKLENGTH>
+      template<class T, std::size_t RECORDRANK>
       class DataSetInterfaceBase
       {
         private: 
          static const std::size_t DSETRANK = RECORDRANK+1; // Rank of the dataset array
          hid_t mylocation_id; // handle for where this datasets is located in the hdf5 file
          std::string myname; // name of the dataset in the hdf5 file         
+         DataSetLayout layout; // chunking and filter settings for the dataset (set at runtime by the owner)
 
          // Dimension sizes for each record. 
          // This only needs to be RECORDRANK long, however zero-size arrays are not
@@ -83,7 +86,7 @@ namespace Gambit {
            {
               std::ostringstream errmsg;
               errmsg << "Error getting handle for dataset with name: \""<<get_myname()<<"\". Handle id is invalid. Dataset wrapping has failed to occur correctly, and problems should have been detected before this, so this is a bug; please fix.";
-              printer_error().raise(LOCAL_INFO, errmsg.str());
+              raise_printer_error(LOCAL_INFO, errmsg.str());
            }
            return this->dset_id;
          } 
@@ -103,7 +106,8 @@ namespace Gambit {
          // Const public data accessors
          std::string get_myname() const      { return myname; }
          std::size_t get_dsetrank() const    { return DSETRANK; }
-         std::size_t get_chunklength() const { return CHUNKLENGTH; }
+         std::size_t get_chunklength() const { return layout.chunklength; }
+         const DataSetLayout& get_layout() const { return layout; }
          const hsize_t* get_maxdsetdims() const    { return maxdims; }
          const hsize_t* get_chunkdims() const      { return chunkdims; }
          const hsize_t* get_slicedims() const      { return slicedims; }
@@ -120,7 +124,7 @@ namespace Gambit {
 
          /// Constructors
          DataSetInterfaceBase(); 
-         DataSetInterfaceBase(hid_t location_id, const std::string& name, const std::size_t rdims[DSETRANK], const bool resume, const char access);
+         DataSetInterfaceBase(hid_t location_id, const std::string& name, const std::size_t rdims[DSETRANK], const bool resume, const char access, const DataSetLayout& layout);
          virtual ~DataSetInterfaceBase(); 
 
          /// Create a (chunked) dataset 
@@ -132,7 +136,7 @@ namespace Gambit {
          /// Close an open dataset
          void closeDataSet();
 
-         /// Extend dataset to nearest multiple of CHUNKLENGTH above supplied length
+         /// Extend dataset to nearest multiple of chunklength above supplied length
          void extend_dset(const unsigned long i);
 
       };
@@ -141,14 +145,15 @@ namespace Gambit {
       /// @{ DataSetInterfaceBase class member definitions
 
       // Define some static members
-      template<class T, std::size_t RR, std::size_t CL>
-      const hid_t DataSetInterfaceBase<T,RR,CL>::hdftype_id = get_hdf5_data_type<T>::type(); 
+      template<class T, std::size_t RR>
+      const hid_t DataSetInterfaceBase<T,RR>::hdftype_id = get_hdf5_data_type<T>::type(); 
 
       /// Constructors
-      template<class T, std::size_t RR, std::size_t CL>
-      DataSetInterfaceBase<T,RR,CL>::DataSetInterfaceBase() 
+      template<class T, std::size_t RR>
+      DataSetInterfaceBase<T,RR>::DataSetInterfaceBase() 
         : mylocation_id(-1)
         , myname()
+        , layout()
         , record_dims()
         , resume(false)
         , access('r')
@@ -156,16 +161,23 @@ namespace Gambit {
         , dsetnextemptyslab(0)
       {}
 
-      template<class T, std::size_t RR, std::size_t CL>
-      DataSetInterfaceBase<T,RR,CL>::DataSetInterfaceBase(hid_t location_id, const std::string& name, const std::size_t rdims[DSETRANK], const bool r, const char a)
+      template<class T, std::size_t RR>
+      DataSetInterfaceBase<T,RR>::DataSetInterfaceBase(hid_t location_id, const std::string& name, const std::size_t rdims[DSETRANK], const bool r, const char a, const DataSetLayout& l)
         : mylocation_id(location_id)
         , myname(name)
+        , layout(l)
         , record_dims() /* doh have to copy array element by element */
         , resume(r)
         , access(a)
         , dset_id(-1) 
         , dsetnextemptyslab(0)
       {
+        if(layout.chunklength==0)
+        {
+           std::ostringstream errmsg;
+           errmsg << "Error! Tried to attach interface to dataset '"<<this->get_myname()<<"' with a chunk length of zero! This is a bug, please fix.";
+           printer_error().raise(LOCAL_INFO, errmsg.str());
+        }
         if(resume)
         {
            dset_id = openDataSet(location_id,name,rdims);
@@ -185,8 +197,8 @@ namespace Gambit {
       }
  
       /// Do cleanup (close dataset)
-      template<class T, std::size_t RR, std::size_t CL>
-      DataSetInterfaceBase<T,RR,CL>::~DataSetInterfaceBase()
+      template<class T, std::size_t RR>
+      DataSetInterfaceBase<T,RR>::~DataSetInterfaceBase()
       {
          // TODO: Having problems with copied objects sharing dataset identifiers, and closing datasets prematurely on each other.
          // To fix, will probably need to have a fancy copy constructor or something. Or wrap datasets in an
@@ -204,8 +216,8 @@ namespace Gambit {
       }
 
       /// Release resources associated with the underlying dataset
-      template<class T, std::size_t RR, std::size_t CL>
-      void DataSetInterfaceBase<T,RR,CL>::closeDataSet()
+      template<class T, std::size_t RR>
+      void DataSetInterfaceBase<T,RR>::closeDataSet()
       {
          if(this->dset_id>=0)
          {
@@ -220,16 +232,16 @@ namespace Gambit {
       }
 
       /// Create a (chunked) dataset 
-      template<class T, std::size_t RECORDRANK, std::size_t CHUNKLENGTH>
-      hid_t DataSetInterfaceBase<T,RECORDRANK,CHUNKLENGTH>::createDataSet(hid_t location_id, const std::string& name, const std::size_t rdims[DSETRANK])
+      template<class T, std::size_t RECORDRANK>
+      hid_t DataSetInterfaceBase<T,RECORDRANK>::createDataSet(hid_t location_id, const std::string& name, const std::size_t rdims[DSETRANK])
       {
          // I'd like to declare rdims as rdims[RECORDRANK], but apparantly zero length arrays are not allowed,
          // so this would not compile in the RECORDRANK=0 case, which I need. Irritating.
          
          // Compute initial dataspace and chunk dimensions
-         dims[0] = 0; //1*CHUNKLENGTH; // Start off with space for 1 chunk
+         dims[0] = 0; //1*chunklength; // Start off with space for 1 chunk
          maxdims[0] = H5S_UNLIMITED; // No upper limit on number of records allowed in dataset
-         chunkdims[0] = CHUNKLENGTH;
+         chunkdims[0] = layout.chunklength;
          slicedims[0] = 1; // Dimensions of a single record in the data space
          std::size_t loopsize = RECORDRANK; // Just tricking the compiler so it doesn't complain in the RECORDRANK=0 case.
          for(std::size_t i=0; i<loopsize; i++)
@@ -251,24 +263,10 @@ namespace Gambit {
             printer_error().raise(LOCAL_INFO, errmsg.str());
          }
 
-         // Object containing dataset creation parameters
+         // Object containing dataset creation parameters (chunking, plus any compression filters)
          //H5::DSetCreatPropList cparms;   
          //cparms.setChunk(DSETRANK, chunkdims);
-         hid_t cparms_id = H5Pcreate(H5P_DATASET_CREATE);
-         if(cparms_id<0)
-         {
-            std::ostringstream errmsg;
-            errmsg << "Error creating dataset (with name: \""<<name<<"\") in HDF5 file. H5Pcreate failed.";
-            printer_error().raise(LOCAL_INFO, errmsg.str());
-         }
-
-         herr_t status = H5Pset_chunk(cparms_id, DSETRANK, chunkdims);
-         if(status<0)
-         {
-            std::ostringstream errmsg;
-            errmsg << "Error creating dataset (with name: \""<<name<<"\") in HDF5 file. H5Pset_chunk failed.";
-            printer_error().raise(LOCAL_INFO, errmsg.str());
-         }
+         hid_t cparms_id = HDF5::createDatasetPlist(layout, DSETRANK, chunkdims, name);
 
          // Check if location id is invalid
          if(location_id==-1)
@@ -288,13 +286,15 @@ namespace Gambit {
                errmsg << "Error creating dataset (with name: \""<<myname<<"\") in HDF5 file. Dataset with same name may already exist";
                printer_error().raise(LOCAL_INFO, errmsg.str());
          }
+         H5Pclose(cparms_id);
+         H5Sclose(dspace_id);
          return output_dset_id;
       }
 
       /// Open an existing dataset 
       /// It is assumed that we are resuming a run and therefore know what format this dataset should have
-      template<class T, std::size_t RECORDRANK, std::size_t CHUNKLENGTH>
-      hid_t DataSetInterfaceBase<T,RECORDRANK,CHUNKLENGTH>::openDataSet(hid_t location_id, const std::string& name, const std::size_t rdims[DSETRANK])
+      template<class T, std::size_t RECORDRANK>
+      hid_t DataSetInterfaceBase<T,RECORDRANK>::openDataSet(hid_t location_id, const std::string& name, const std::size_t rdims[DSETRANK])
       {
          // Open the dataset
          hid_t out_dset_id = H5Dopen2(location_id, name.c_str(), H5P_DEFAULT);
@@ -347,7 +347,7 @@ namespace Gambit {
          // Compute initial dataspace and chunk dimensions
          dims[0] = dims_out[0]; // Set to match existing data
          maxdims[0] = H5S_UNLIMITED; // No upper limit on number of records allowed in dataset
-         chunkdims[0] = CHUNKLENGTH;
+         chunkdims[0] = layout.chunklength;
          slicedims[0] = 1; // Dimensions of a single record in the data space
          std::size_t loopsize = RECORDRANK; // Just tricking the compiler so it doesn't complain in the RECORDRANK=0 case.
          for(std::size_t i=0; i<loopsize; i++)
@@ -376,19 +376,20 @@ namespace Gambit {
       }
 
 
-      /// Extend dataset to nearest multiple of CHUNKLENGTH above supplied length
-      template<class T, std::size_t RR, std::size_t CHUNKLENGTH>
-      void DataSetInterfaceBase<T,RR,CHUNKLENGTH>::extend_dset(const unsigned long min_length)
+      /// Extend dataset to nearest multiple of chunklength above supplied length
+      template<class T, std::size_t RR>
+      void DataSetInterfaceBase<T,RR>::extend_dset(const unsigned long min_length)
       {
          std::size_t current_length = this->dsetdims()[0];
          if( min_length > current_length )
          {
-            // Extend the dataset to the nearest multiple of CHUNKLENGTH above min_length,
-            // unless min_length is itself a multiple of CHUNKLENGTH.
-            std::size_t remainder = min_length % CHUNKLENGTH;
+            // Extend the dataset to the nearest multiple of chunklength above min_length,
+            // unless min_length is itself a multiple of chunklength.
+            const std::size_t chunklength = layout.chunklength;
+            std::size_t remainder = min_length % chunklength;
             std::size_t newlength;
             if(remainder==0) { newlength = min_length; } 
-            else             { newlength = min_length - remainder + CHUNKLENGTH; }
+            else             { newlength = min_length - remainder + chunklength; }
             #ifdef HDF5_DEBUG
             std::cout << "Requested min_length ("<<min_length<<") larger than current dataset length ("<<current_length<<") (dset name="<<this->get_myname()<<")" << std::endl
                       << "Extending dataset to newlength="<<newlength<<std::endl;
@@ -401,7 +402,7 @@ namespace Gambit {
                std::cout<<this->get_dset_id()<<std::endl;
                std::ostringstream errmsg;
                errmsg << "Failed to extend dataset (with name: \""<<myname<<"\") from length "<<current_length<<" to length "<<newlength<<"!";
-               printer_error().raise(LOCAL_INFO, errmsg.str());
+               raise_printer_error(LOCAL_INFO, errmsg.str());
             }
          }
       }
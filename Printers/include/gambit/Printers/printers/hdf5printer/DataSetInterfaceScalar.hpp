@@ -25,6 +25,7 @@
 
 #include <sstream>
 #include <iostream>
+#include <valarray>
 
 // HDF5 C bindings
 #include <hdf5.h> 
@@ -40,8 +41,8 @@ namespace Gambit {
 
       /// Derived dataset interface, with methods for writing scalar records (i.e. single ints, doubles, etc.)
       /// i.e. RANK=0 case
-      template<class T, std::size_t CHUNKLENGTH>
-      class DataSetInterfaceScalar : public DataSetInterfaceBase<T,0,CHUNKLENGTH>
+      template<class T>
+      class DataSetInterfaceScalar : public DataSetInterfaceBase<T,0>
       {
         private:
           static const std::size_t empty_rdims[1]; // just to satisfy base class constructor, not used.
@@ -53,24 +54,26 @@ namespace Gambit {
         public: 
           /// Constructors
           DataSetInterfaceScalar(); 
-          DataSetInterfaceScalar(hid_t location_id, const std::string& name, const bool resume, const char access); 
+          DataSetInterfaceScalar(hid_t location_id, const std::string& name, const bool resume, const char access, const DataSetLayout& layout); 
  
           /// Select a hyperslab chunk in the hosted dataset
           std::pair<hid_t,hid_t> select_chunk(std::size_t offset, std::size_t length) const;
 
-          /// Write data to a new chunk in the hosted dataset
-          void writenewchunk(const T (&chunkdata)[CHUNKLENGTH]);
+          /// Write data to the next empty block of the hosted dataset
+          /// (chunkdata must point to 'length' entries; for whole-chunk writes
+          ///  'length' should be a multiple of get_chunklength())
+          void writenewchunk(const T* chunkdata, std::size_t length);
 
           /// Perform desynchronised ("random access") dataset writes to previous scan iterations
           /// from a queue.
-          void RA_write(const T (&values)[CHUNKLENGTH], const hsize_t (&coords)[CHUNKLENGTH], std::size_t npoints); 
+          void RA_write(const T* values, const hsize_t* coords, std::size_t npoints); 
 
           /// Set all elements of the dataset to zero
           void zero();
 
          /// @{ READ methods (perhaps can generalise to non-scalar case, but this doesn't exist yet for writing anyway so not bothering yet)
 
-         // Extracts the ith chunk of length CHUNKLENGTH from the dataset
+         // Extracts a chunk of the given length, starting at offset i, from the dataset
          std::vector<T> get_chunk(std::size_t i, std::size_t length) const;
 
          // Extract entry at given index from dataset
@@ -83,32 +86,33 @@ namespace Gambit {
       /// @{ DataSetInterfaceScalar member definitions
 
       // Define some static members
-      template<class T, std::size_t CL>
-      const std::size_t DataSetInterfaceScalar<T,CL>::empty_rdims[1] = {};
+      template<class T>
+      const std::size_t DataSetInterfaceScalar<T>::empty_rdims[1] = {};
 
       /// Constructors
-      template<class T, std::size_t CL>
-      DataSetInterfaceScalar<T,CL>::DataSetInterfaceScalar() 
-        : DataSetInterfaceBase<T,0,CL>()
+      template<class T>
+      DataSetInterfaceScalar<T>::DataSetInterfaceScalar() 
+        : DataSetInterfaceBase<T,0>()
       {}
 
-      template<class T, std::size_t CL>
-      DataSetInterfaceScalar<T,CL>::DataSetInterfaceScalar(hid_t location_id, const std::string& name, const bool resume, const char access) 
-        : DataSetInterfaceBase<T,0,CL>(location_id, name, empty_rdims, resume, access)
+      template<class T>
+      DataSetInterfaceScalar<T>::DataSetInterfaceScalar(hid_t location_id, const std::string& name, const bool resume, const char access, const DataSetLayout& layout) 
+        : DataSetInterfaceBase<T,0>(location_id, name, empty_rdims, resume, access, layout)
       {}
 
-      template<class T, std::size_t CHUNKLENGTH>
-      void DataSetInterfaceScalar<T,CHUNKLENGTH>::writenewchunk(const T (&chunkdata)[CHUNKLENGTH])
+      template<class T>
+      void DataSetInterfaceScalar<T>::writenewchunk(const T* chunkdata, std::size_t length)
       {
          #ifdef HDF5_DEBUG
          std::cout << "Preparing to write new chunk to dataset "<<this->get_myname()<<std::endl;
          #endif
-         // Extend the dataset if needed. Usually dataset on disk just becomes 1 chunk larger.
-         this->extend_dset(this->dsetnextemptyslab+CHUNKLENGTH);
+         // Extend the dataset if needed. Usually dataset on disk just becomes 'length' larger
+         // (a whole number of chunks, since buffer lengths are multiples of the chunk length).
+         this->extend_dset(this->dsetnextemptyslab+length);
 
          // Select a hyperslab.
          std::size_t offset = this->dsetnextemptyslab;
-         std::pair<hid_t,hid_t> selection_ids = select_chunk(offset,CHUNKLENGTH);
+         std::pair<hid_t,hid_t> selection_ids = select_chunk(offset,length);
          hid_t memspace_id = selection_ids.first;
          hid_t dspace_id   = selection_ids.second;
  
@@ -119,33 +123,36 @@ namespace Gambit {
          {
             std::ostringstream errmsg;
             errmsg << "Error writing new chunk to dataset (with name: \""<<this->get_myname()<<"\") in HDF5 file. H5Dwrite failed." << std::endl;
-            printer_error().raise(LOCAL_INFO, errmsg.str());
+            raise_printer_error(LOCAL_INFO, errmsg.str());
          }
          #ifdef HDF5_DEBUG
          std::cout<<"Chunk written to dataset \""<<this->get_myname()<<"\"! Incrementing chunk offset:"
-                  <<this->dsetnextemptyslab<<" --> "<<this->dsetnextemptyslab+CHUNKLENGTH<<std::endl;
+                  <<this->dsetnextemptyslab<<" --> "<<this->dsetnextemptyslab+length<<std::endl;
          #endif
-         this->dsetnextemptyslab += CHUNKLENGTH;
+         this->dsetnextemptyslab += length;
          H5Sclose(dspace_id);
          H5Sclose(memspace_id);
       }
 
       /// Set all elements of the dataset to zero
-      template<class T, std::size_t CHUNKLENGTH>
-      void DataSetInterfaceScalar<T,CHUNKLENGTH>::zero()
+      template<class T>
+      void DataSetInterfaceScalar<T>::zero()
       {
+         const std::size_t chunklength = this->get_chunklength();
          /// Easiest way to do this is to simply point the "nextemptyslab" index
          /// back to the beginning of the dataset, and then rewrite all the chunks
          /// with zero values.
          //std::cout<<"Zeroing dataset "<<this->get_myname()<<std::endl;
 
-         T  zero_buffer[CHUNKLENGTH] = {}; // Should set everything to zero I believe... at least for primitive T.
+         // Value-initialised, so everything is zero (for primitive T). Using a valarray
+         // rather than a vector so that bools are stored contiguously.
+         const std::valarray<T> zero_buffer(chunklength);
  
          unsigned long orig_nextslab = this->dsetnextemptyslab; 
      
          /// Figure out how many chunks to overwrite
          //std::size_t Nslabs = this->dsetnextemptyslab / CHUNKLENGTH; //no good for RA datasets
-         std::size_t Nslabs = this->dset_length() / CHUNKLENGTH; //should be ok since length is constrained to multiples of CHUNKLENGTH
+         std::size_t Nslabs = this->dset_length() / chunklength; //should be ok since length is constrained to multiples of chunklength
         
          /// Point hyperslab selector back to beginning of dataset
          /// (might already point there if this is a random-access dataset,
@@ -156,7 +163,7 @@ namespace Gambit {
 
          for(std::size_t i=0; i<Nslabs; i++)
          {
-            writenewchunk(zero_buffer);
+            writenewchunk(&zero_buffer[0], chunklength);
          }
 
          // hyperslab selector should automatically end up pointing back to the
@@ -169,20 +176,14 @@ namespace Gambit {
 
       /// Perform desynchronised ("random access") dataset writes to previous scan iterations
       /// from a queue.
-      template<class T, std::size_t CHUNKLENGTH>
-      void DataSetInterfaceScalar<T,CHUNKLENGTH>::RA_write(const T (&values)[CHUNKLENGTH], const hsize_t (&coords)[CHUNKLENGTH], std::size_t npoints) 
+      template<class T>
+      void DataSetInterfaceScalar<T>::RA_write(const T* values, const hsize_t* coords, std::size_t npoints) 
       {
-         if(npoints>CHUNKLENGTH)
-         {
-             std::ostringstream errmsg;
-             errmsg << "Error! Received npoints ("<<npoints<<") greater than CHUNKLENGTH ("<<CHUNKLENGTH<<") while tring to perform RA_write for dataset (name="<<this->get_myname()<<"). The input to this function is therefore invalid."; 
-             printer_error().raise(LOCAL_INFO, errmsg.str());
-         }
          if(npoints==0)
          {
              std::ostringstream errmsg;
              errmsg << "Error! Received npoints=0! This will cause an error when trying to select element for writing, and there is no point calling this function with no points to write anyway. Please review the input to this function (error occurred while tring to perform RA_write for dataset (name="<<this->get_myname()<<"))"; 
-             printer_error().raise(LOCAL_INFO, errmsg.str());
+             raise_printer_error(LOCAL_INFO, errmsg.str());
          }
 
          bool error_occurred = false; // simple error flag
@@ -219,7 +220,7 @@ namespace Gambit {
          {
              std::ostringstream errmsg;
              errmsg << "Error! Tried to write to dataset (name="<<this->get_myname()<<") with type id "<<dtype<<" but expected it to have type id "<<expected_dtype<<". This is a bug in the DataSetInterfaceScalar class, please report it."; 
-             printer_error().raise(LOCAL_INFO, errmsg.str());
+             raise_printer_error(LOCAL_INFO, errmsg.str());
          }
 
          // Write data to selected points
@@ -240,7 +241,7 @@ namespace Gambit {
                     << "  errflag2 : " << errflag2 << std::endl
                     << "Variables:" << std::endl
                     << "  dtype = " << dtype;
-             printer_error().raise(LOCAL_INFO, errmsg.str());
+             raise_printer_error(LOCAL_INFO, errmsg.str());
          }
          
          H5Tclose(dtype);
@@ -308,8 +309,8 @@ namespace Gambit {
 
      /// To facilitate code factorisation, the hyperslab selection is now contained here
      /// Only selects whole chunks at the moment.
-     template<class T, std::size_t CHUNKLENGTH>
-     std::pair<hid_t,hid_t> DataSetInterfaceScalar<T,CHUNKLENGTH>::select_chunk(std::size_t offset, std::size_t length) const
+     template<class T>
+     std::pair<hid_t,hid_t> DataSetInterfaceScalar<T>::select_chunk(std::size_t offset, std::size_t length) const
      {
          #ifdef HDF5_DEBUG
          std::cout << "Selecting chunk in dataset "<<this->get_myname()<<" with offset "<<offset<<std::endl;
@@ -323,7 +324,7 @@ namespace Gambit {
             errmsg << "  offset = " << offset << std::endl;
             errmsg << "  offset+length = " << length << std::endl;
             errmsg << "  dset_length() = "<< this->dset_length() << std::endl;
-            printer_error().raise(LOCAL_INFO, errmsg.str());
+            raise_printer_error(LOCAL_INFO, errmsg.str());
          }
 
          // Select a hyperslab.
@@ -333,7 +334,7 @@ namespace Gambit {
          {
             std::ostringstream errmsg;
             errmsg << "Error selecting chunk from dataset (with name: \""<<this->get_myname()<<"\") in HDF5 file. H5Dget_space failed." << std::endl;
-            printer_error().raise(LOCAL_INFO, errmsg.str());
+            raise_printer_error(LOCAL_INFO, errmsg.str());
          }
 
          hsize_t offsets[DSETRANK];
@@ -350,7 +351,7 @@ namespace Gambit {
          {
             std::ostringstream errmsg;
             errmsg << "Error selecting chunk from dataset (with name: \""<<this->get_myname()<<"\", offset="<<offset<<", length="<<selection_dims[0]<<") in HDF5 file. H5Sselect_hyperslab failed." << std::endl;
-            printer_error().raise(LOCAL_INFO, errmsg.str());
+            raise_printer_error(LOCAL_INFO, errmsg.str());
          }
 
          // Define memory space
@@ -361,7 +362,7 @@ namespace Gambit {
          std::cout << "Debug variables:" << std::endl
                    << "  dsetdims()[0]      = " << this->dsetdims()[0] << std::endl
                    << "  offsets[0]         = " << offsets[0] << std::endl
-                   << "  CHUNKLENGTH        = " << CHUNKLENGTH << std::endl
+                   << "  chunklength        = " << this->get_chunklength() << std::endl
                    << "  selection_dims[0] = " << selection_dims[0] << std::endl;
          #endif
 
@@ -371,8 +372,8 @@ namespace Gambit {
      ///   {@ READ methods
 
      /// Extract a data slice from the linked dataset
-     template<class T, std::size_t CHUNKLENGTH>
-     std::vector<T> DataSetInterfaceScalar<T,CHUNKLENGTH>::get_chunk(std::size_t offset, std::size_t length) const
+     template<class T>
+     std::vector<T> DataSetInterfaceScalar<T>::get_chunk(std::size_t offset, std::size_t length) const
      {
          // Buffer to receive data (and return from function)
          std::vector<T> chunkdata(length);
@@ -404,12 +405,13 @@ namespace Gambit {
      }
 
      /// Extract a single entry from a linked dataset
-     template<class T, std::size_t CHUNKLENGTH>
-     T DataSetInterfaceScalar<T,CHUNKLENGTH>::get_entry(std::size_t index)
+     template<class T>
+     T DataSetInterfaceScalar<T>::get_entry(std::size_t index)
      {
+        const std::size_t chunklength = this->get_chunklength();
         // Figure out relevant chunk start index and position of desired entry in the chunk.
-        std::size_t chunk_start = (index / CHUNKLENGTH) * CHUNKLENGTH;
-        std::size_t chunk_relative_index = index % CHUNKLENGTH;
+        std::size_t chunk_start = (index / chunklength) * chunklength;
+        std::size_t chunk_relative_index = index % chunklength;
 
         #ifdef HDF5_DEBUG
         std::cout << "index      :" << index << std::endl;
@@ -425,7 +427,7 @@ namespace Gambit {
            std::cout << "extracting new chunk starting from "<<chunk_start<< std::endl;
            #endif
            // Make sure we don't try to read past the end of the dataset
-           std::size_t length = CHUNKLENGTH; 
+           std::size_t length = chunklength; 
            if(chunk_start+length > this->dset_length())
            {
               length = this->dset_length() - chunk_start;
@@ -22,6 +22,7 @@
 #ifndef __VertexBufferNumeric1D_HDF5_hpp__
 #define __VertexBufferNumeric1D_HDF5_hpp__
 
+#include <algorithm>
 #include <cstddef>
 #include <sstream>
 
@@ -31,6 +32,7 @@
 // Gambit
 #include "gambit/Printers/VertexBufferNumeric1D.hpp"
 #include "gambit/Printers/printers/hdf5printer/DataSetInterfaceScalar.hpp"
+#include "gambit/Printers/printers/hdf5printer/hdf5_async_writer.hpp"
 #include "gambit/Utils/standalone_error_handlers.hpp"
 #include "gambit/Logs/logger.hpp"
 
@@ -45,17 +47,27 @@ namespace Gambit {
   namespace Printers {
  
       /// VertexBuffer for simple numerical types - derived version that handles output to hdf5
-      template<class T, std::size_t CHUNKLENGTH>
-      class VertexBufferNumeric1D_HDF5 : public VertexBufferNumeric1D<T,CHUNKLENGTH> 
+      /// The HDF5 chunk length of the output datasets matches the buffer length.
+      template<class T>
+      class VertexBufferNumeric1D_HDF5 : public VertexBufferNumeric1D<T> 
       {
          private:
            /// Interfaces to HDF5 datasets
-           DataSetInterfaceScalar<bool,CHUNKLENGTH> _dsetvalid; // validity bools
-           DataSetInterfaceScalar<T,CHUNKLENGTH>    _dsetdata;  // actual data 
+           DataSetInterfaceScalar<bool> _dsetvalid; // validity bools
+           DataSetInterfaceScalar<T>    _dsetdata;  // actual data 
 
            /// Getters for HDF5 dataset interfaces (extra error checking)
-           DataSetInterfaceScalar<bool,CHUNKLENGTH>& dsetvalid(); // validity bools
-           DataSetInterfaceScalar<T,CHUNKLENGTH>&    dsetdata();  // actual data             
+           DataSetInterfaceScalar<bool>& dsetvalid(); // validity bools
+           DataSetInterfaceScalar<T>&    dsetdata();  // actual data             
+
+           /// Scratch space for RA writes whose target dataset indices are known,
+           /// allocated once (for non-synchronised buffers) and reused for every write.
+           std::valarray<bool>  now_valid;
+           std::vector<T>       now_write_queue;
+           std::vector<hsize_t> now_abs_write_locations;
+
+           /// Write the first now_i entries of the scratch queue to the datasets
+           void write_now_queue(const uint now_i);
 
            /// Extendible backup buffers for RA writes that need to be
            /// postponed due to the original sync writes not having been
@@ -63,8 +75,29 @@ namespace Gambit {
            std::vector<std::pair<T,PPIDpair>> postpone_write_queue_and_locs;             
 
            /// Dimension-0 index of the next empty hyperslab in the output datasets
+           /// (with a background writer, this counts chunks queued for writing,
+           ///  which may not all have reached the datasets yet)
            unsigned long nextemptyslab = 0;
 
+           /// Background writer which performs the dataset writes of this buffer
+           /// (NULL if the writes happen synchronously). Owned by the printer.
+           HDF5AsyncWriter* writer = NULL;
+
+           /// Second copies of the sync buffer and of the RA scratch queue, allocated once
+           /// when there is a background writer. A full buffer is swapped into its spare and
+           /// written from there by the writer thread, while filling carries on in the storage
+           /// swapped out. A spare is only touched again once the writer has finished the job
+           /// with the ticket recorded here.
+           std::vector<T>          spare_entries;
+           std::valarray<bool>     spare_valid;
+           HDF5AsyncWriter::Ticket spare_ticket = 0;
+           std::vector<T>          spare_write_queue;
+           std::vector<hsize_t>    spare_abs_write_locations;
+           HDF5AsyncWriter::Ticket spare_queue_ticket = 0;
+
+           /// Queue the chunk in the spare sync buffer for writing by the background writer
+           void submit_spare_chunk();
+
            /// Variable obtained from somewhere external to the buffer,
            /// used to track the synchronisation position with other buffers
            /// Currently only used to ensure the RA buffers end up the same
@@ -85,6 +118,9 @@ namespace Gambit {
              , const bool resume
              , const BuffTags& tags
              , const GMPI::Comm& pComm
+             , const std::size_t length
+             , const DataSetLayout& layout
+             , HDF5AsyncWriter* async_writer = NULL
              );
            #endif
  
@@ -98,6 +134,9 @@ namespace Gambit {
              , const bool silence
              , const bool resume
              , const char access
+             , const std::size_t length
+             , const DataSetLayout& layout
+             , HDF5AsyncWriter* async_writer = NULL
              );
      
            /// Destructor
@@ -115,7 +154,7 @@ namespace Gambit {
            virtual void write_to_disk();
 
            /// Write externally-supplied buffer to HDF5 dataset
-           virtual void write_external_to_disk(const T (&values)[CHUNKLENGTH], const bool (&isvalid)[CHUNKLENGTH]);
+           virtual void write_external_to_disk(const T* values, const bool* isvalid);
 
            /// Reset the output (non-synchronised datasets only, unless force=true)
            virtual void reset(bool force=false);
@@ -133,6 +172,9 @@ namespace Gambit {
            /// (really just updates the nextemptyslab variable)
            virtual void update_dset_head_pos()
            {
+              // With a background writer nextemptyslab is advanced as chunks are queued,
+              // and the datasets themselves must not be inspected from this thread.
+              if(writer!=NULL) return;
               if(this->myRank==0 or not this->MPI_mode()) // Only the master process has access to this information, unless we are in non-MPI mode
               {
                 if(dsetvalid().get_nextemptyslab() != dsetdata().get_nextemptyslab())
@@ -165,17 +207,23 @@ namespace Gambit {
       /// @{ VertexBufferNumeric1D_HDF5 member function definitions
  
       /// Constructors
-      template<class T, std::size_t CHUNKLENGTH>
-      VertexBufferNumeric1D_HDF5<T,CHUNKLENGTH>::VertexBufferNumeric1D_HDF5()
-        : VertexBufferNumeric1D<T,CHUNKLENGTH>()
+      template<class T>
+      VertexBufferNumeric1D_HDF5<T>::VertexBufferNumeric1D_HDF5()
+        : VertexBufferNumeric1D<T>()
         , _dsetvalid()
         , _dsetdata()
+        , now_valid()
+        , now_write_queue()
+        , now_abs_write_locations()
         , postpone_write_queue_and_locs()
       {}
 
       #ifdef WITH_MPI
-      template<class T, std::size_t CHUNKLENGTH>
-      VertexBufferNumeric1D_HDF5<T,CHUNKLENGTH>::VertexBufferNumeric1D_HDF5(
+      /// The buffers no longer communicate via MPI themselves, so the tags and
+      /// communicator are unused and this is the same as the no-MPI constructor
+      /// with write access.
+      template<class T>
+      VertexBufferNumeric1D_HDF5<T>::VertexBufferNumeric1D_HDF5(
           hid_t location_id
         , const std::string& name
         , const int vID
@@ -183,59 +231,19 @@ namespace Gambit {
         , const bool sync
         , const bool silence
         , const bool resume
-        , const BuffTags& tags
-        , const GMPI::Comm& pComm
+        , const BuffTags&
+        , const GMPI::Comm&
+        , const std::size_t length
+        , const DataSetLayout& layout
+        , HDF5AsyncWriter* async_writer
         )
-        : VertexBufferNumeric1D<T,CHUNKLENGTH>(
-            name
-          , vID
-          , i
-          , sync
-          , silence
-          , resume
-          , tags
-          , pComm
-          )
-        , _dsetvalid()
-        , _dsetdata()
-        , postpone_write_queue_and_locs()
-      {
-        if(this->MPI_mode() and location_id==-1 and this->myRank==0)
-        {
-           std::ostringstream errmsg;
-           errmsg << "rank "<<this->myRank<<": Error! Tried to create buffer '"<<this->get_label()<<"', but supplied HDF5 location pointer was -1 (and we are the rank 0 process, who needs this pointer)";
-           printer_error().raise(LOCAL_INFO, errmsg.str()); 
-        }
-        else if(not silence)
-        {
-          if(resume) 
-          { 
-             logger()<<LogTags::printers<<"Attempting to resume writing to dataset '"<<name<<"_isvalid'...";
-          }
-          else
-          {
-             logger()<<LogTags::printers<<"Creating new dataset '"<<name<<"_isvalid'...";
-          }
-          _dsetvalid = DataSetInterfaceScalar<bool,CHUNKLENGTH>(location_id, name+"_isvalid", resume);
-
-          if(resume) 
-          { 
-             logger()<<std::endl<<LogTags::printers<<"Attempting to resume writing to dataset '"<<name<<"'...";
-          }
-          else
-          {
-             logger()<<std::endl<<LogTags::printers<<"Creating new dataset '"<<name<<"'...";
-          }
-          _dsetdata  = DataSetInterfaceScalar<T,CHUNKLENGTH>(location_id, name, resume);
-
-          logger()<<EOM; // Leave this to calling function
-        }
-      }
+        : VertexBufferNumeric1D_HDF5(location_id, name, vID, i, sync, silence, resume, 'w', length, layout, async_writer)
+      {}
       #endif     
  
       // No MPI constructor
-      template<class T, std::size_t CHUNKLENGTH>
-      VertexBufferNumeric1D_HDF5<T,CHUNKLENGTH>::VertexBufferNumeric1D_HDF5(
+      template<class T>
+      VertexBufferNumeric1D_HDF5<T>::VertexBufferNumeric1D_HDF5(
           hid_t location_id
         , const std::string& name
         , const int vID
@@ -244,8 +252,11 @@ namespace Gambit {
         , const bool silence
         , const bool resume
         , char access
+        , const std::size_t length
+        , const DataSetLayout& layout
+        , HDF5AsyncWriter* async_writer
         )
-        : VertexBufferNumeric1D<T,CHUNKLENGTH>(
+        : VertexBufferNumeric1D<T>(
             name
           , vID
           , i
@@ -253,11 +264,24 @@ namespace Gambit {
           , silence
           , resume
           , access
+          , length
           )
         , _dsetvalid()
         , _dsetdata()
+        , now_valid(false, (sync or silence) ? 0 : length)
+        , now_write_queue((sync or silence) ? 0 : length)
+        , now_abs_write_locations((sync or silence) ? 0 : length)
         , postpone_write_queue_and_locs()
+        , writer(async_writer)
+        , spare_entries((async_writer==NULL or not sync or silence) ? 0 : length)
+        , spare_valid(false, (async_writer==NULL or not sync or silence) ? 0 : length)
+        , spare_write_queue((async_writer==NULL or sync or silence) ? 0 : length)
+        , spare_abs_write_locations((async_writer==NULL or sync or silence) ? 0 : length)
       {
+        // With a background writer, every RA write job marks all its entries as valid,
+        // reading this from the writer thread
+        if(writer!=NULL) now_valid = true;
+
         if(this->MPI_mode() and location_id==-1 and this->myRank==0)
         {
            std::ostringstream errmsg;
@@ -274,7 +298,10 @@ namespace Gambit {
           {
              logger()<<LogTags::printers<<"Creating new dataset '"<<name<<"_isvalid'...";
           }
-          _dsetvalid = DataSetInterfaceScalar<bool,CHUNKLENGTH>(location_id, name+"_isvalid", resume, this->access_mode());
+          // Chunk the datasets to match the buffer flush size, unless a (compatible) chunk length was chosen
+          DataSetLayout dset_layout(layout);
+          if(dset_layout.chunklength==0) dset_layout.chunklength = length;
+          _dsetvalid = DataSetInterfaceScalar<bool>(location_id, name+"_isvalid", resume, this->access_mode(), dset_layout);
 
           if(resume) 
           { 
@@ -284,15 +311,15 @@ namespace Gambit {
           {
              logger()<<std::endl<<LogTags::printers<<"Creating new dataset '"<<name<<"'...";
           }
-          _dsetdata  = DataSetInterfaceScalar<T,CHUNKLENGTH>(location_id, name, resume, this->access_mode());
+          _dsetdata  = DataSetInterfaceScalar<T>(location_id, name, resume, this->access_mode(), dset_layout);
 
           logger()<<EOM; // Leave this to calling function
         }
       }
  
       /// Destructor
-      template<class T, std::size_t L>
-      VertexBufferNumeric1D_HDF5<T,L>::~VertexBufferNumeric1D_HDF5() 
+      template<class T>
+      VertexBufferNumeric1D_HDF5<T>::~VertexBufferNumeric1D_HDF5() 
       {
          //TODO: Do this in some more controlled way
          //if(this->is_synchronised()) { write_to_disk(); }
@@ -303,8 +330,8 @@ namespace Gambit {
       }
 
       // Print out report on buffer sync status       
-      template<class T, std::size_t L>
-      void VertexBufferNumeric1D_HDF5<T,L>::sync_report()
+      template<class T>
+      void VertexBufferNumeric1D_HDF5<T>::sync_report()
       {
          std::cout<<"rank "<<this->myRank<<":-----------------------------------------"<<std::endl;
          std::cout<<"rank "<<this->myRank<<": Begin sync report for buffer "<<this->get_label()<<std::endl;
@@ -320,8 +347,8 @@ namespace Gambit {
       }
     
       /// @{ Safe dataset getters
-      template<class T, std::size_t L>
-      DataSetInterfaceScalar<bool,L>& VertexBufferNumeric1D_HDF5<T,L>::dsetvalid()
+      template<class T>
+      DataSetInterfaceScalar<bool>& VertexBufferNumeric1D_HDF5<T>::dsetvalid()
       {
         #ifdef WITH_MPI
         if(this->MPI_mode() and this->myRank!=0)
@@ -334,8 +361,8 @@ namespace Gambit {
         return _dsetvalid;
       }
 
-      template<class T, std::size_t L>
-      DataSetInterfaceScalar<T,L>& VertexBufferNumeric1D_HDF5<T,L>::dsetdata()
+      template<class T>
+      DataSetInterfaceScalar<T>& VertexBufferNumeric1D_HDF5<T>::dsetdata()
       {
         #ifdef WITH_MPI
         if(this->MPI_mode() and this->myRank!=0)
@@ -350,20 +377,36 @@ namespace Gambit {
       /// @}
 
       /// Override of buffer dump function to handle HDF5 output
-      template<class T, std::size_t L>
-      void VertexBufferNumeric1D_HDF5<T,L>::write_to_disk()
+      template<class T>
+      void VertexBufferNumeric1D_HDF5<T>::write_to_disk()
       {
          if(this->is_synchronised()) {
            // Check if buffer is empty, and whether we really want to write an
            // empty buffer to disk.
+           // (sync datasets only ever grow by the chunks we write, so with a background
+           //  writer their length is the number of queued entries)
+           const unsigned long dset_length = (writer!=NULL) ? nextemptyslab : dsetvalid().dset_length();
            if( not this->sync_buffer_is_empty() or
-               this->dset_head_pos() >= dsetvalid().dset_length()
+               this->dset_head_pos() >= dset_length
              ) // Should only have to check one of the datasets... perhaps add error checking for this.
            {
-             dsetvalid().writenewchunk(this->buffer_valid); 
-             dsetdata().writenewchunk(this->buffer_entries);
-             // Update the head tracking variables to reflect the new dset chunk
-             update_dset_head_pos();
+             if(writer!=NULL)
+             {
+               // Swap the filled buffer into the spare for the writer thread, and carry on
+               // filling the previous spare (reset by the clear() following this call).
+               // This only blocks if the writer is still writing the previous chunk.
+               writer->wait_for(spare_ticket);
+               this->buffer_entries.swap(spare_entries);
+               this->buffer_valid.swap(spare_valid);
+               submit_spare_chunk();
+             }
+             else
+             {
+               dsetvalid().writenewchunk(&this->buffer_valid[0], this->get_bufferlength()); 
+               dsetdata().writenewchunk(&this->buffer_entries[0], this->get_bufferlength());
+               // Update the head tracking variables to reflect the new dset chunk
+               update_dset_head_pos();
+             }
            }
          }
          else {
@@ -374,20 +417,48 @@ namespace Gambit {
       }
 
       /// Manual command to send an arbitrary buffer to be written to disk
-      template<class T, std::size_t CHUNKLENGTH>
-      void VertexBufferNumeric1D_HDF5<T,CHUNKLENGTH>::write_external_to_disk(const T (&values)[CHUNKLENGTH], const bool (&isvalid)[CHUNKLENGTH])
+      template<class T>
+      void VertexBufferNumeric1D_HDF5<T>::write_external_to_disk(const T* values, const bool* isvalid)
       {
          if(not this->is_silenced()) {
-           dsetvalid().writenewchunk(isvalid); 
-           dsetdata().writenewchunk(values);
-           // Update sync information to reflect the presence of the new chunk
-           update_dset_head_pos();
+           if(writer!=NULL)
+           {
+             // The caller keeps its buffer, so copy it into the spare for the writer thread
+             const std::size_t length = this->get_bufferlength();
+             writer->wait_for(spare_ticket);
+             spare_entries.assign(values, values+length);
+             if(spare_valid.size()!=length) spare_valid.resize(length);
+             std::copy(isvalid, isvalid+length, &spare_valid[0]);
+             submit_spare_chunk();
+           }
+           else
+           {
+             dsetvalid().writenewchunk(isvalid, this->get_bufferlength()); 
+             dsetdata().writenewchunk(values, this->get_bufferlength());
+             // Update sync information to reflect the presence of the new chunk
+             update_dset_head_pos();
+           }
          }
       }
 
+      /// Queue the chunk in the spare sync buffer for writing by the background writer.
+      /// nextemptyslab moves on straight away, so that the sync position bookkeeping
+      /// is unaffected by the write latency.
+      template<class T>
+      void VertexBufferNumeric1D_HDF5<T>::submit_spare_chunk()
+      {
+         const std::size_t length = this->get_bufferlength();
+         spare_ticket = writer->submit([this, length]()
+         {
+           dsetvalid().writenewchunk(&spare_valid[0], length);
+           dsetdata().writenewchunk(&spare_entries[0], length);
+         });
+         nextemptyslab += length;
+      }
+
       /// Reset the output (non-synchronised datasets only)
-      template<class T, std::size_t L>
-      void VertexBufferNumeric1D_HDF5<T,L>::reset(bool force) 
+      template<class T>
+      void VertexBufferNumeric1D_HDF5<T>::reset(bool force) 
       { 
          if(not force and this->is_synchronised())
          {
@@ -396,6 +467,9 @@ namespace Gambit {
             printer_error().raise(LOCAL_INFO, errmsg.str()); 
          }
 
+         // Datasets are about to be rewritten from this thread
+         if(writer!=NULL) writer->wait();
+
          // Clear the sync buffers
          this->clear();
 
@@ -413,25 +487,57 @@ namespace Gambit {
             // Point the write head (or "cursor") back at the beginning of the output datasets.
             dsetvalid().reset_nextemptyslab();
             dsetdata().reset_nextemptyslab();
+            if(writer!=NULL) nextemptyslab = 0;
+         }
+      }
+
+      /// Write the first now_i entries of the RA scratch queue to disk
+      template<class T>
+      void VertexBufferNumeric1D_HDF5<T>::write_now_queue(const uint now_i)
+      {
+         if(now_i>now_write_queue.size())
+         {
+            std::ostringstream errmsg;
+            errmsg << "rank "<<this->myRank<<": Error! now_i has exceeded the buffer length (now_i=="<<now_i<<", length=="<<now_write_queue.size()<<"). (buffer name = "<<this->get_label()<<")";
+            printer_error().raise(LOCAL_INFO, errmsg.str()); 
          }
+         #ifdef DEBUG_MODE
+         std::cout<<"rank "<<this->myRank<<": writing buffer for "<<this->get_label()<<" to disk; now_i="<<now_i<<std::endl;
+         #endif
+         if(writer!=NULL)
+         {
+            // The scratch queue is refilled straight away, so swap it into the spare
+            // for the writer thread (blocking only if the writer still has the spare)
+            writer->wait_for(spare_queue_ticket);
+            now_write_queue.swap(spare_write_queue);
+            now_abs_write_locations.swap(spare_abs_write_locations);
+            spare_queue_ticket = writer->submit([this, now_i]()
+            {
+              dsetvalid().RA_write(&now_valid[0],         &spare_abs_write_locations[0], now_i);
+              dsetdata().RA_write (&spare_write_queue[0], &spare_abs_write_locations[0], now_i);
+            });
+            return;
+         }
+         now_valid = false;
+         std::fill(&now_valid[0], &now_valid[0]+now_i, true); 
+         dsetvalid().RA_write(&now_valid[0],       &now_abs_write_locations[0], now_i); 
+         dsetdata().RA_write (&now_write_queue[0], &now_abs_write_locations[0], now_i);
       }
 
       /// Attempt to write postponed RA entries to disk 
-      template<class T, std::size_t CHUNKLENGTH>
-      void VertexBufferNumeric1D_HDF5<T,CHUNKLENGTH>::attempt_postponed_RA_write_to_disk(const std::map<PPIDpair, ulong>& PPID_to_dsetindex)
+      template<class T>
+      void VertexBufferNumeric1D_HDF5<T>::attempt_postponed_RA_write_to_disk(const std::map<PPIDpair, ulong>& PPID_to_dsetindex)
       {
          /// Use the provided PPIDpair-->dset_location map to locate the target
          /// parameter points in the output dataset. 
-         /// (Temp RA buffers for immediate writes)
-         bool valid[CHUNKLENGTH]; 
-         T        now_write_queue[CHUNKLENGTH];             
-         hsize_t  now_abs_write_locations[CHUNKLENGTH];
+         /// (Temp RA buffers for immediate writes are the now_* members)
+         const std::size_t length = now_write_queue.size();
          uint     now_i=0; // queue_length
 
          /// Postponed entries which still cannot be written will be added here.
          std::vector<std::pair<T,PPIDpair>> failed;
          
-         /// Need to go through the postponed entries one CHUNKLENGTH at a time
+         /// Need to go through the postponed entries one buffer length at a time
          typedef typename std::vector<std::pair<T,PPIDpair>>::iterator it_type;
          it_type itpp = postpone_write_queue_and_locs.begin();
          while(itpp != postpone_write_queue_and_locs.end())
@@ -462,21 +568,11 @@ namespace Gambit {
             // Write "now" buffers to disk, if they aren't empty
             if(now_i != 0)
             {
-               if(now_i>CHUNKLENGTH)
-               {
-                  std::ostringstream errmsg;
-                  errmsg << "rank "<<this->myRank<<": Error! now_i has exceeded CHUNKLENGTH (now_i=="<<now_i<<") during attempt to perform postponed RA_writes. (buffer name = "<<this->get_label()<<")";
-                  printer_error().raise(LOCAL_INFO, errmsg.str()); 
-               }
-
                // Do the write only if buffer is full or postpone queue is finished and we
                // are about to finish looping.
-               if(now_i==CHUNKLENGTH or itpp == postpone_write_queue_and_locs.end())
+               if(now_i==length or itpp == postpone_write_queue_and_locs.end())
                {
-                  std::fill(valid, valid+CHUNKLENGTH, false); 
-                  std::fill(valid, valid+now_i, true); 
-                  dsetvalid().RA_write(valid,           now_abs_write_locations, now_i); 
-                  dsetdata().RA_write (now_write_queue, now_abs_write_locations, now_i);
+                  write_now_queue(now_i);
                   //std::cout<<"Wrote "<<now_i<<" postponed RA items to disk"<<std::endl;
                   now_i = 0; // Reset buffer
                }
@@ -488,8 +584,8 @@ namespace Gambit {
 
 
       /// Send random access write queue to dataset interfaces for writing
-      template<class T, std::size_t CHUNKLENGTH>
-      void VertexBufferNumeric1D_HDF5<T,CHUNKLENGTH>::RA_write_to_disk(const std::map<PPIDpair, ulong>& PPID_to_dsetindex)
+      template<class T>
+      void VertexBufferNumeric1D_HDF5<T>::RA_write_to_disk(const std::map<PPIDpair, ulong>& PPID_to_dsetindex)
       {
         if(this->is_synchronised())
         {
@@ -500,8 +596,20 @@ namespace Gambit {
 
         if(not this->is_silenced()) 
          {
-            dsetvalid().extend_dset(target_sync_pos);
-            dsetdata().extend_dset(target_sync_pos);
+            if(writer!=NULL)
+            {
+               const unsigned long pos = target_sync_pos;
+               writer->submit([this, pos]()
+               {
+                 dsetvalid().extend_dset(pos);
+                 dsetdata().extend_dset(pos);
+               });
+            }
+            else
+            {
+               dsetvalid().extend_dset(target_sync_pos);
+               dsetdata().extend_dset(target_sync_pos);
+            }
 
             #ifdef DEBUG_MODE
             std::cout<<"rank "<<this->myRank<<": Extended RA dset '"<<this->get_label()<<"' to at least size "<<target_sync_pos<<std::endl; 
@@ -520,10 +628,7 @@ namespace Gambit {
 
                /// Use the provided PPIDpair-->dset_location map to locate the target
                /// parameter points in the output dataset. 
-               /// (Temp RA buffers for immediate writes)
-               bool valid[CHUNKLENGTH]; 
-               T        now_write_queue[CHUNKLENGTH];             
-               hsize_t  now_abs_write_locations[CHUNKLENGTH];
+               /// (Temp RA buffers for immediate writes are the now_* members)
                uint     now_i=0; // queue_length
 
                // Now go through the current RA_queue and try to write them to disk
@@ -555,19 +660,7 @@ namespace Gambit {
                // Write "now" buffers to disk, if they aren't empty
                if(now_i != 0)
                {
-                  if(now_i>CHUNKLENGTH)
-                  {
-                     std::ostringstream errmsg;
-                     errmsg << "rank "<<this->myRank<<": Error! now_i has exceeded CHUNKLENGTH (now_i=="<<now_i<<"). (buffer name = "<<this->get_label()<<")";
-                     printer_error().raise(LOCAL_INFO, errmsg.str()); 
-                  }
-                  std::fill(valid, valid+CHUNKLENGTH, false); 
-                  std::fill(valid, valid+now_i, true); 
-                  #ifdef DEBUG_MODE
-                  std::cout<<"rank "<<this->myRank<<": writing buffer for "<<this->get_label()<<" to disk; now_i="<<now_i<<std::endl;
-                  #endif
-                  dsetvalid().RA_write(valid,           now_abs_write_locations, now_i); 
-                  dsetdata().RA_write (now_write_queue, now_abs_write_locations, now_i);
+                  write_now_queue(now_i);
                }
 
             }
@@ -581,8 +674,8 @@ namespace Gambit {
       /// NEW MEANING:
       /// Ensure that the supplied index has been written to, and that the
       /// next append will happen to the next index above it.
-      template<class T, std::size_t L>
-      void VertexBufferNumeric1D_HDF5<T,L>::synchronise_output_to_position(const ulong sync_pos)
+      template<class T>
+      void VertexBufferNumeric1D_HDF5<T>::synchronise_output_to_position(const ulong sync_pos)
       {
          if(not this->is_silenced()) 
          {
@@ -636,7 +729,7 @@ namespace Gambit {
                  }
                  // otherwise no problem; carry on.
                }
-               else if (movediff>1) // and movediff!=CHUNKLENGTH+1) 
+               else if (movediff>1) // and movediff!=bufferlength+1) 
                {
                    std::ostringstream errmsg;
                    errmsg << "rank "<<this->myRank<<": Error! Attempted to move HDF5 write position by >1 slots ("<<movediff<<") in buffer with label '"<<this->get_label()<<"' (movediff ("<<movediff<<") = sync_pos ("<<sync_pos<<")+1 - dset_head_pos() ("<<this->dset_head_pos()<<")). Buffer synchronisation should only happen one slot at a time. This is a bug in the VertexBufferNumeric1D_HDF5 class or in a class which uses it (probably HDF5Printer). Please report it.";
@@ -647,10 +740,10 @@ namespace Gambit {
                #ifdef MONITOR_BUF
                if(this->get_label()==MONITOR_BUF) {
                #endif
-               long slots_left = L;
+               long slots_left = this->get_bufferlength();
                slots_left -= this->get_head_position() - this->donepoint();
                std::cout<<"rank "<<this->myRank<<": Moved "<<movediff<<" slot(s). # unwritten slots left in buffer = "<<slots_left<<". buffer_is_full = "<<this->sync_buffer_is_full()<<std::endl;         
-               std::cout<<"rank "<<this->myRank<<":   Buffer length:"<<L<<std::endl;
+               std::cout<<"rank "<<this->myRank<<":   Buffer length:"<<this->get_bufferlength()<<std::endl;
                std::cout<<"rank "<<this->myRank<<":   head_position:"<<this->get_head_position()<<std::endl;	 
                std::cout<<"rank "<<this->myRank<<":   donepoint()  :"<<this->donepoint()<<std::endl;		
 	
@@ -662,9 +755,10 @@ namespace Gambit {
          }
       }
  
-      template<class T, std::size_t L>
-      ulong VertexBufferNumeric1D_HDF5<T,L>::get_dataset_length()
+      template<class T>
+      ulong VertexBufferNumeric1D_HDF5<T>::get_dataset_length()
       {
+         if(writer!=NULL) writer->wait();
          if(dsetvalid().dset_length() != dsetdata().dset_length())
          {
             std::ostringstream errmsg;
@@ -675,9 +769,10 @@ namespace Gambit {
       }
 
       // Finalise writing to underlying output. Do not do any more writing after this!
-      template<class T, std::size_t L>
-      void VertexBufferNumeric1D_HDF5<T,L>::finalise()
+      template<class T>
+      void VertexBufferNumeric1D_HDF5<T>::finalise()
       {
+         if(writer!=NULL) writer->wait();
          dsetdata().closeDataSet();
          dsetvalid().closeDataSet();
       }
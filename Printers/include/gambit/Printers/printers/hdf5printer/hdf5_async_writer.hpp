@@ -0,0 +1,115 @@
+//   GAMBIT: Global and Modular BSM Inference Tool
+//   *********************************************
+///  \file
+///
+///  Declaration of the background writer used by
+///  the HDF5Printer to move dataset writes off the
+///  likelihood call path.
+///
+///  *********************************************
+///
+///  Authors (add name and date if you modify):
+///
+///  \author agent
+///          (agent@local)
+///  \date 2026 Oct
+///
+///  *********************************************
+
+#ifndef __hdf5_async_writer_hpp__
+#define __hdf5_async_writer_hpp__
+
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <functional>
+#include <condition_variable>
+
+namespace Gambit {
+
+  namespace Printers {
+
+      /// Single background thread which performs HDF5 write jobs in the order
+      /// they were submitted. Keeping the jobs strictly ordered means that e.g.
+      /// random-access writes always land after the sync writes queued before
+      /// them, exactly as if everything had been written synchronously.
+      ///
+      /// Jobs either own (copies of) the data they write, or read storage that
+      /// the submitting buffer leaves alone until wait_for() says the job is
+      /// done, so the buffer can carry on filling immediately. Jobs are given
+      /// tickets in submission order for this. The writer thread never logs anything:
+      /// errors in a job (see raise_printer_error) are recorded, and raised as
+      /// a printer_error on the calling thread at the next submit() or wait().
+      /// Queued jobs after a failed one are discarded.
+      ///
+      /// All HDF5 access from the calling thread that overlaps with queued jobs
+      /// must go through a thread-safe HDF5 library (see is_usable()).
+      class HDF5AsyncWriter
+      {
+        public:
+          typedef std::function<void()> Job;
+
+          /// Position of a job in the order of submission (the first job gets 1)
+          typedef unsigned long Ticket;
+
+          /// Starts the writer thread
+          HDF5AsyncWriter();
+
+          /// Completes all queued jobs and stops the writer thread
+          /// (errors at this stage can no longer be reported, so are dropped)
+          ~HDF5AsyncWriter();
+
+          /// Queue a job for the writer thread, returning its ticket
+          Ticket submit(const Job& job);
+
+          /// Block until every queued job has been performed
+          void wait();
+
+          /// Block until the job with the given ticket, and so every job before
+          /// it, has been performed or discarded (returns at once if it has)
+          void wait_for(Ticket ticket);
+
+          /// Check whether the HDF5 library allows writes from a background thread
+          static bool is_usable();
+
+        private:
+          /// Main loop of the writer thread
+          void run();
+
+          /// Raise (and forget) the error recorded from a failed job (mtx must be held)
+          void rethrow_error();
+
+          std::mutex mtx;
+          std::condition_variable job_ready;
+          std::condition_variable all_done;
+          std::deque<Job> jobs;
+
+          /// True while the writer thread is performing a job
+          bool busy;
+
+          /// Number of jobs submitted, and number performed or discarded
+          Ticket submitted;
+          Ticket finished;
+
+          /// Set by the destructor to tell the writer thread to exit
+          bool stop;
+
+          /// Whether a job has failed since the last submit() or wait(), and where and why
+          bool failed;
+          std::string error_origin;
+          std::string error_message;
+
+          std::thread thread;
+      };
+
+      /// Raise a printer_error, unless called from an HDF5AsyncWriter thread. The
+      /// writer thread must not touch the logger or the shared error objects, so
+      /// there the error is only recorded, to be raised on the submitting thread.
+      /// Use this instead of printer_error().raise in anything a writer job calls.
+      void raise_printer_error(const std::string& origin, const std::string& message);
+
+  }
+}
+
+#endif
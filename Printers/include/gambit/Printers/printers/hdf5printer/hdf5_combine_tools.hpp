@@ -20,8 +20,10 @@
 #ifndef __hdf5_combine_tools_hpp__
 #define __hdf5_combine_tools_hpp__
 
+#include <map>
 #include <vector>
 #include <sstream>
+#include <algorithm>
 #include <unordered_set>
 #include <unordered_map> 
 #include <hdf5.h>
@@ -58,32 +60,81 @@ namespace Gambit
                 }
             };
 
+            /// Number of entries read or written at once while combining datasets. This bounds the
+            /// memory used for each dataset being copied, whatever the total number of points.
+            static const hsize_t COMBINE_BLOCKLENGTH = 1000000;
+
+            /// Raise a printer error, or, in a job run concurrently with others while combining
+            /// datasets, hand the error back to be raised once all the jobs have finished
+            void raise_combine_error(const std::string& origin, const std::string& message);
+
+            /// Read 'length' entries of a 1D dataset, starting at 'offset', into 'buffer' (of memory type 'memtype')
+            void read_block(hid_t dataset, hid_t memtype, hsize_t offset, hsize_t length, void* buffer);
+
+            /// Write 'length' entries from 'buffer' (of memory type 'memtype') into a 1D dataset, starting at 'offset'
+            void write_block(hid_t dataset, hid_t memtype, hsize_t offset, hsize_t length, const void* buffer);
+
+            /// Write entries from 'buffer' (of memory type 'memtype') to the listed positions of a 1D dataset
+            void write_points(hid_t dataset, hid_t memtype, const std::vector<hsize_t>& coords, const void* buffer);
+
+            /// Length of a 1D '_isvalid' dataset once any trailing invalid entries are dropped
+            hsize_t valid_length(hid_t isvalid_dataset);
+
             struct copy_hdf5
             {
+                /// Copy the old combined data (if any) followed by the first sizes[i] entries of each temp file
+                /// dataset into the output dataset, one block at a time. Missing inputs are filled with zeros.
                 template <typename U>
-                static void run(U, hid_t &dataset_out, std::vector<hid_t> &datasets, unsigned long long &size_tot, std::vector<unsigned long long> &sizes, hid_t &old_dataset)
+                static void run(U, hid_t &dataset_out, std::vector<hid_t> &datasets, unsigned long long &old_size, std::vector<unsigned long long> &sizes, hid_t &old_dataset)
                 {
-                    std::vector<U> data(size_tot);
-                    unsigned long long j = 0;
-                    
+                    const hid_t memtype = get_hdf5_data_type<U>::type();
+                    std::vector<U> block;
+                    unsigned long long j = 0; // next position to write to in the output dataset
+
+                    // Copy n entries from src (or zeros, if src<0) to the output, starting from position j
+                    auto copy_blocks = [&](hid_t src, unsigned long long n)
+                    {
+                        for (unsigned long long offset = 0; offset < n; offset += COMBINE_BLOCKLENGTH)
+                        {
+                            const hsize_t length = std::min<unsigned long long>(COMBINE_BLOCKLENGTH, n - offset);
+                            if (src >= 0)
+                            {
+                                block.resize(length);
+                                read_block(src, memtype, offset, length, &block[0]);
+                            }
+                            else
+                            {
+                                block.assign(length, U());
+                            }
+                            write_block(dataset_out, memtype, j + offset, length, &block[0]);
+                        }
+                        j += n;
+                    };
+
                     if (old_dataset >= 0)
                     {
                         hid_t space = H5Dget_space(old_dataset);
                         hsize_t dim_t = H5Sget_simple_extent_npoints(space);
                         H5Sclose(space);
-                        data.resize(dim_t + size_tot);
-                        H5Dread(old_dataset, get_hdf5_data_type<U>::type(), H5S_ALL, H5S_ALL, H5P_DEFAULT, (void *)&data[0]);
-                        j = dim_t;
+                        if (dim_t != old_size)
+                        {
+                            std::ostringstream errmsg;
+                            errmsg << "Error copying parameter. Dataset in the previous combined output has length "<<dim_t<<", but the 'pointID' dataset there has length "<<old_size<<".";
+                            raise_combine_error(LOCAL_INFO, errmsg.str());
+                        }
+                        copy_blocks(old_dataset, old_size);
+                    }
+                    else
+                    {
+                        // Parameter absent from the previous combined output; leave its old points empty
+                        copy_blocks(-1, old_size);
                     }
-                    
+
                     for (int i = 0, end = datasets.size(); i < end; i++)
                     {
                         hsize_t dim_t;
                         if(datasets[i] >= 0)
                         {
-                           // Read the dataset in to buffer
-                           H5Dread(datasets[i], get_hdf5_data_type<U>::type(), H5S_ALL, H5S_ALL, H5P_DEFAULT, (void *)&data[j]);
-                           
                            hid_t space = H5Dget_space(datasets[i]);
                            dim_t = H5Sget_simple_extent_npoints(space);
                            H5Sclose(space);
@@ -98,13 +149,13 @@ namespace Gambit
                         if (dim_t >= sizes[i])
                         {
                             // Data had expected size, no problem
-                            // NOTE: Why can dim_t be larger than expected? Possible padding at end or something?
-                            j += sizes[i];
+                            // (dim_t can be larger than sizes[i] because trailing invalid entries are dropped)
+                            copy_blocks(datasets[i], sizes[i]);
                         }
                         else if(dim_t==0)
                         {
                             // Data was missing, but also probably fine, just skip it
-                            j += sizes[i];
+                            copy_blocks(-1, sizes[i]);
                         }
                         else
                         {
@@ -112,67 +163,44 @@ namespace Gambit
                             std::ostringstream errmsg;
                             errmsg << "Error copying parameter "".  Dataset in input file " << i << " did not have the expected size" <<std::endl;
                             errmsg << "(sizes["<<i<<"] = "<<sizes[i]<<" was less than dim_t = "<<dim_t<<")";
-                            printer_error().raise(LOCAL_INFO, errmsg.str());
+                            raise_combine_error(LOCAL_INFO, errmsg.str());
                         }
                     }
-                    
-                    H5Dwrite( dataset_out, get_hdf5_data_type<U>::type(), H5S_ALL, H5S_ALL, H5P_DEFAULT, (void *)&data[0]);
                 }
             };
 
             struct ra_copy_hdf5
             {
+                /// Write the RA entries of each temp file into the (already copied) primary points that they
+                /// target. The inputs, and the RA_pointID and RA_MPIrank datasets that identify their targets,
+                /// are read one block at a time, and only the targeted entries of the output are written, so
+                /// neither the inputs nor the output datasets ever have to be held in memory.
                 template <typename U>
-                static void run (U, hid_t &dataset_out, hid_t &dataset2_out, std::vector<hid_t> &datasets, std::vector<hid_t> &datasets2, const unsigned long long size, const std::unordered_map<PPIDpair, unsigned long long, PPIDHash, PPIDEqual>& RA_write_hash, const std::vector<std::vector <unsigned long long> > &pointid, const std::vector<std::vector <unsigned long long> > &rank, const std::vector<unsigned long long> &aux_sizes, hid_t &/*old_dataset*/, hid_t &/*old_dataset2*/)
+                static void run (U, hid_t &dataset_out, hid_t &dataset2_out, std::vector<hid_t> &datasets, std::vector<hid_t> &datasets2, const unsigned long long size, const std::unordered_map<PPIDpair, unsigned long long, PPIDHash, PPIDEqual>& RA_write_hash, const std::vector<hid_t> &pointid, const std::vector<hid_t> &rank, const std::vector<unsigned long long> &aux_sizes, bool &fresh)
                 {
-                    std::vector<U> output(size, 0);
-                    std::vector<int> valids(size, 0);
-
-                    // Should no longer need the old datasets, they should have already been copied during "copy_hdf5"
-                    // if (old_dataset >= 0 && old_dataset2 >= 0)
-                    // {
-                    //     hid_t space  = HDF5::getSpace(old_dataset);
-                    //     hid_t space2 = HDF5::getSpace(old_dataset2);
-                    //     hsize_t old_size  = H5Sget_simple_extent_npoints(space);
-                    //     hsize_t old_size2 = H5Sget_simple_extent_npoints(space2);
-                    //     HDF5::closeSpace(space);
-                    //     HDF5::closeSpace(space2);
-                    //     if(old_size > size or old_size2 > size)
-                    //     {
-                    //        std::ostringstream errmsg;
-                    //        errmsg << "Error copying old dataset into buffer! The old dataset has a larger size than has been allocated for new data! (old_size="<<old_size<<", old_size2="<<old_size2<<", new_size="<<size<<")";
-                    //        printer_error().raise(LOCAL_INFO, errmsg.str());
-                    //     }
-                    //     H5Dread(old_dataset,  get_hdf5_data_type<U>::type(), H5S_ALL, H5S_ALL, H5P_DEFAULT, (void *)&output[0]);
-                    //     H5Dread(old_dataset2, get_hdf5_data_type<int>::type(), H5S_ALL, H5S_ALL, H5P_DEFAULT, (void *)&valids[0]);
-                    // }
-
-                    // Instead we just need to read in the recently-copied primary points and replace
-                    // entries as needed (TODO: would use much less memory if we just write individual replacements
-                    // straight to disk)
-                    if (dataset_out >= 0 && dataset2_out >= 0)
+                    const hid_t memtype = get_hdf5_data_type<U>::type();
+                    const hid_t validtype = get_hdf5_data_type<int>::type();
+                    const hid_t idtype = get_hdf5_data_type<unsigned long long>::type();
+
+                    if (dataset_out < 0 or dataset2_out < 0)
+                    {
+                        std::ostringstream errmsg;
+                        errmsg << "Error copying RA points! Could not open the output datasets (were they created properly during 'copy_hdf5' operation?).";
+                        raise_combine_error(LOCAL_INFO, errmsg.str());
+                    } 
+
+                    // A dataset which only receives RA points must first be filled with (invalid) zeros
+                    if (fresh)
                     {
-                        hid_t space  = HDF5::getSpace(dataset_out);
-                        hid_t space2 = HDF5::getSpace(dataset2_out);
-                        hsize_t out_size  = HDF5::getSimpleExtentNpoints(space);
-                        hsize_t out_size2 = HDF5::getSimpleExtentNpoints(space2);
-                        HDF5::closeSpace(space);
-                        HDF5::closeSpace(space2);
-                        if(out_size > size or out_size2 > size)
+                        for (unsigned long long offset = 0; offset < size; offset += COMBINE_BLOCKLENGTH)
                         {
-                           std::ostringstream errmsg;
-                           errmsg << "Error copying dataset into buffer for RA replacements! The dataset has a larger size than has been allocated for new data! (out_size="<<out_size<<", out_size2="<<out_size2<<", expected_size="<<size<<")";
-                           printer_error().raise(LOCAL_INFO, errmsg.str());
+                            const hsize_t length = std::min<unsigned long long>(COMBINE_BLOCKLENGTH, size - offset);
+                            const std::vector<U> zeros(length, U());
+                            const std::vector<int> zero_valids(length, 0);
+                            write_block(dataset_out,  memtype,   offset, length, &zeros[0]);
+                            write_block(dataset2_out, validtype, offset, length, &zero_valids[0]);
                         }
-                        H5Dread(dataset_out,  get_hdf5_data_type<U>::type(),   H5S_ALL, H5S_ALL, H5P_DEFAULT, (void *)&output[0]);
-                        H5Dread(dataset2_out, get_hdf5_data_type<int>::type(), H5S_ALL, H5S_ALL, H5P_DEFAULT, (void *)&valids[0]);
                     }
-                    else
-                    {
-                        std::ostringstream errmsg;
-                        errmsg << "Error copying datasets into buffer for RA replacements! Could not open datasets (were they created properly during 'copy_hdf5' operation?).";
-                        printer_error().raise(LOCAL_INFO, errmsg.str());
-                    } 
 
                     // Check that all the input given is consistent in length
                     size_t ndsets = datasets.size();
@@ -181,7 +209,7 @@ namespace Gambit
                     { \
                        std::ostringstream errmsg; \
                        errmsg << STRINGIFY(VEC) << " vector has inconsistent size! ("<<VEC.size()<<", should be "<<ndsets<<"). This is a bug, please report it."; \
-                       printer_error().raise(LOCAL_INFO, errmsg.str()); \
+                       raise_combine_error(LOCAL_INFO, errmsg.str()); \
                     }
                     DSET_SIZE_CHECK(datasets2)
                     DSET_SIZE_CHECK(aux_sizes)
@@ -189,6 +217,17 @@ namespace Gambit
                     DSET_SIZE_CHECK(rank)
                     #undef DSET_SIZE_CHECK
  
+                    // Buffers for one block of input, and for the replacements it produces. The
+                    // replacements are keyed (and so sorted) by target, so that a later write to
+                    // the same point supersedes an earlier one, as it would in a sequential copy.
+                    std::vector<U> data;
+                    std::vector<int> valid;
+                    std::vector<unsigned long long> ptids, ranks;
+                    std::map<unsigned long long, U> replacements;
+                    std::vector<hsize_t> coords;
+                    std::vector<U> values;
+                    std::vector<int> ones;
+
                     // Additional iterators to be iterated in sync with dataset iteration
                     // We are actually only copying over one 'parameter' in this function,
                     // but are looping over matching datasets from the temp files from
@@ -210,63 +249,75 @@ namespace Gambit
                           {
                               std::ostringstream errmsg;
                               errmsg << "dataset2 iterator ('isvalid') points to an open dataset, while dataset iterator (main dataset) does not. This is inconsistent and indicates either a bug in this combine code, or in the code which generated the datasets, please report it.";
-                              printer_error().raise(LOCAL_INFO, errmsg.str());
+                              raise_combine_error(LOCAL_INFO, errmsg.str());
                           }
+                          continue;
                        }
-                       else
+
+                       hid_t space = H5Dget_space(*it);
+                       hssize_t dim_t = H5Sget_simple_extent_npoints(space);
+                       H5Sclose(space);
+                       if((unsigned long long)dim_t < *st)
                        {
-                          hid_t space = H5Dget_space(*it);
-                          hssize_t dim_t = H5Sget_simple_extent_npoints(space);
-                          std::vector<U> data(dim_t);
-                          std::vector<bool> valid;
-                          Enter_HDF5<read_hdf5> (*itv, valid);
-                          H5Dread(*it, get_hdf5_data_type<U>::type(), H5S_ALL, H5S_ALL, H5P_DEFAULT, (void *)&data[0]);
-                          
-                          if((unsigned long long)dim_t < *st)
-                          {
-                              std::ostringstream errmsg;
-                              errmsg << "Error copying aux parameter.  Input file smaller than required.";
-                              printer_error().raise(LOCAL_INFO, errmsg.str());
-                          }
+                           std::ostringstream errmsg;
+                           errmsg << "Error copying aux parameter.  Input file smaller than required.";
+                           raise_combine_error(LOCAL_INFO, errmsg.str());
+                       }
+
+                       for (unsigned long long offset = 0; offset < *st; offset += COMBINE_BLOCKLENGTH)
+                       {
+                          const hsize_t length = std::min<unsigned long long>(COMBINE_BLOCKLENGTH, *st - offset);
+                          data.resize(length);
+                          valid.resize(length);
+                          ptids.resize(length);
+                          ranks.resize(length);
+                          read_block(*it,  memtype,   offset, length, &data[0]);
+                          read_block(*itv, validtype, offset, length, &valid[0]);
+                          read_block(*pt,  idtype,    offset, length, &ptids[0]);
+                          read_block(*ra,  idtype,    offset, length, &ranks[0]);
 
-                          for (int i = 0, end = *st; i < end; i++)
+                          replacements.clear();
+                          for (hsize_t k = 0; k < length; k++)
                           {
-                              if (valid[i])
+                              if (not valid[k]) continue;
+
+                              // Look up target for write in hash map
+                              std::unordered_map<PPIDpair, unsigned long long, PPIDHash, PPIDEqual>::const_iterator ihash = RA_write_hash.find(PPIDpair(ptids[k],ranks[k]));
+                              if(ihash == RA_write_hash.end())
                               {
-                                  // Look up target for write in hash map
-                                  std::unordered_map<PPIDpair, unsigned long long, PPIDHash, PPIDEqual>::const_iterator ihash = RA_write_hash.find(PPIDpair((*pt)[i],(*ra)[i]));
-                                  if(ihash != RA_write_hash.end())
-                                  {
-                                      // found hash key, copy data
-                                      unsigned long long temp = ihash->second;
-                                      if(temp > size)
-                                      {
-                                          std::ostringstream errmsg;
-                                          errmsg << "Error copying random access parameter. The hash entry for "
-                                          << "pt number " << (*pt)[i] << " of rank " << (*ra)[i]  
-                                          << " targets the point outside the size of the output dataset ("<<temp<<" > "<<size<<")." 
-                                          << "This indicates"
-                                          << " a bug in the hash generation, please report it."; 
-                                          printer_error().raise(LOCAL_INFO, errmsg.str());
-                                      }
-                                      output[temp] = data[i];
-                                      valids[temp] = 1;
-                                  }
-                                  else
-                                  {
-                                     std::ostringstream errmsg;
-                                     errmsg << "Error copying random access parameter. Could not find "
-                                     << "pt number " << (*pt)[i] << " of rank " << (*ra)[i]  
-                                     << " in the output dataset (hash entry was not found).";
-                                     printer_error().raise(LOCAL_INFO, errmsg.str());
-                                  }
+                                 std::ostringstream errmsg;
+                                 errmsg << "Error copying random access parameter. Could not find "
+                                 << "pt number " << ptids[k] << " of rank " << ranks[k]  
+                                 << " in the output dataset (hash entry was not found).";
+                                 raise_combine_error(LOCAL_INFO, errmsg.str());
                               }
+                              const unsigned long long temp = ihash->second;
+                              if(temp >= size)
+                              {
+                                  std::ostringstream errmsg;
+                                  errmsg << "Error copying random access parameter. The hash entry for "
+                                  << "pt number " << ptids[k] << " of rank " << ranks[k]  
+                                  << " targets the point outside the size of the output dataset ("<<temp<<" >= "<<size<<")." 
+                                  << "This indicates"
+                                  << " a bug in the hash generation, please report it."; 
+                                  raise_combine_error(LOCAL_INFO, errmsg.str());
+                              }
+                              replacements[temp] = data[k];
                           }
-                       } // end if
+                          if (replacements.empty()) continue;
+
+                          coords.clear();
+                          values.clear();
+                          for (auto r = replacements.begin(); r != replacements.end(); ++r)
+                          {
+                              coords.push_back(r->first);
+                              values.push_back(r->second);
+                          }
+                          ones.assign(coords.size(), 1);
+                          write_points(dataset_out,  memtype,   coords, &values[0]);
+                          write_points(dataset2_out, validtype, coords, &ones[0]);
+                       }
                     }
-                    
-                    H5Dwrite( dataset_out, get_hdf5_data_type<U>::type(), H5S_ALL, H5S_ALL, H5P_DEFAULT, (void *)&output[0]);
-                    H5Dwrite( dataset2_out, get_hdf5_data_type<int>::type(), H5S_ALL, H5S_ALL, H5P_DEFAULT, (void *)&valids[0]);
                 }
             };
 
@@ -277,7 +328,7 @@ namespace Gambit
                 {
                    std::ostringstream errmsg;
                    errmsg << "Invalid dataset supplied to Enter_HDF5 routine!";
-                   printer_error().raise(LOCAL_INFO, errmsg.str());
+                   raise_combine_error(LOCAL_INFO, errmsg.str());
                 }
 
                 hid_t dtype = H5Dget_type(dataset);
@@ -285,7 +336,7 @@ namespace Gambit
                 {
                    std::ostringstream errmsg;
                    errmsg << "Failed to detect type for dataset provides as argument for Enter_HDF5 routine!";
-                   printer_error().raise(LOCAL_INFO, errmsg.str());
+                   raise_combine_error(LOCAL_INFO, errmsg.str());
                 }
 
                 //H5T_class_t cl = H5Tget_class(dtype);
@@ -294,7 +345,7 @@ namespace Gambit
                 {
                    std::ostringstream errmsg;
                    errmsg << "Failed to detect native type for dataset provides as argument for Enter_HDF5 routine!";
-                   printer_error().raise(LOCAL_INFO, errmsg.str());
+                   raise_combine_error(LOCAL_INFO, errmsg.str());
                 }
 
                 if (H5Tequal(type, get_hdf5_data_type<float>::type()))
@@ -353,7 +404,7 @@ namespace Gambit
                 {
                     std::ostringstream errmsg;
                     errmsg << "Could not deduce input hdf5 parameter type.";
-                    printer_error().raise(LOCAL_INFO, errmsg.str());
+                    raise_combine_error(LOCAL_INFO, errmsg.str());
                 }
                 
                 H5Tclose(dtype);
@@ -363,6 +414,8 @@ namespace Gambit
             {
             private:
                 std::string group_name;
+                DataSetLayout layout; // chunking/compression of the combined datasets
+                int n_threads; // number of datasets to copy concurrently
                 std::vector<std::string> param_names, aux_param_names;
                 std::unordered_set<std::string> param_set, aux_param_set; // for easier finding
                 std::vector<hid_t> files;
@@ -371,19 +424,21 @@ namespace Gambit
                 std::vector<unsigned long long> cum_sizes;
                 std::vector<unsigned long long> sizes;
                 unsigned long long size_tot;
-                unsigned long long size_tot_l;
+                unsigned long long old_size; // number of points in the previous combined output (when resuming)
                 std::string root_file_name;
-                unsigned long long pt_min;
                 
             public:
-                hdf5_stuff(const std::string &file_name, const std::string &group_name, int num);
+                hdf5_stuff(const std::string &file_name, const std::string &group_name, int num, const DataSetLayout &layout = DataSetLayout(), int n_threads = 1);
                 ~hdf5_stuff(); // close files on destruction                
                 void Enter_Aux_Paramters(const std::string &file, bool resume = false);
             };
 
-            inline void combine_hdf5_files(const std::string file_output, const std::string &file, const std::string &group, int num, bool resume)
+            /// Combine the temporary files file+"_temp_0" ... file+"_temp_<num-1>" into file_output (merging in
+            /// any existing file_output if 'resume' is set), then delete the temporary files. Datasets are copied
+            /// in blocks of at most COMBINE_BLOCKLENGTH entries, up to n_threads datasets at a time.
+            inline void combine_hdf5_files(const std::string file_output, const std::string &file, const std::string &group, int num, bool resume, const DataSetLayout &layout = DataSetLayout(), int n_threads = 1)
             {
-                hdf5_stuff stuff(file, group, num);
+                hdf5_stuff stuff(file, group, num, layout, n_threads);
                 
                 stuff.Enter_Aux_Paramters(file_output, resume);
             }
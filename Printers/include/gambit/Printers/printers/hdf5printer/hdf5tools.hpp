@@ -73,6 +73,30 @@ namespace Gambit
   namespace Printers
   {
 
+      /// Chunking and filter settings for datasets created by the hdf5 printer system
+      struct DataSetLayout
+      {
+         /// Length (in records) of the chunks in dimension 0 (0 = leave the dataset contiguous, where allowed)
+         std::size_t chunklength;
+         /// gzip compression level, 1-9 (0 = no gzip compression)
+         unsigned int deflate_level;
+         /// Apply szip compression (cannot be combined with gzip)
+         bool szip;
+         /// Apply the byte shuffle filter ahead of compression
+         bool shuffle;
+
+         /// Constructor. Deliberately implicit, so a bare chunk length can be given where a layout is expected.
+         DataSetLayout(std::size_t chunk = 0)
+           : chunklength(chunk)
+           , deflate_level(0)
+           , szip(false)
+           , shuffle(false)
+         {}
+
+         /// Check whether any filters are requested (these require a chunked dataset)
+         bool filtered() const { return deflate_level>0 or szip or shuffle; }
+      };
+
       namespace HDF5
       {
 
@@ -160,6 +184,13 @@ namespace Gambit
          /// Get name of dataset
          std::string getName(hid_t dset_id);
 
+         /// Check that the filters requested by a layout are available (for encoding) in the linked HDF5 library
+         void checkFiltersAvailable(const DataSetLayout& layout);
+
+         /// Create a dataset creation property list implementing a layout, for a dataset of rank 'rank'
+         /// whose chunks have dimensions 'chunkdims' (the caller must close the returned list with H5Pclose)
+         hid_t createDatasetPlist(const DataSetLayout& layout, int rank, const hsize_t* chunkdims, const std::string& dset_name);
+
          /// @}
 
       }
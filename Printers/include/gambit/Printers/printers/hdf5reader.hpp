@@ -42,17 +42,17 @@ namespace Gambit
     template<class T>
     struct BuffPair
     {
-       DataSetInterfaceScalar<T,   CHUNKLENGTH> data;
-       DataSetInterfaceScalar<int, CHUNKLENGTH> isvalid;
-       BuffPair(DataSetInterfaceScalar<T, CHUNKLENGTH>& d,
-                DataSetInterfaceScalar<int, CHUNKLENGTH>& v)
+       DataSetInterfaceScalar<T> data;
+       DataSetInterfaceScalar<int> isvalid;
+       BuffPair(DataSetInterfaceScalar<T>& d,
+                DataSetInterfaceScalar<int>& v)
          : data(d)
          , isvalid(v)
        {}
        // Handy shortcut constructor
        BuffPair(hid_t location_id, const std::string& name)
-         : data   (location_id,name,true,'r')
-         , isvalid(location_id,name+"_isvalid",true,'r')
+         : data   (location_id,name,true,'r',CHUNKLENGTH)
+         , isvalid(location_id,name+"_isvalid",true,'r',CHUNKLENGTH)
        {}
        // Default constructor, data uninitialised!
        BuffPair() {}
@@ -129,10 +129,10 @@ namespace Gambit
         const std::vector<std::string> all_datasets;
 
         // MPIrank and pointID dataset wrappers
-        DataSetInterfaceScalar<unsigned long, CHUNKLENGTH> pointIDs;
-        DataSetInterfaceScalar<int, CHUNKLENGTH> pointIDs_isvalid;
-        DataSetInterfaceScalar<int, CHUNKLENGTH> mpiranks;
-        DataSetInterfaceScalar<int, CHUNKLENGTH> mpiranks_isvalid;
+        DataSetInterfaceScalar<unsigned long> pointIDs;
+        DataSetInterfaceScalar<int> pointIDs_isvalid;
+        DataSetInterfaceScalar<int> mpiranks;
+        DataSetInterfaceScalar<int> mpiranks_isvalid;
 
         ulong current_dataset_index; // index in input dataset of the current read-head position
         PPIDpair current_point;      // PPID of the point at the current read-head position
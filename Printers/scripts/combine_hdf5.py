@@ -15,8 +15,7 @@ import sys
 
 chunksize = 1000
 
-bufferlength = 100                # Must match setting in hdf5printer.hpp
-max_ppidpairs = 10*bufferlength   #   "  "
+max_ppidpairs = 1000              # Must match MAX_PPIDPAIRS in hdf5printer.hpp
 
 def usage():
    print "  Usage: python combine_hdf5.py <path-to-target-hdf5-file> <root group in hdf5 files> <tmp file 1> <tmp file 2> ..."
@@ -8,8 +8,7 @@ import sys
 
 # Buffer variables
 chunksize = 1000
-bufferlength = 100                # Must match setting in hdf5printer.hpp
-max_ppidpairs = 10*bufferlength   #   "  "
+max_ppidpairs = 1000              # Must match MAX_PPIDPAIRS in hdf5printer.hpp
 
 def get_dset_lengths(d,group,dsets):
    for itemname in group: 
@@ -0,0 +1,153 @@
+//   GAMBIT: Global and Modular BSM Inference Tool
+//   *********************************************
+///  \file
+///
+///  Definitions of the background writer used by
+///  the HDF5Printer to move dataset writes off the
+///  likelihood call path.
+///
+///  *********************************************
+///
+///  Authors (add name and date if you modify):
+///
+///  \author agent
+///          (agent@local)
+///  \date 2026 Oct
+///
+///  *********************************************
+
+#include "gambit/Printers/printers/hdf5printer/hdf5_async_writer.hpp"
+#include "gambit/Utils/standalone_error_handlers.hpp"
+#include "gambit/Utils/local_info.hpp"
+
+// HDF5 C bindings
+#include <hdf5.h>
+
+namespace Gambit {
+
+  namespace Printers {
+
+      namespace
+      {
+        /// Set on the writer threads
+        thread_local bool on_writer_thread = false;
+
+        /// Error thrown by raise_printer_error on a writer thread
+        struct JobError
+        {
+          std::string origin;
+          std::string message;
+        };
+      }
+
+      void raise_printer_error(const std::string& origin, const std::string& message)
+      {
+        if(on_writer_thread) throw JobError{origin, message};
+        printer_error().raise(origin, message);
+      }
+
+      HDF5AsyncWriter::HDF5AsyncWriter()
+        : busy(false)
+        , submitted(0)
+        , finished(0)
+        , stop(false)
+        , failed(false)
+        , error_origin()
+        , error_message()
+        , thread(&HDF5AsyncWriter::run, this)
+      {}
+
+      HDF5AsyncWriter::~HDF5AsyncWriter()
+      {
+        {
+          std::lock_guard<std::mutex> lock(mtx);
+          stop = true;
+        }
+        job_ready.notify_one();
+        thread.join();
+      }
+
+      HDF5AsyncWriter::Ticket HDF5AsyncWriter::submit(const Job& job)
+      {
+        Ticket ticket;
+        {
+          std::lock_guard<std::mutex> lock(mtx);
+          rethrow_error();
+          jobs.push_back(job);
+          ticket = ++submitted;
+        }
+        job_ready.notify_one();
+        return ticket;
+      }
+
+      void HDF5AsyncWriter::wait()
+      {
+        std::unique_lock<std::mutex> lock(mtx);
+        all_done.wait(lock, [this]{ return jobs.empty() and not busy; });
+        rethrow_error();
+      }
+
+      void HDF5AsyncWriter::wait_for(Ticket ticket)
+      {
+        std::unique_lock<std::mutex> lock(mtx);
+        all_done.wait(lock, [this, ticket]{ return finished >= ticket; });
+        rethrow_error();
+      }
+
+      bool HDF5AsyncWriter::is_usable()
+      {
+        hbool_t threadsafe = 0;
+        return H5is_library_threadsafe(&threadsafe) >= 0 and threadsafe;
+      }
+
+      void HDF5AsyncWriter::rethrow_error()
+      {
+        if(failed)
+        {
+          failed = false;
+          printer_error().raise(error_origin, "Error in background HDF5 write: "+error_message);
+        }
+      }
+
+      void HDF5AsyncWriter::run()
+      {
+        on_writer_thread = true;
+        std::unique_lock<std::mutex> lock(mtx);
+        while(true)
+        {
+          job_ready.wait(lock, [this]{ return stop or not jobs.empty(); });
+          if(jobs.empty()) break; // stop requested and nothing left to write
+
+          Job job = jobs.front();
+          jobs.pop_front();
+          busy = true;
+          lock.unlock();
+
+          bool job_failed = true;
+          std::string origin = LOCAL_INFO, message;
+          try { job(); job_failed = false; }
+          catch(const JobError& e) { origin = e.origin; message = e.message; }
+          catch(const std::exception& e) { message = e.what(); }
+          catch(...) { message = "unknown exception"; }
+
+          lock.lock();
+          busy = false;
+          finished++;
+          if(job_failed)
+          {
+            // Later jobs may depend on the failed one, so drop them
+            if(not failed)
+            {
+              failed = true;
+              error_origin = origin;
+              error_message = message;
+            }
+            finished += jobs.size();
+            jobs.clear();
+          }
+          all_done.notify_all();
+        }
+      }
+
+  }
+}
@@ -28,6 +28,9 @@
 #include "gambit/Printers/printers/hdf5printer/hdf5tools.hpp"
 #include "gambit/Printers/printers/hdf5printer/DataSetInterfaceScalar.hpp"
 #include "gambit/Utils/util_functions.hpp"
+
+#include <functional>
+#include <exception>
   
 namespace Gambit 
 {
@@ -36,6 +39,25 @@ namespace Gambit
         namespace HDF5 
         { 
 
+            namespace
+            {
+                /// Set while this thread is running a job for run_concurrently
+                thread_local bool in_combine_job = false;
+
+                /// Error thrown by raise_combine_error in a job
+                struct CombineJobError
+                {
+                    std::string origin;
+                    std::string message;
+                };
+            }
+
+            void raise_combine_error(const std::string& origin, const std::string& message)
+            {
+                if(in_combine_job) throw CombineJobError{origin, message};
+                printer_error().raise(origin, message);
+            }
+
             inline hsize_t getGroupNum(hid_t group_id)
             {
                 H5G_info_t group_info;
@@ -131,10 +153,17 @@ namespace Gambit
                 return return_val;
             }
             
-            inline void setup_hdf5_points(hid_t new_group, hid_t type, hid_t type2, unsigned long long size_tot, hid_t &dataset_out, hid_t &dataset2_out, hid_t &dataspace, hid_t &dataspace2, const std::string &name)
+            inline void setup_hdf5_points(hid_t new_group, hid_t type, hid_t type2, unsigned long long size_tot, hid_t &dataset_out, hid_t &dataset2_out, hid_t &dataspace, hid_t &dataspace2, const std::string &name, const DataSetLayout &layout)
             {
                 hsize_t dimsf[1];
                 dimsf[0] = size_tot;
+
+                // Chunks cannot be larger than these fixed-size datasets, and empty datasets are left contiguous
+                DataSetLayout out_layout(layout);
+                out_layout.chunklength = std::min<unsigned long long>(out_layout.chunklength, size_tot);
+                hsize_t chunkdims[1];
+                chunkdims[0] = out_layout.chunklength;
+                hid_t cparms_id = HDF5::createDatasetPlist(out_layout, 1, chunkdims, name);
                 dataspace = H5Screate_simple(1, dimsf, NULL); 
                 if(dataspace < 0)
                 {
@@ -142,7 +171,7 @@ namespace Gambit
                   errmsg<<"Failed to set up HDF5 points for copying. H5Screate_simple failed for dataset ("<<name<<")."; 
                   printer_error().raise(LOCAL_INFO, errmsg.str());
                 }
-                dataset_out = H5Dcreate2(new_group, name.c_str(), type, dataspace, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+                dataset_out = H5Dcreate2(new_group, name.c_str(), type, dataspace, H5P_DEFAULT, cparms_id, H5P_DEFAULT);
                 if(dataset_out < 0)
                 {
                   std::ostringstream errmsg;
@@ -156,13 +185,14 @@ namespace Gambit
                   errmsg<<"Failed to set up HDF5 points for copying. H5Screate_simple failed for dataset ("<<name<<"_isvalid).";
                   printer_error().raise(LOCAL_INFO, errmsg.str());
                 }
-                dataset2_out = H5Dcreate2(new_group, (name + "_isvalid").c_str(), type2, dataspace2, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+                dataset2_out = H5Dcreate2(new_group, (name + "_isvalid").c_str(), type2, dataspace2, H5P_DEFAULT, cparms_id, H5P_DEFAULT);
                 if(dataset2_out < 0)
                 {
                   std::ostringstream errmsg;
                   errmsg<<"Failed to set up HDF5 points for copying. H5Dcreate2 failed for dataset ("<<name<<"_isvalid).";
                   printer_error().raise(LOCAL_INFO, errmsg.str());
                 }
+                H5Pclose(cparms_id);
        
                 // Update: We are just going to close the newly created datasets, and reopen them as needed. 
                 // Could therefore get rid of dataset_out arguments, but won't bother right now.
@@ -170,6 +200,115 @@ namespace Gambit
                 HDF5::closeDataset(dataset2_out);
             }
                 
+            /// Select 'length' entries of a 1D dataset starting at 'offset'; returns the (memory, file) dataspaces
+            inline std::pair<hid_t,hid_t> select_block(hid_t dataset, hsize_t offset, hsize_t length)
+            {
+                hid_t dspace_id = H5Dget_space(dataset);
+                hsize_t offsets[1] = {offset};
+                hsize_t lengths[1] = {length};
+                if(dspace_id<0 or H5Sselect_hyperslab(dspace_id, H5S_SELECT_SET, offsets, NULL, lengths, NULL)<0)
+                {
+                  std::ostringstream errmsg;
+                  errmsg<<"Failed to select block (offset="<<offset<<", length="<<length<<") of dataset "<<getName(dataset)<<" while combining HDF5 output.";
+                  raise_combine_error(LOCAL_INFO, errmsg.str());
+                }
+                hid_t memspace_id = H5Screate_simple(1, lengths, NULL);
+                return std::make_pair(memspace_id, dspace_id);
+            }
+
+            /// Read 'length' entries of a 1D dataset, starting at 'offset', into 'buffer'
+            void read_block(hid_t dataset, hid_t memtype, hsize_t offset, hsize_t length, void* buffer)
+            {
+                std::pair<hid_t,hid_t> spaces = select_block(dataset, offset, length);
+                if(H5Dread(dataset, memtype, spaces.first, spaces.second, H5P_DEFAULT, buffer)<0)
+                {
+                  std::ostringstream errmsg;
+                  errmsg<<"Failed to read block (offset="<<offset<<", length="<<length<<") of dataset "<<getName(dataset)<<" while combining HDF5 output. H5Dread failed.";
+                  raise_combine_error(LOCAL_INFO, errmsg.str());
+                }
+                H5Sclose(spaces.first);
+                H5Sclose(spaces.second);
+            }
+
+            /// Write 'length' entries from 'buffer' into a 1D dataset, starting at 'offset'
+            void write_block(hid_t dataset, hid_t memtype, hsize_t offset, hsize_t length, const void* buffer)
+            {
+                std::pair<hid_t,hid_t> spaces = select_block(dataset, offset, length);
+                if(H5Dwrite(dataset, memtype, spaces.first, spaces.second, H5P_DEFAULT, buffer)<0)
+                {
+                  std::ostringstream errmsg;
+                  errmsg<<"Failed to write block (offset="<<offset<<", length="<<length<<") of dataset "<<getName(dataset)<<" while combining HDF5 output. H5Dwrite failed.";
+                  raise_combine_error(LOCAL_INFO, errmsg.str());
+                }
+                H5Sclose(spaces.first);
+                H5Sclose(spaces.second);
+            }
+
+            /// Write entries from 'buffer' to the listed positions of a 1D dataset
+            void write_points(hid_t dataset, hid_t memtype, const std::vector<hsize_t>& coords, const void* buffer)
+            {
+                hsize_t npoints[1] = {coords.size()};
+                hid_t memspace_id = H5Screate_simple(1, npoints, NULL);
+                hid_t dspace_id = H5Dget_space(dataset);
+                if(memspace_id<0 or dspace_id<0
+                   or H5Sselect_elements(dspace_id, H5S_SELECT_SET, coords.size(), &coords[0])<0
+                   or H5Dwrite(dataset, memtype, memspace_id, dspace_id, H5P_DEFAULT, buffer)<0)
+                {
+                  std::ostringstream errmsg;
+                  errmsg<<"Failed to write "<<coords.size()<<" RA points to dataset "<<getName(dataset)<<" while combining HDF5 output.";
+                  raise_combine_error(LOCAL_INFO, errmsg.str());
+                }
+                H5Sclose(dspace_id);
+                H5Sclose(memspace_id);
+            }
+
+            /// Length of a 1D '_isvalid' dataset once any trailing invalid entries are dropped.
+            /// The flags are read back in blocks from the end, so usually only the last block is read.
+            hsize_t valid_length(hid_t isvalid_dataset)
+            {
+                hid_t space = H5Dget_space(isvalid_dataset);
+                hsize_t size = H5Sget_simple_extent_npoints(space);
+                H5Sclose(space);
+                std::vector<int> block;
+                while (size > 0)
+                {
+                    const hsize_t length = std::min(size, COMBINE_BLOCKLENGTH);
+                    block.resize(length);
+                    read_block(isvalid_dataset, get_hdf5_data_type<int>::type(), size - length, length, &block[0]);
+                    for (hsize_t k = length; k > 0; --k)
+                    {
+                        if (block[k-1]) return size - length + k;
+                    }
+                    size -= length;
+                }
+                return 0;
+            }
+
+            /// Run job(0), ..., job(njobs-1) on up to n_threads OpenMP threads. A printer error raised
+            /// inside the OpenMP region would cause a hard stop, so each job instead reports back the
+            /// error raised by it through raise_combine_error (or any other exception thrown by it).
+            /// Once all the jobs have finished, the first failure is raised from here.
+            inline void run_concurrently(std::size_t njobs, int n_threads, const std::function<void(std::size_t)>& job)
+            {
+                std::vector<char> failed(njobs, 0);
+                std::vector<CombineJobError> errors(njobs);
+                std::vector<std::exception_ptr> other_errors(njobs);
+                #pragma omp parallel for schedule(dynamic) num_threads(n_threads) if(n_threads > 1)
+                for (long k = 0; k < long(njobs); k++)
+                {
+                    in_combine_job = true;
+                    try { job(k); }
+                    catch (CombineJobError& e) { failed[k] = 1; errors[k] = e; }
+                    catch (...) { other_errors[k] = std::current_exception(); }
+                    in_combine_job = false;
+                }
+                for (std::size_t k = 0; k < njobs; k++)
+                {
+                    if (failed[k]) printer_error().raise(errors[k].origin, errors[k].message);
+                    if (other_errors[k]) std::rethrow_exception(other_errors[k]);
+                }
+            }
+
             inline std::vector<std::string> getGroups(std::string groups)
             {
                 std::string::size_type pos = groups.find_first_of("/");
@@ -188,13 +327,27 @@ namespace Gambit
                 return ret;
             }
                 
-            hdf5_stuff::hdf5_stuff(const std::string &file_name, const std::string &group_name, int num) 
+            hdf5_stuff::hdf5_stuff(const std::string &file_name, const std::string &group_name, int num, const DataSetLayout &layout, int n_threads) 
               : group_name(group_name)
+              , layout(layout)
+              , n_threads(std::max(n_threads, 1))
               , cum_sizes(num, 0)
               , sizes(num, 0)
               , size_tot(0)
+              , old_size(0)
               , root_file_name(file_name)
             {
+                // Concurrent copies need an HDF5 library built with thread safety enabled
+                if (this->n_threads > 1)
+                {
+                    hbool_t threadsafe = 0;
+                    if (H5is_library_threadsafe(&threadsafe) < 0 or not threadsafe)
+                    {
+                        std::cout << "Warning: the HDF5 library is not thread-safe, so datasets will be combined one at a time (requested "<<this->n_threads<<" threads)." << std::endl;
+                        this->n_threads = 1;
+                    }
+                }
+
                 //std::vector<bool> temp;
                 //herr_t status;
 
@@ -257,7 +410,7 @@ namespace Gambit
                     {
                         for (auto it = aux_names.begin(), end = aux_names.end(); it != end; ++it)
                         {
-                            if (aux_param_set.find(*it) != aux_param_set.end())
+                            if (aux_param_set.find(*it) == aux_param_set.end())
                             {
                                 // New aux parameter name found; add it to the list to be processed.
                                 aux_param_names.push_back(*it);
@@ -275,10 +428,6 @@ namespace Gambit
                     {
                        // Probably the sync group is empty for this file, just skip it
                        size = 0;
-                       if (i == num - 1) // Do we need this here?
-                       {
-                           size_tot_l = size_tot + size; // Last?
-                       }
                     } 
                     else if(dataset<0 or dataset2<0)
                     {
@@ -295,16 +444,6 @@ namespace Gambit
                        size           = H5Sget_simple_extent_npoints(dataspace); // Use variable declared outside the if block
                        hssize_t size2 = H5Sget_simple_extent_npoints(dataspace2);
                        
-                       std::vector<bool> valids;
-                       Enter_HDF5<read_hdf5>(dataset2, valids);
-                       
-                       if (i == 0)
-                       {
-                           std::vector<unsigned long long> pt_id;
-                           Enter_HDF5<read_hdf5>(dataset2, pt_id);
-                           pt_min = pt_id[0];
-                       }
-                       
                        if (size != size2)
                        {
                            std::ostringstream errmsg;
@@ -312,18 +451,8 @@ namespace Gambit
                            printer_error().raise(LOCAL_INFO, errmsg.str());
                        }
                        
-                       if (i == num - 1)
-                       {
-                           size_tot_l = size_tot + size; // Last?
-                       }
-                       
-                       for (auto it = valids.end()-1; size > 0; --it)
-                       {
-                           if (*it)
-                               break;
-                           else
-                               --size;
-                       }
+                       // Drop trailing invalid entries (reading the flags back in blocks from the end)
+                       size = valid_length(dataset2);
 
                        H5Sclose(dataspace);
                        H5Sclose(dataspace2);
@@ -350,7 +479,7 @@ namespace Gambit
             
             void hdf5_stuff::Enter_Aux_Paramters(const std::string &file, bool resume)
             {
-                std::vector<std::vector<unsigned long long>> ranks, ptids;
+                std::vector<hid_t> ranks, ptids; // RA_MPIrank and RA_pointID datasets of each temp file (-1 if absent)
                 std::vector<unsigned long long> aux_sizes;
                 
                 hid_t old_file, old_group;
@@ -390,6 +519,7 @@ namespace Gambit
                        HDF5::closeSpace(space);
                        HDF5::closeDataset(old_dataset); 
                        size_tot += extra;
+                       old_size = extra;
 
                        // Check for parameters not found in the newer temporary files.
                        // (should not be any aux parameters in here, so don't check for them)
@@ -439,16 +569,14 @@ namespace Gambit
                 
                 if (aux_param_names.size() > 0) for (auto itg = aux_groups.begin(), endg = aux_groups.end(); itg != endg; ++itg)
                 {
-                    std::vector<unsigned long long> rank, ptid;
-
                     HDF5::errorsOff();
                     hid_t dataset  = HDF5::openDataset(*itg, "RA_MPIrank", true);
                     HDF5::errorsOn();
                     if(dataset < 0) // If key dataset doesn't exist, set aux size to zero for this rank
                     {
                        // Need to push back empty entries, because they need to remain synced with the datasets vectors
-                       ranks.push_back(rank);
-                       ptids.push_back(ptid);
+                       ranks.push_back(-1);
+                       ptids.push_back(-1);
                        aux_sizes.push_back(0);
                     }
                     else
@@ -456,27 +584,24 @@ namespace Gambit
                        hid_t dataset2 = HDF5::openDataset(*itg, "RA_pointID");
                        hid_t dataset3 = HDF5::openDataset(*itg, "RA_pointID_isvalid");
 
-                       Enter_HDF5<read_hdf5>(dataset, rank);
-                       Enter_HDF5<read_hdf5>(dataset2, ptid);
-                       // Check that extracted rank/ptid vectors are the same length
-                       if(rank.size() != ptid.size())
-                       {
-                           std::ostringstream errmsg;
-                           errmsg << "Extracted RA_MPIrank and RA_pointID are not the same size! ("<<ranks.size()<<"!="<<ptid.size()<<")";
-                           printer_error().raise(LOCAL_INFO, errmsg.str());
-                       }
-
-                       ranks.push_back(rank);
-                       ptids.push_back(ptid);
+                       // The rank/ptid datasets are kept open, and read in blocks when they are needed
+                       ranks.push_back(dataset);
+                       ptids.push_back(dataset2);
 
+                       hid_t dataspace0 = H5Dget_space(dataset);
                        hid_t dataspace = H5Dget_space(dataset2);
                        hid_t dataspace2 = H5Dget_space(dataset3);
+                       hssize_t size0 = H5Sget_simple_extent_npoints(dataspace0);
                        hssize_t size = H5Sget_simple_extent_npoints(dataspace);
                        hssize_t size2 = H5Sget_simple_extent_npoints(dataspace2);
-                       
-                       
-                       std::vector<bool> valids;
-                       Enter_HDF5<read_hdf5>(dataset3, valids);
+
+                       // Check that the rank/ptid datasets are the same length
+                       if (size0 != size)
+                       {
+                           std::ostringstream errmsg;
+                           errmsg << "RA_MPIrank and RA_pointID are not the same size! ("<<size0<<"!="<<size<<")";
+                           printer_error().raise(LOCAL_INFO, errmsg.str());
+                       }
                        
                        if (size != size2)
                        {
@@ -485,27 +610,33 @@ namespace Gambit
                            printer_error().raise(LOCAL_INFO, errmsg.str());
                        }
                        
-                       for (auto it = valids.end()-1; size > 0; --it)
-                       {
-                           if (*it)
-                               break;
-                           else
-                               --size;
-                       }
-                       aux_sizes.push_back(size);
+                       aux_sizes.push_back(valid_length(dataset3));
                        
+                       H5Sclose(dataspace0);
                        H5Sclose(dataspace);
-                       HDF5::closeDataset(dataset);
-                       HDF5::closeDataset(dataset2);
+                       H5Sclose(dataspace2);
                        HDF5::closeDataset(dataset3);
                     }
                 }
   
-                int counter = 1;
-                for (auto it = param_names.begin(), end = param_names.end(); it != end; ++it, ++counter)
+                // Parameters are combined in batches of n_threads. The datasets for a batch are opened
+                // and created serially (HDF5 error reporting is switched off and on globally while doing
+                // so), and the batch is then copied concurrently, one parameter per thread.
+                struct copy_job
+                {
+                    std::vector<hid_t> datasets, datasets2;
+                    hid_t old_dataset, old_dataset2, dataset_out, dataset2_out;
+                    bool fresh; // output dataset was newly created for RA points only
+                };
+
+                for (std::size_t batch = 0; batch < param_names.size(); batch += n_threads)
                 {
+                  const std::size_t batch_end = std::min(param_names.size(), batch + n_threads);
+                  std::vector<copy_job> jobs;
+                  for (auto it = param_names.begin() + batch, end = param_names.begin() + batch_end; it != end; ++it)
+                  {
                     // Simple Progress monitor
-                    std::cout << " Combining primary datasets... "<<int(100*counter/param_names.size())<<"%         \r";
+                    std::cout << " Combining primary datasets... "<<int(100*(it-param_names.begin()+1)/param_names.size())<<"%         \r";
 
                     std::vector<hid_t> datasets, datasets2;
                     int valid_dset  = -1; // index of a validly opened dataset (-1 if none)
@@ -570,26 +701,42 @@ namespace Gambit
                     }
                     
                     // Create datasets
-                    setup_hdf5_points(new_group, type, type2, size_tot, dataset_out, dataset2_out, dataspace, dataspace2, *it);
-                    //std::cout<<"(theoretically) created dataset '"<<*it<<"' in file:group "<<file<<":"<<group_name<<std::endl;
+                    setup_hdf5_points(new_group, type, type2, size_tot, dataset_out, dataset2_out, dataspace, dataspace2, *it, layout);
+                    H5Sclose(dataspace);
+                    H5Sclose(dataspace2);
+                    H5Tclose(type);
+                    H5Tclose(type2);
  
                     // Reopen dataset for writing
-                    dataset_out   = HDF5::openDataset(new_group, *it);
-                    dataset2_out  = HDF5::openDataset(new_group, (*it)+"_isvalid");
-                    std::cout << "Copying parameter "<<*it<<std::endl; // debug
-                    Enter_HDF5<copy_hdf5>(dataset_out, datasets, size_tot_l, sizes, old_dataset);
-                    Enter_HDF5<copy_hdf5>(dataset2_out, datasets2, size_tot_l, sizes, old_dataset2);
+                    copy_job job;
+                    job.datasets      = datasets;
+                    job.datasets2     = datasets2;
+                    job.old_dataset   = old_dataset;
+                    job.old_dataset2  = old_dataset2;
+                    job.dataset_out   = HDF5::openDataset(new_group, *it);
+                    job.dataset2_out  = HDF5::openDataset(new_group, (*it)+"_isvalid");
+                    job.fresh         = false;
+                    jobs.push_back(job);
+                  }
+
+                  run_concurrently(jobs.size(), n_threads, [&](std::size_t k)
+                  {
+                    Enter_HDF5<copy_hdf5>(jobs[k].dataset_out, jobs[k].datasets, old_size, sizes, jobs[k].old_dataset);
+                    Enter_HDF5<copy_hdf5>(jobs[k].dataset2_out, jobs[k].datasets2, old_size, sizes, jobs[k].old_dataset2);
+                  });
                     
-                    for (int i = 0, end = datasets.size(); i < end; i++)
+                  for (auto job = jobs.begin(); job != jobs.end(); ++job)
+                  {
+                    for (int i = 0, end = job->datasets.size(); i < end; i++)
                     {
-                        if(datasets[i]>=0)  HDF5::closeDataset(datasets[i]);
-                        if(datasets2[i]>=0) HDF5::closeDataset(datasets2[i]);
+                        if(job->datasets[i]>=0)  HDF5::closeDataset(job->datasets[i]);
+                        if(job->datasets2[i]>=0) HDF5::closeDataset(job->datasets2[i]);
                     }
-
-                    H5Sclose(dataspace);
-                    H5Sclose(dataspace2);
-                    HDF5::closeDataset(dataset_out);
-                    HDF5::closeDataset(dataset2_out);
+                    if(job->old_dataset>=0)  HDF5::closeDataset(job->old_dataset);
+                    if(job->old_dataset2>=0) HDF5::closeDataset(job->old_dataset2);
+                    HDF5::closeDataset(job->dataset_out);
+                    HDF5::closeDataset(job->dataset2_out);
+                  }
                 }
                 std::cout << " Combining primary datasets... Done.                 "<<std::endl;
 
@@ -597,20 +744,32 @@ namespace Gambit
                 // and their targets in the output dataset. That means we need to read through
                 // the output dataset and read in all the pointID/MPI pairs.
                 // We only need to do this once and create a big hash table to use while copying.
-                // It would be better to do all the copying in chunks, and then we would also
-                // only need chunks of this hash table at a time, but Greg didn't write this
-                // code with chunked writing in mind. TODO: Should modify the code to do this.
+                // The hash table only holds the RA targets, and the output datasets are scanned
+                // (and the RA points later copied) in blocks, so memory use does not grow with
+                // the total number of points.
 
                 // We already know all the RA rank/ptID pairs, so just need to scan the output
                 // datasets for the matching pairs, and record their indices.
 
-                // Start with a list of ID pairs to be matched
+                // Start with a list of ID pairs to be matched (only the entries that can be copied are needed)
                 std::unordered_set<PPIDpair,PPIDHash,PPIDEqual> left_to_match;
-                for(std::size_t i=0; i<ranks.size(); ++i)
                 {
-                   for(std::size_t j=0; j<ranks[i].size(); ++j)
+                   const hid_t idtype = get_hdf5_data_type<unsigned long long>::type();
+                   std::vector<unsigned long long> rank_block, ptid_block;
+                   for(std::size_t i=0; i<ranks.size(); ++i)
                    {
-                      left_to_match.insert(PPIDpair(ptids[i][j],ranks[i][j]));
+                      for(unsigned long long offset = 0; offset < aux_sizes[i]; offset += COMBINE_BLOCKLENGTH)
+                      {
+                         const hsize_t length = std::min<unsigned long long>(COMBINE_BLOCKLENGTH, aux_sizes[i] - offset);
+                         rank_block.resize(length);
+                         ptid_block.resize(length);
+                         read_block(ranks[i], idtype, offset, length, &rank_block[0]);
+                         read_block(ptids[i], idtype, offset, length, &ptid_block[0]);
+                         for(hsize_t j=0; j<length; ++j)
+                         {
+                            left_to_match.insert(PPIDpair(ptid_block[j],rank_block[j]));
+                         }
+                      }
                    }
                 }
 
@@ -618,10 +777,14 @@ namespace Gambit
                 {
                    std::unordered_map<PPIDpair, unsigned long long, PPIDHash,PPIDEqual> RA_write_hash(get_RA_write_hash(new_group, left_to_match));
  
-                   /// Now copy the RA datasets
-                   for (auto it = aux_param_names.begin(), end = aux_param_names.end(); it != end; ++it)
+                   /// Now copy the RA datasets (batched as for the primary datasets)
+                   for (std::size_t batch = 0; batch < aux_param_names.size(); batch += n_threads)
                    {
-                       std::cout << " Combining auxilliary datasets... "<<int(100*counter/aux_param_names.size())<<"%         \r";
+                     const std::size_t batch_end = std::min(aux_param_names.size(), batch + n_threads);
+                     std::vector<copy_job> jobs;
+                     for (auto it = aux_param_names.begin() + batch, end = aux_param_names.begin() + batch_end; it != end; ++it)
+                     {
+                       std::cout << " Combining auxilliary datasets... "<<int(100*(it-aux_param_names.begin()+1)/aux_param_names.size())<<"%         \r";
                        std::vector<hid_t> datasets, datasets2;
                        int valid_dset  = -1; // index of a validly opened dataset (-1 if none)
                       
@@ -647,25 +810,16 @@ namespace Gambit
                            datasets2.push_back(dataset2);
                        }
                        
-                       hid_t old_dataset = -1, old_dataset2 = -1;
-                       // Actually, I think there is now no need to copy the old data here. It should
-                       // already be copied as part of the primary dataset copying.
-                       // if (resume)
-                       // {
-                       //     // Dataset may not exist, and thus fail to open. We will check its status
-                       //     // later on and ignore it where needed.
-                       //     HDF5::errorsOff();
-                       //     old_dataset  = HDF5::openDataset(old_group, *it, true);
-                       //     old_dataset2 = HDF5::openDataset(old_group, *it + "_isvalid", true);
-                       //     HDF5::errorsOn();
-                       // }
-
-                       hid_t dataset_out, dataset2_out, dataspace, dataspace2;
+                       // There is no need to copy the old data here. It has already been copied
+                       // as part of the primary dataset copying.
+
+                       copy_job job;
+                       job.fresh = false;
                        // If the aux parameter was not also copied as a primary parameter then we need to create a new
                        // dataset for it here. Otherwise one should already exist.
                        if(param_set.find(*it) == param_set.end())
                        {
-                          hid_t type, type2;
+                          hid_t type, type2, dataset_out, dataset2_out, dataspace, dataspace2;
                           if(valid_dset<0)
                           {
                              // No valid dset open, but we are supposed to copy something? Error.
@@ -673,32 +827,49 @@ namespace Gambit
                              errmsg << "Error copying RA points for dataset '"<<*it<<"'. No valid datasets could be opened, though they were detected in the temp files. They may be corrupted.";
                              printer_error().raise(LOCAL_INFO, errmsg.str());
                           }
-                          else
-                          { 
-                             // Get the type from a validly opened dataset in temp file
-                             type  = H5Dget_type(datasets[valid_dset]);
-                             type2 = H5Dget_type(datasets2[valid_dset]); 
-                             if(type<0 or type2<0)
-                             {
-                                std::ostringstream errmsg;
-                                errmsg << "Failed to detect type for RA dataset '"<<*it<<"'! The dataset is supposedly valid, so this does not make sense. It must be a bug, please report it.";
-                                printer_error().raise(LOCAL_INFO, errmsg.str());
-                             }
+                          // Get the type from a validly opened dataset in temp file
+                          type  = H5Dget_type(datasets[valid_dset]);
+                          type2 = H5Dget_type(datasets2[valid_dset]); 
+                          if(type<0 or type2<0)
+                          {
+                             std::ostringstream errmsg;
+                             errmsg << "Failed to detect type for RA dataset '"<<*it<<"'! The dataset is supposedly valid, so this does not make sense. It must be a bug, please report it.";
+                             printer_error().raise(LOCAL_INFO, errmsg.str());
                           }
                           // Create new dataset
-                          setup_hdf5_points(new_group, type, type2, size_tot, dataset_out, dataset2_out, dataspace, dataspace2, *it); 
+                          setup_hdf5_points(new_group, type, type2, size_tot, dataset_out, dataset2_out, dataspace, dataspace2, *it, layout); 
+                          H5Sclose(dataspace);
+                          H5Sclose(dataspace2);
+                          H5Tclose(type);
+                          H5Tclose(type2);
+                          job.fresh = true;
                        }
                        // Reopen output datasets for copying
-                       dataset_out  = HDF5::openDataset(new_group, *it);
-                       dataset2_out = HDF5::openDataset(new_group, (*it)+"_isvalid");
-                       Enter_HDF5<ra_copy_hdf5>(dataset_out, dataset2_out, datasets, datasets2, size_tot, RA_write_hash, ptids, ranks, aux_sizes, old_dataset, old_dataset2);
+                       job.datasets     = datasets;
+                       job.datasets2    = datasets2;
+                       job.old_dataset  = -1;
+                       job.old_dataset2 = -1;
+                       job.dataset_out  = HDF5::openDataset(new_group, *it);
+                       job.dataset2_out = HDF5::openDataset(new_group, (*it)+"_isvalid");
+                       jobs.push_back(job);
+                     }
+
+                     run_concurrently(jobs.size(), n_threads, [&](std::size_t k)
+                     {
+                       Enter_HDF5<ra_copy_hdf5>(jobs[k].dataset_out, jobs[k].dataset2_out, jobs[k].datasets, jobs[k].datasets2, size_tot, RA_write_hash, ptids, ranks, aux_sizes, jobs[k].fresh);
+                     });
                       
-                       for (int i = 0, end = datasets.size(); i < end; i++)
+                     for (auto job = jobs.begin(); job != jobs.end(); ++job)
+                     {
+                       for (int i = 0, end = job->datasets.size(); i < end; i++)
                        {
                            // Some datasets may never have been opened, so check this before trying to close them.
-                           if(datasets[i]>=0)  HDF5::closeDataset(datasets[i]);
-                           if(datasets2[i]>=0) HDF5::closeDataset(datasets2[i]);
+                           if(job->datasets[i]>=0)  HDF5::closeDataset(job->datasets[i]);
+                           if(job->datasets2[i]>=0) HDF5::closeDataset(job->datasets2[i]);
                        }
+                       HDF5::closeDataset(job->dataset_out);
+                       HDF5::closeDataset(job->dataset2_out);
+                     }
                    }
                    std::cout << " Combining auxilliary datasets... Done.                 "<<std::endl;
                 }
@@ -707,6 +878,12 @@ namespace Gambit
                    std::cout << " Combining auxilliary datasets... None found, skipping. "<<std::endl;
                 }
 
+                for(std::size_t i=0; i<ranks.size(); ++i)
+                {
+                   if(ranks[i]>=0) HDF5::closeDataset(ranks[i]);
+                   if(ptids[i]>=0) HDF5::closeDataset(ptids[i]);
+                }
+
                 H5Fflush(new_file, H5F_SCOPE_GLOBAL);
                 HDF5::closeGroup(new_group);
                 HDF5::closeFile(new_file);
@@ -731,16 +908,16 @@ namespace Gambit
                std::unordered_map<PPIDpair, unsigned long long, PPIDHash,PPIDEqual> output_hash;
 
                // Chunking variables
-               static const std::size_t CHUNKLENGTH = 1000; // Should be a reasonable value
+               static const std::size_t CHUNKLENGTH = COMBINE_BLOCKLENGTH;
                
                // Interfaces for the datasets
                // Make sure the types used here don't get out of sync with the types used to write the original datasets
                // We open the datasets in "resume" mode to access existing dataset, and make "const" to disable writing of new data. i.e. "Read-only" mode.
                // TODO: this can probably be streamlined once I write the HDF5 reader, can consolidate some reading routines.
-               const DataSetInterfaceScalar<unsigned long, CHUNKLENGTH> pointIDs(group_id, "pointID", true,'r');        
-               const DataSetInterfaceScalar<int, CHUNKLENGTH> pointIDs_isvalid  (group_id, "pointID_isvalid", true,'r');
-               const DataSetInterfaceScalar<int, CHUNKLENGTH> mpiranks          (group_id, "MPIrank", true,'r'); 
-               const DataSetInterfaceScalar<int, CHUNKLENGTH> mpiranks_isvalid  (group_id, "MPIrank_isvalid", true,'r'); 
+               const DataSetInterfaceScalar<unsigned long> pointIDs(group_id, "pointID", true, 'r', CHUNKLENGTH);        
+               const DataSetInterfaceScalar<int> pointIDs_isvalid  (group_id, "pointID_isvalid", true, 'r', CHUNKLENGTH);
+               const DataSetInterfaceScalar<int> mpiranks          (group_id, "MPIrank", true, 'r', CHUNKLENGTH); 
+               const DataSetInterfaceScalar<int> mpiranks_isvalid  (group_id, "MPIrank_isvalid", true, 'r', CHUNKLENGTH); 
 
                // Error check lengths. This should already have been done for all datasets in the group, but
                // we will double-check these four here.
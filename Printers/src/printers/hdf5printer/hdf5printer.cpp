@@ -361,10 +361,10 @@ namespace Gambit
        // Interfaces for the datasets
        // Make sure the types used here don't get out of sync with the types used to write the original datasets
        // We open the datasets in "resume" mode to access existing dataset, and make "const" to disable writing of new data. i.e. "Read-only" mode.
-       const DataSetInterfaceScalar<unsigned long, CHUNKLENGTH> pointIDs(group_id, "pointID", true, 'r');
-       const DataSetInterfaceScalar<int, CHUNKLENGTH> pointIDs_isvalid  (group_id, "pointID_isvalid", true, 'r');
-       const DataSetInterfaceScalar<int, CHUNKLENGTH> mpiranks          (group_id, "MPIrank", true, 'r');
-       const DataSetInterfaceScalar<int, CHUNKLENGTH> mpiranks_isvalid  (group_id, "MPIrank_isvalid", true, 'r');
+       const DataSetInterfaceScalar<unsigned long> pointIDs(group_id, "pointID", true, 'r', CHUNKLENGTH);
+       const DataSetInterfaceScalar<int> pointIDs_isvalid  (group_id, "pointID_isvalid", true, 'r', CHUNKLENGTH);
+       const DataSetInterfaceScalar<int> mpiranks          (group_id, "MPIrank", true, 'r', CHUNKLENGTH);
+       const DataSetInterfaceScalar<int> mpiranks_isvalid  (group_id, "MPIrank_isvalid", true, 'r', CHUNKLENGTH);
 
        // Error check lengths. This should already have been done for all datasets in the group, but
        // we will double-check these four here.
@@ -531,6 +531,95 @@ namespace Gambit
         ss << "Primary printer for rank " << myRank;
         printer_name = ss.str();
 
+        // Length of the output buffers. Either fixed by the user, or chosen in
+        // 'initialise' from a memory budget once the number of outputs is known.
+        if(options.hasKey("buffer_length"))
+        {
+          const long length = options.getValue<long>("buffer_length");
+          if(length<=0)
+          {
+            std::ostringstream errmsg;
+            errmsg << "Error! Invalid 'buffer_length' ("<<length<<") supplied to the hdf5 printer! The buffer length must be a positive integer.";
+            printer_error().raise(LOCAL_INFO, errmsg.str());
+          }
+          bufferlength = length;
+        }
+        else
+        {
+          buffer_memory_MB = options.getValueOrDef<double>(0,"buffer_memory_MB");
+          if(buffer_memory_MB<0)
+          {
+            std::ostringstream errmsg;
+            errmsg << "Error! Invalid 'buffer_memory_MB' ("<<buffer_memory_MB<<") supplied to the hdf5 printer! The memory budget must be positive.";
+            printer_error().raise(LOCAL_INFO, errmsg.str());
+          }
+        }
+
+        // Chunking and compression of the output datasets. By default each buffer
+        // flush writes exactly one chunk. A smaller 'chunk_length' must divide the
+        // buffer length, so that flushes still only ever write whole chunks.
+        if(options.hasKey("chunk_length"))
+        {
+          const long chunk = options.getValue<long>("chunk_length");
+          if(chunk<=0)
+          {
+            std::ostringstream errmsg;
+            errmsg << "Error! Invalid 'chunk_length' ("<<chunk<<") supplied to the hdf5 printer! The chunk length must be a positive integer.";
+            printer_error().raise(LOCAL_INFO, errmsg.str());
+          }
+          dataset_layout.chunklength = chunk;
+          // With a memory budget the check is done once the buffer length has been chosen
+          if(buffer_memory_MB==0) check_chunklength();
+        }
+        const std::string compression = options.getValueOrDef<std::string>("none","compression");
+        if(compression=="gzip")
+        {
+          const long level = options.getValueOrDef<long>(DEFAULT_GZIP_LEVEL,"compression_level");
+          if(level<1 or level>9)
+          {
+            std::ostringstream errmsg;
+            errmsg << "Error! Invalid 'compression_level' ("<<level<<") supplied to the hdf5 printer! gzip compression levels run from 1 (fastest) to 9 (smallest output).";
+            printer_error().raise(LOCAL_INFO, errmsg.str());
+          }
+          dataset_layout.deflate_level = level;
+        }
+        else if(compression=="szip")
+        {
+          dataset_layout.szip = true;
+        }
+        else if(compression!="none")
+        {
+          std::ostringstream errmsg;
+          errmsg << "Error! Invalid 'compression' ("<<compression<<") supplied to the hdf5 printer! Valid options are 'none', 'gzip' and 'szip'.";
+          printer_error().raise(LOCAL_INFO, errmsg.str());
+        }
+        dataset_layout.shuffle = options.getValueOrDef<bool>(false,"shuffle");
+        HDF5::checkFiltersAvailable(dataset_layout);
+
+        // Number of datasets to copy at once when combining the temporary files
+        // (only takes effect if the HDF5 library was built thread-safe)
+        combine_threads = options.getValueOrDef<int>(1,"combine_threads");
+        if(combine_threads<1)
+        {
+          std::ostringstream errmsg;
+          errmsg << "Error! Invalid 'combine_threads' ("<<combine_threads<<") supplied to the hdf5 printer! At least one thread is required.";
+          printer_error().raise(LOCAL_INFO, errmsg.str());
+        }
+
+        // Write the buffers to disk from a background thread, so that the scan does not
+        // have to wait for HDF5 (only possible if the HDF5 library was built thread-safe)
+        if(options.getValueOrDef<bool>(false,"async_write"))
+        {
+          if(HDF5AsyncWriter::is_usable())
+          {
+            async_writer.reset(new HDF5AsyncWriter());
+          }
+          else
+          {
+            logger() << LogTags::printers << LogTags::warn << "HDF5Printer: 'async_write' requested, but the HDF5 library is not thread-safe. Buffers will be written to disk synchronously." << EOM;
+          }
+        }
+
         // Name of file where results should ultimately end up
         std::ostringstream ff;
         if(options.hasKey("output_path"))
@@ -957,9 +1046,57 @@ namespace Gambit
 
     /// Initialisation function
     // Run by dependency resolver, which supplies the functors with a vector of VertexIDs whose requiresPrinting flags are set to true.
-    void HDF5Printer::initialise(const std::vector<int>& /*printmevec*/)
+    void HDF5Printer::initialise(const std::vector<int>& printmevec)
     {
-      // Nothing to be done
+      // Size the buffers from the memory budget, if one was given. Each functor
+      // to be printed gets a buffer, plus the pointID and MPIrank buffers.
+      if(is_primary_printer and buffer_memory_MB>0) choose_bufferlength(printmevec.size()+2);
+    }
+
+    /// Choose the buffer length from the memory budget and the number of output streams
+    /// Functors which print more than one entry (e.g. vectors or model parameters) are
+    /// counted only once, so the budget is approximate; set 'buffer_length' directly if
+    /// that matters.
+    void HDF5Printer::choose_bufferlength(const std::size_t n_streams)
+    {
+      // The length cannot change once any buffer has been created, since all the
+      // synchronised buffers must fill up together.
+      if(not all_buffers.empty())
+      {
+        logger() << LogTags::printers << LogTags::warn << "HDF5Printer: buffers already exist, so the buffer length cannot be chosen from 'buffer_memory_MB'. Keeping buffer length = " << bufferlength << EOM;
+        check_chunklength();
+        return;
+      }
+
+      // Each slot of a synchronised buffer holds one value and one validity flag.
+      const double bytes_per_slot = sizeof(double) + sizeof(bool);
+      const double budget = buffer_memory_MB * 1024. * 1024.;
+      std::size_t length = budget / (bytes_per_slot * std::max<std::size_t>(n_streams,1));
+
+      // Round to a multiple of the chunk length (if one was chosen), so that flushes write whole chunks
+      const std::size_t step = (dataset_layout.chunklength>0) ? dataset_layout.chunklength : MIN_AUTO_BUFFERLENGTH;
+      const std::size_t min_length = step * ((MIN_AUTO_BUFFERLENGTH + step - 1) / step);
+      const std::size_t max_length = std::max(step * (MAX_AUTO_BUFFERLENGTH / step), min_length);
+      length -= length % step;
+      if(length < min_length)
+      {
+        logger() << LogTags::printers << LogTags::warn << "HDF5Printer: 'buffer_memory_MB' (" << buffer_memory_MB << ") is too small for " << n_streams << " output streams; using the minimum buffer length (" << min_length << ") instead." << EOM;
+        length = min_length;
+      }
+      bufferlength = std::min(length, max_length);
+      logger() << LogTags::printers << LogTags::info << "HDF5Printer: chose buffer length " << bufferlength << " for " << n_streams << " output streams and a memory budget of " << buffer_memory_MB << " MB." << EOM;
+      check_chunklength();
+    }
+
+    /// Check that the chosen chunk length (if any) divides the buffer length
+    void HDF5Printer::check_chunklength() const
+    {
+      if(dataset_layout.chunklength>0 and bufferlength % dataset_layout.chunklength != 0)
+      {
+        std::ostringstream errmsg;
+        errmsg << "Error! The 'chunk_length' ("<<dataset_layout.chunklength<<") supplied to the hdf5 printer does not divide the buffer length ("<<bufferlength<<"). Please choose a chunk length that does, so that each buffer flush writes whole chunks.";
+        printer_error().raise(LOCAL_INFO, errmsg.str());
+      }
     }
 
     /// Destructor
@@ -967,6 +1104,13 @@ namespace Gambit
     HDF5Printer::~HDF5Printer()
     {
       DBUG( std::cout << "Destructing HDF5Printer object (with name=\""<<printer_name<<"\")..." << std::endl; )
+      // Any writes still queued (e.g. if finalise() was never reached) refer to buffers
+      // owned by this printer, so let them complete first. Errors can no longer be reported.
+      if(get_async_writer()!=NULL)
+      {
+        try { get_async_writer()->wait(); }
+        catch(...) {}
+      }
     }
 
     /// Perform final cleanup and write tasks
@@ -982,6 +1126,12 @@ namespace Gambit
         synchronise_buffers();
         logger() << LogTags::printers << "Print buffers synchronised; flushing them to disk" << EOM;
         flush();
+        if(async_writer)
+        {
+          // Also covers soft shutdowns, which end up here with abnormal=true
+          logger() << LogTags::printers << "Waiting for background writes to complete" << EOM;
+          async_writer->wait();
+        }
         logger() << LogTags::printers << "Final buffer flush done ("<<printer_name<<")"<<EOM;
 
         // close HDF5 datasets, groups, and file
@@ -1209,7 +1359,7 @@ namespace Gambit
       // exists, and it will crash if it doesn't. So we need to first check if such a file exists.
       bool combined_file_exists = Utils::file_exists(tmp_comb_file); // We already check this externally; pass in as flag?
       std::cout<<"combined_file_exists? "<<combined_file_exists<<std::endl;
-      HDF5::combine_hdf5_files(tmp_comb_file, finalfile, group, num, combined_file_exists);
+      HDF5::combine_hdf5_files(tmp_comb_file, finalfile, group, num, combined_file_exists, get_dataset_layout(), combine_threads);
 
       // This is just left the same as the combine_output_py version!
       if(finalcombine)
@@ -1291,7 +1441,7 @@ namespace Gambit
     /// In this version of the HDF5Printer, this list applies only to RA points.
     /// Synchronised writes are not tracked.
     /// UPDATE! Due to memory issues with tracking many RA points, we now only track
-    /// the last 10*BUFFERLENGTH points. When the PPID list gets "full" we do a flush,
+    /// the last MAX_PPIDPAIRS points. When the PPID list gets "full" we do a flush,
     /// and then start tracking again, with the new list getting assigned only indices
     /// above the highest in the previous list. This means that the output will
     /// potentially have duplicate RA write commands, so the post-processing should be
@@ -1455,6 +1605,9 @@ namespace Gambit
 #ifdef DEBUG_MODE
             std::cout<<"rank "<<myRank<<": Emptying sync buffer "<<it->second->get_label()<<std::endl;
 #endif
+            // With a background writer, the previous flush must be complete before
+            // this one is handed over, so that at most two buffer-loads are in memory.
+            if(N_were_full==0 and get_async_writer()!=NULL) get_async_writer()->wait();
             N_were_full += 1; // Can get flushed if not full only if force=true
             it->second->flush();
           }
@@ -1470,13 +1623,21 @@ namespace Gambit
       }
 
       // Tell the HDF5 library to flush everything to disk
-      herr_t err = H5Fflush(file_id, H5F_SCOPE_GLOBAL);
-      if(err<0)
+      const hid_t file = file_id;
+      const unsigned int rank = myRank;
+      const std::string name = printer_name;
+      auto flush_file = [file, rank, name]()
       {
-        std::ostringstream errmsg;
-        errmsg << "Error in HDF5Printer while trying to empty all synchronised buffers. Buffers were emptied to the HDF5 backend (seemingly) successfully, however H5Fflush returned an error value ("<<err<<"). That is, an error occurred while the HDF5 system attempted to flush its internally buffered data to disk. (Note: rank="<<myRank<<", printer_name="<<printer_name<<")";
-        printer_error().raise(LOCAL_INFO, errmsg.str());
-      }
+        herr_t err = H5Fflush(file, H5F_SCOPE_GLOBAL);
+        if(err<0)
+        {
+          std::ostringstream errmsg;
+          errmsg << "Error in HDF5Printer while trying to empty all synchronised buffers. Buffers were emptied to the HDF5 backend (seemingly) successfully, however H5Fflush returned an error value ("<<err<<"). That is, an error occurred while the HDF5 system attempted to flush its internally buffered data to disk. (Note: rank="<<rank<<", printer_name="<<name<<")";
+          raise_printer_error(LOCAL_INFO, errmsg.str());
+        }
+      };
+      if(get_async_writer()==NULL) flush_file();
+      else if(N_were_full!=0) get_async_writer()->submit(flush_file); // queued behind the chunks just handed over
     }
 
     /// Empty all the buffers to disk
@@ -63,10 +63,10 @@ namespace Gambit
       , file_id(openfile_read(file))
       , location_id(HDF5::openGroup(file_id, group, true))
       , all_datasets(lsGroup_process(location_id))
-      , pointIDs        (location_id, "pointID", true, 'r')
-      , pointIDs_isvalid(location_id, "pointID_isvalid", true, 'r')
-      , mpiranks        (location_id, "MPIrank", true, 'r')
-      , mpiranks_isvalid(location_id, "MPIrank_isvalid", true, 'r')
+      , pointIDs        (location_id, "pointID", true, 'r', CHUNKLENGTH)
+      , pointIDs_isvalid(location_id, "pointID_isvalid", true, 'r', CHUNKLENGTH)
+      , mpiranks        (location_id, "MPIrank", true, 'r', CHUNKLENGTH)
+      , mpiranks_isvalid(location_id, "MPIrank_isvalid", true, 'r', CHUNKLENGTH)
       , current_dataset_index(0)
       , current_point(nullpoint)
      {
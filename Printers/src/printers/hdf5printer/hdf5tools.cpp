@@ -410,13 +410,90 @@ namespace Gambit {
       /// Get dataset name
       std::string getName(hid_t dset_id)
       {
-          size_t len = H5Iget_name(dset_id,NULL,0);
-          char buffer[len];
-          H5Iget_name(dset_id,buffer,len+1);
-          std::string n = buffer;
+          ssize_t len = H5Iget_name(dset_id,NULL,0);
+          if(len < 0) return "<unknown>";
+          std::vector<char> buffer(len+1); // Room for the null terminator
+          H5Iget_name(dset_id,&buffer[0],len+1);
+          std::string n = &buffer[0];
           return n;
       }
 
+      /// Check that a filter is available and can encode, else raise an error
+      void checkFilterAvailable(H5Z_filter_t filter, const std::string& filter_name)
+      {
+          unsigned int config = 0;
+          if(H5Zfilter_avail(filter) <= 0 or H5Zget_filter_info(filter, &config) < 0 or not (config & H5Z_FILTER_CONFIG_ENCODE_ENABLED))
+          {
+            std::ostringstream errmsg;
+            errmsg << "Error! The "<<filter_name<<" filter was requested for hdf5 output, but it is not available for encoding in the HDF5 library that GAMBIT is linked against. Please choose a different compression option.";
+            printer_error().raise(LOCAL_INFO, errmsg.str());
+          }
+      }
+
+      /// Check that the filters requested by a layout are available (for encoding) in the linked HDF5 library
+      void checkFiltersAvailable(const DataSetLayout& layout)
+      {
+          if(layout.deflate_level>0 and layout.szip)
+          {
+            std::ostringstream errmsg;
+            errmsg << "Error! Both gzip and szip compression were requested for hdf5 output. Please choose one or the other.";
+            printer_error().raise(LOCAL_INFO, errmsg.str());
+          }
+          if(layout.deflate_level>9)
+          {
+            std::ostringstream errmsg;
+            errmsg << "Error! Invalid gzip compression level ("<<layout.deflate_level<<") requested for hdf5 output. Levels run from 1 (fastest) to 9 (smallest output).";
+            printer_error().raise(LOCAL_INFO, errmsg.str());
+          }
+          if(layout.deflate_level>0) checkFilterAvailable(H5Z_FILTER_DEFLATE, "gzip (deflate)");
+          if(layout.szip)            checkFilterAvailable(H5Z_FILTER_SZIP, "szip");
+          if(layout.shuffle)         checkFilterAvailable(H5Z_FILTER_SHUFFLE, "shuffle");
+      }
+
+      /// Create a dataset creation property list implementing a layout
+      hid_t createDatasetPlist(const DataSetLayout& layout, int rank, const hsize_t* chunkdims, const std::string& dset_name)
+      {
+          hid_t cparms_id = H5Pcreate(H5P_DATASET_CREATE);
+          if(cparms_id<0)
+          {
+            std::ostringstream errmsg;
+            errmsg << "Error creating dataset (with name: \""<<dset_name<<"\") in HDF5 file. H5Pcreate failed.";
+            printer_error().raise(LOCAL_INFO, errmsg.str());
+          }
+
+          // Contiguous storage is the default; chunking is needed for extendible or filtered datasets
+          if(layout.chunklength==0) return cparms_id;
+
+          herr_t status = H5Pset_chunk(cparms_id, rank, chunkdims);
+          if(status<0)
+          {
+            std::ostringstream errmsg;
+            errmsg << "Error creating dataset (with name: \""<<dset_name<<"\") in HDF5 file. H5Pset_chunk failed.";
+            printer_error().raise(LOCAL_INFO, errmsg.str());
+          }
+
+          // Filters are applied in the order they are set, so the shuffle has to come first
+          if(layout.shuffle and H5Pset_shuffle(cparms_id)<0)
+          {
+            std::ostringstream errmsg;
+            errmsg << "Error creating dataset (with name: \""<<dset_name<<"\") in HDF5 file. H5Pset_shuffle failed.";
+            printer_error().raise(LOCAL_INFO, errmsg.str());
+          }
+          if(layout.deflate_level>0 and H5Pset_deflate(cparms_id, layout.deflate_level)<0)
+          {
+            std::ostringstream errmsg;
+            errmsg << "Error creating dataset (with name: \""<<dset_name<<"\") in HDF5 file. H5Pset_deflate failed.";
+            printer_error().raise(LOCAL_INFO, errmsg.str());
+          }
+          if(layout.szip and H5Pset_szip(cparms_id, H5_SZIP_NN_OPTION_MASK, 16)<0)
+          {
+            std::ostringstream errmsg;
+            errmsg << "Error creating dataset (with name: \""<<dset_name<<"\") in HDF5 file. H5Pset_szip failed.";
+            printer_error().raise(LOCAL_INFO, errmsg.str());
+          }
+          return cparms_id;
+      }
+
       /// @}
     }
  
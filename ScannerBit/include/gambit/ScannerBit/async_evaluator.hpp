@@ -0,0 +1,409 @@
+//  GAMBIT: Global and Modular BSM Inference Tool
+//  *********************************************
+///  \file
+///
+///  Asynchronous master-worker evaluation of
+///  points for scanner plugins.
+///
+///  *********************************************
+///
+///  Authors (add name and date if you modify):
+///
+///  \author agent
+///          (agent@local)
+///  \date 2026 Oct
+///
+///  *********************************************
+
+#ifndef __ASYNC_EVALUATOR_HPP__
+#define __ASYNC_EVALUATOR_HPP__
+
+#ifdef WITH_MPI
+#include "mpi.h"
+#endif
+
+#include <vector>
+#include <deque>
+#include <list>
+#include <unordered_map>
+#include <algorithm>
+#include <exception>
+#include <thread>
+#include <cstring>
+#include <cstdint>
+
+#include "gambit/ScannerBit/scanner_utils.hpp"
+#include "gambit/ScannerBit/factory_defs.hpp"
+
+namespace Gambit
+{
+
+    namespace Scanner
+    {
+
+        /// A point evaluated by an AsyncEvaluator
+        struct EvaluatedPoint
+        {
+            /// Position in the unit hypercube
+            std::vector<double> point;
+            /// Value of the likelihood
+            double loglike;
+            /// Point ID and MPI rank under which the point was printed
+            unsigned long long int id;
+            int rank;
+            /// Number given to the point by AsyncEvaluator::submit
+            unsigned long long int seq;
+        };
+
+        /// Evaluates the likelihood at unit-cube points on a dynamic pool of MPI ranks.
+        ///
+        /// Rank 0 (the master) submits points and collects the results, in whatever
+        /// order they are finished; all other ranks (the workers) just call serve().
+        /// Workers are sent batches of points as soon as they have room for them, and
+        /// return the results of each batch in one message. Each worker holds up to
+        /// two batches, so that it can start on the next one while its results are on
+        /// their way. The batch size shrinks as the queue of submitted points empties,
+        /// so that the last points are spread over all the workers instead of waiting
+        /// behind a long batch. While it waits for results, the master evaluates
+        /// points left in the queue itself, one at a time (unless told not to), so no
+        /// rank sits idle. Without MPI, or with a single rank, the master evaluates
+        /// all the points itself, one per call to collect().
+        ///
+        /// The GAMBIT soft shutdown synchronises all ranks inside their likelihood
+        /// calls. While it waits, the master therefore checks whether a shutdown has
+        /// begun. If the scanner cannot stop by itself, the master stops handing out
+        /// points, tells the workers to join the shutdown and joins it too; the
+        /// resulting SoftShutdownException (or HardShutdownException) then leaves
+        /// collect() on the master and serve() on the workers. If the scanner can
+        /// stop by itself, collect() returns straight away so that the plugin can
+        /// see plugin_info.early_shutdown_in_progress() and call finish().
+        ///
+        /// Typical use in a plugin:
+        ///
+        ///   AsyncEvaluator evaluator(LogLike, dim);
+        ///   if (evaluator.is_master())
+        ///   {
+        ///       evaluator.submit(points);
+        ///       std::vector<EvaluatedPoint> results;
+        ///       while (evaluator.pending() > 0) evaluator.collect(results);
+        ///       evaluator.finish();
+        ///   }
+        ///   else evaluator.serve();
+        ///
+        /// The constructor and destructor must be called on all ranks (except that the
+        /// destructor does not communicate when it runs because of an exception).
+        class AsyncEvaluator
+        {
+        private:
+            like_ptr LogLike;
+            int dim;
+            int max_batch;
+            int rank;
+            int numtasks;
+            bool master_evaluates;
+            bool finished;
+            unsigned long long int next_seq;
+
+            /// Points submitted but not yet sent to a worker
+            std::deque<std::pair<unsigned long long int, std::vector<double>>> queue;
+            /// Points sent to workers, by number
+            std::unordered_map<unsigned long long int, std::vector<double>> in_flight;
+            /// Results received but not yet collected
+            std::deque<EvaluatedPoint> ready;
+
+#ifdef WITH_MPI
+            enum tags {work_tag = 1, result_tag = 2, stop_tag = 3, shutdown_tag = 4};
+
+            MPI_Comm comm;
+            /// Number of batches held by each worker
+            std::vector<int> outstanding;
+            /// Work messages still being sent, with their buffers
+            std::list<std::pair<MPI_Request, std::vector<char>>> sends;
+            std::vector<char> recvbuf;
+
+            /// Number of doubles/bytes taken by one point in a work message and one result
+            std::size_t work_size() const {return sizeof(std::uint64_t) + dim*sizeof(double);}
+            static std::size_t result_size() {return 2*sizeof(std::uint64_t) + sizeof(double);}
+
+            /// Forget about work messages that have been delivered
+            void clean_sends()
+            {
+                for (auto it = sends.begin(); it != sends.end();)
+                {
+                    int done;
+                    MPI_Test(&it->first, &done, MPI_STATUS_IGNORE);
+                    if (done) it = sends.erase(it);
+                    else ++it;
+                }
+            }
+
+            /// Hand out queued points to workers with room for another batch
+            void dispatch()
+            {
+                int nworkers = numtasks - 1;
+                for (int w = 1; w < numtasks && !queue.empty(); w++)
+                {
+                    while (outstanding[w] < 2 && !queue.empty())
+                    {
+                        int n = std::max<std::size_t>(1, std::min<std::size_t>(max_batch, queue.size()/(2*nworkers)));
+                        sends.emplace_back();
+                        std::vector<char> &buf = sends.back().second;
+                        buf.resize(n*work_size());
+                        char *out = buf.data();
+                        for (int i = 0; i < n; i++)
+                        {
+                            std::uint64_t seq = queue.front().first;
+                            std::memcpy(out, &seq, sizeof(seq));
+                            std::memcpy(out + sizeof(seq), queue.front().second.data(), dim*sizeof(double));
+                            out += work_size();
+                            in_flight[seq].swap(queue.front().second);
+                            queue.pop_front();
+                        }
+                        MPI_Isend(buf.data(), buf.size(), MPI_BYTE, w, work_tag, comm, &sends.back().first);
+                        outstanding[w]++;
+                    }
+                }
+            }
+
+            /// Receive one message of results, waiting for it if asked to
+            bool receive(bool wait)
+            {
+                MPI_Status status;
+                if (wait)
+                {
+                    MPI_Probe(MPI_ANY_SOURCE, result_tag, comm, &status);
+                }
+                else
+                {
+                    int flag;
+                    MPI_Iprobe(MPI_ANY_SOURCE, result_tag, comm, &flag, &status);
+                    if (!flag) return false;
+                }
+                int size;
+                MPI_Get_count(&status, MPI_BYTE, &size);
+                recvbuf.resize(size);
+                MPI_Recv(recvbuf.data(), size, MPI_BYTE, status.MPI_SOURCE, result_tag, comm, MPI_STATUS_IGNORE);
+                outstanding[status.MPI_SOURCE]--;
+
+                for (const char *in = recvbuf.data(), *end = in + size; in < end; in += result_size())
+                {
+                    std::uint64_t seq, id;
+                    EvaluatedPoint result;
+                    std::memcpy(&seq, in, sizeof(seq));
+                    std::memcpy(&result.loglike, in + sizeof(seq), sizeof(double));
+                    std::memcpy(&id, in + sizeof(seq) + sizeof(double), sizeof(id));
+                    result.seq = seq;
+                    result.id = id;
+                    result.rank = status.MPI_SOURCE;
+                    auto it = in_flight.find(seq);
+                    result.point.swap(it->second);
+                    in_flight.erase(it);
+                    ready.push_back(std::move(result));
+                }
+                return true;
+            }
+
+            /// Number of batches held by all workers
+            int total_outstanding() const
+            {
+                int total = 0;
+                for (int n : outstanding) total += n;
+                return total;
+            }
+
+            /// Take part in a shutdown that has begun.  Returns only if the scanner stops the scan itself.
+            void join_shutdown()
+            {
+                LogLike->tell_scanner_early_shutdown_in_progress();
+                if (LogLike->scanner_can_quit()) return;
+
+                // The workers only reach the soft shutdown synchronisation inside a likelihood
+                // call, so send them no more points and get the idle ones to join in directly.
+                queue.clear();
+                for (int w = 1; w < numtasks; w++)
+                    MPI_Send(nullptr, 0, MPI_BYTE, w, shutdown_tag, comm);
+                while (true) signaldata().attempt_soft_shutdown();
+            }
+#endif
+
+            /// Evaluate the next queued point here
+            void evaluate_locally()
+            {
+                EvaluatedPoint result;
+                result.seq = queue.front().first;
+                result.point.swap(queue.front().second);
+                queue.pop_front();
+                result.loglike = LogLike(result.point);
+                result.id = LogLike->getPtID();
+                result.rank = rank;
+                ready.push_back(std::move(result));
+            }
+
+        public:
+            /// Set up the evaluator on all ranks, to evaluate the likelihood LogLike at points of
+            /// dimension dim, sending workers at most max_batch points at a time.  If master_evaluates
+            /// is false, the master leaves all the points to the workers when there are any.
+            AsyncEvaluator(like_ptr LogLike, int dim, int max_batch = 16, bool master_evaluates = true)
+                : LogLike(LogLike), dim(dim), max_batch(std::max(1, max_batch)), master_evaluates(master_evaluates)
+                , finished(false), next_seq(0)
+            {
+#ifdef WITH_MPI
+                MPI_Comm_dup(MPI_COMM_WORLD, &comm);
+                MPI_Comm_rank(comm, &rank);
+                MPI_Comm_size(comm, &numtasks);
+                outstanding.assign(numtasks, 0);
+#else
+                rank = 0;
+                numtasks = 1;
+#endif
+            }
+
+            AsyncEvaluator(const AsyncEvaluator &) = delete;
+            AsyncEvaluator &operator=(const AsyncEvaluator &) = delete;
+
+            /// Must be called on all ranks, after the master has finished and the workers have left serve()
+            ~AsyncEvaluator()
+            {
+                // When unwinding from a shutdown or error, the other ranks cannot be relied on to answer
+                if (std::uncaught_exception()) return;
+                if (is_master()) finish();
+#ifdef WITH_MPI
+                MPI_Comm_free(&comm);
+#endif
+            }
+
+            /// Is this the rank that submits and collects points?
+            bool is_master() const {return rank == 0;}
+
+            /// Number of ranks evaluating points
+            int workers() const {return numtasks > 1 && !master_evaluates ? numtasks - 1 : numtasks;}
+
+            /// Add a point to the queue, returning the number it will be collected under
+            unsigned long long int submit(const std::vector<double> &point)
+            {
+                if (!is_master())
+                    scan_err << "AsyncEvaluator::submit can only be called on the master rank." << scan_end;
+                if (point.size() != (std::size_t)dim)
+                    scan_err << "AsyncEvaluator was given a point of dimension " << point.size()
+                             << " instead of " << dim << "." << scan_end;
+                queue.emplace_back(next_seq, point);
+                return next_seq++;
+            }
+
+            /// Add a batch of points to the queue
+            void submit(const std::vector<std::vector<double>> &points)
+            {
+                for (auto &&point : points) submit(point);
+            }
+
+            /// Number of points submitted but not collected yet
+            std::size_t pending() const {return queue.size() + ready.size()
+#ifdef WITH_MPI
+                + in_flight.size()
+#endif
+                ;}
+
+            /// Append the points finished since the last call to results.  If wait is true,
+            /// wait until at least one point has been finished (unless none are pending, or
+            /// a shutdown has begun and the scanner is to stop the scan itself).
+            /// Returns the number of points appended.
+            std::size_t collect(std::vector<EvaluatedPoint> &results, bool wait = true)
+            {
+                if (!is_master())
+                    scan_err << "AsyncEvaluator::collect can only be called on the master rank." << scan_end;
+#ifdef WITH_MPI
+                if (numtasks > 1)
+                {
+                    clean_sends();
+                    dispatch();
+                    while (true)
+                    {
+                        // Keep the workers busy while going through the messages waiting here
+                        while (receive(false)) dispatch();
+                        if (!wait || !ready.empty() || (queue.empty() && total_outstanding() == 0)) break;
+
+                        if (signaldata().check_if_shutdown_begun())
+                        {
+                            join_shutdown();
+                            break;
+                        }
+                        if (master_evaluates && !queue.empty()) evaluate_locally();
+                        else std::this_thread::yield();
+                    }
+                }
+                else
+#endif
+                if (wait && ready.empty() && !queue.empty()) evaluate_locally();
+
+                std::size_t n = ready.size();
+                for (auto &&result : ready) results.push_back(std::move(result));
+                ready.clear();
+                return n;
+            }
+
+            /// Drop any points not sent to a worker yet, wait for the workers to finish the
+            /// ones they hold (their results are printed, but not collected), and release
+            /// the workers from serve().
+            void finish()
+            {
+                if (finished || !is_master()) return;
+                finished = true;
+                queue.clear();
+#ifdef WITH_MPI
+                while (total_outstanding() > 0) receive(true);
+                in_flight.clear();
+                ready.clear();
+                for (int w = 1; w < numtasks; w++)
+                    MPI_Send(nullptr, 0, MPI_BYTE, w, stop_tag, comm);
+                for (auto &&send : sends) MPI_Wait(&send.first, MPI_STATUS_IGNORE);
+                sends.clear();
+#endif
+                ready.clear();
+            }
+
+            /// Evaluate the points sent by the master until it calls finish()
+            void serve()
+            {
+                if (is_master()) return;
+#ifdef WITH_MPI
+                std::vector<char> results;
+                std::vector<double> point(dim);
+                while (true)
+                {
+                    MPI_Status status;
+                    MPI_Probe(0, MPI_ANY_TAG, comm, &status);
+                    int size;
+                    MPI_Get_count(&status, MPI_BYTE, &size);
+                    recvbuf.resize(size);
+                    MPI_Recv(recvbuf.data(), size, MPI_BYTE, 0, status.MPI_TAG, comm, MPI_STATUS_IGNORE);
+                    if (status.MPI_TAG == stop_tag) break;
+                    if (status.MPI_TAG == shutdown_tag)
+                    {
+                        // Keep trying to synchronise with the other ranks until the shutdown exception is thrown
+                        signaldata().check_if_shutdown_begun();
+                        while (true) signaldata().attempt_soft_shutdown();
+                    }
+
+                    results.resize(size/work_size()*result_size());
+                    char *out = results.data();
+                    for (const char *in = recvbuf.data(), *end = in + size; in < end; in += work_size())
+                    {
+                        std::memcpy(point.data(), in + sizeof(std::uint64_t), dim*sizeof(double));
+                        double loglike = LogLike(point);
+                        std::uint64_t id = LogLike->getPtID();
+                        std::memcpy(out, in, sizeof(std::uint64_t));
+                        std::memcpy(out + sizeof(std::uint64_t), &loglike, sizeof(double));
+                        std::memcpy(out + sizeof(std::uint64_t) + sizeof(double), &id, sizeof(id));
+                        out += result_size();
+                    }
+                    MPI_Send(results.data(), results.size(), MPI_BYTE, 0, result_tag, comm);
+                }
+#endif
+            }
+        };
+
+    }
+
+}
+
+#endif
@@ -23,6 +23,8 @@
 #define __BASE_PRIORS_HPP__
 
 #include <vector>
+#include <string>
+#include <algorithm>
 #include <unordered_map>
 
 namespace Gambit
@@ -43,6 +45,9 @@ namespace Gambit
         protected:
             std::vector<std::string> param_names;
 
+            /// Positions of param_names in the output array of transformToArray (-1 if not present there)
+            std::vector<int> param_slots;
+
         public:
             BasePrior() : param_size(0), param_names(0) {}
 
@@ -56,6 +61,34 @@ namespace Gambit
 
             virtual double operator()(const std::vector<double> &) const {return 0.0;}
 
+            /// Resolve the position of each parameter of this prior in the output array of transformToArray,
+            /// given the full ordered list of parameter names that the array will hold.
+            virtual void resolveSlots(const std::vector<std::string> &names)
+            {
+                param_slots.assign(param_names.size(), -1);
+                for (unsigned int i = 0; i < param_names.size(); i++)
+                {
+                    auto it = std::find(names.begin(), names.end(), param_names[i]);
+                    if (it != names.end()) param_slots[i] = it - names.begin();
+                }
+            }
+
+            /// Transformation from unit hypercube directly into a contiguous array of physical parameters,
+            /// laid out according to the last call to resolveSlots.  This default version goes through
+            /// the map-based transform, so that existing priors keep working; priors used on the per-point
+            /// path should override it to write into their slots directly.
+            virtual void transformToArray(const double *unit, double *output) const
+            {
+                std::unordered_map<std::string, double> outputMap;
+                transform(std::vector<double>(unit, unit + size()), outputMap);
+                for (unsigned int i = 0; i < param_slots.size(); i++)
+                {
+                    if (param_slots[i] < 0) continue;
+                    auto it = outputMap.find(param_names[i]);
+                    if (it != outputMap.end()) output[param_slots[i]] = it->second;
+                }
+            }
+
             inline unsigned int size() const {return param_size;}
 
             inline void setSize(const unsigned int size) {param_size = size;}
@@ -127,6 +127,19 @@ namespace Gambit
                 return ret_val;
             }
 
+            /// Index-based parameter passing (used by like_ptr to bypass the parameter map).
+            /// Does the function take its parameters from the array given to setParameterArray, ignoring
+            /// the map passed to operator()? If not, like_ptr always fills the map.
+            virtual bool supportsParameterArray() const {return false;}
+
+            /// Resolve the physical parameters, ordered as in the supplied list of names, to fixed slots.
+            /// Returns false if the parameters cannot be passed as an array after all.
+            virtual bool resolveParameterSlots(const std::vector<std::string> &) {return false;}
+
+            /// Provide the physical parameters for the next call as a contiguous array, laid out as in
+            /// the last successful call to resolveParameterSlots.
+            virtual void setParameterArray(const double *) {}
+
             void setPurpose(const std::string p) {purpose = p;}
             void setPrinter(printer* p) {main_printer = p;}
             void setPrior(Priors::BasePrior *p) {prior = p;}
@@ -305,6 +318,27 @@ namespace Gambit
             typedef scan_ptr<double (std::unordered_map<std::string, double> &)> s_ptr;
             std::unordered_map<std::string, double> map;
 
+            /// Contiguous array of physical parameters, used instead of the map when the function supports it
+            std::vector<double> par_array;
+            /// Have the array slots been resolved yet?
+            bool slots_resolved = false;
+            /// Does the function accept parameters via par_array?
+            bool use_par_array = false;
+
+            /// Resolve prior outputs and function inputs to fixed array slots (done once, at the first point),
+            /// if the function supports taking its parameters as an array
+            void resolveSlots()
+            {
+                std::vector<std::string> names = (*this)->getParameters();
+                use_par_array = (*this)->supportsParameterArray() and (*this)->resolveParameterSlots(names);
+                if (use_par_array)
+                {
+                    par_array.assign(names.size(), 0.0);
+                    (*this)->getPrior().resolveSlots(names);
+                }
+                slots_resolved = true;
+            }
+
         public:
             like_ptr(){}
             like_ptr(const like_ptr &in) : s_ptr (in){}
@@ -314,7 +348,18 @@ namespace Gambit
             double operator()(const std::vector<double> &vec)
             {
                 int rank = (*this)->getRank();
-                (*this)->getPrior().transform(vec, map);
+                if (not slots_resolved) resolveSlots();
+                if (use_par_array)
+                {
+                    // Fast path: no hashing or string handling between the prior and the function.
+                    // The function reads par_array and ignores the map, which is not filled.
+                    (*this)->getPrior().transformToArray(vec.data(), par_array.data());
+                    (*this)->setParameterArray(par_array.data());
+                }
+                else
+                {
+                    (*this)->getPrior().transform(vec, map);
+                }
                 double ret_val = (*this)->operator()(map);
                 unsigned long long int id = Gambit::Printers::get_point_id();
                 (*this)->getPrinter().print(ret_val, (*this)->getPurpose(), rank, id);
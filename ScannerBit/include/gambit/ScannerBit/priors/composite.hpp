@@ -73,6 +73,26 @@ namespace Gambit
                 }
             }
             
+            // Resolve the output slots of all the component priors
+            void resolveSlots(const std::vector<std::string> &names)
+            {
+                BasePrior::resolveSlots(names);
+                for (auto it = my_subpriors.begin(), end = my_subpriors.end(); it != end; it++)
+                {
+                    (*it)->resolveSlots(names);
+                }
+            }
+
+            // Transformation from unit hypercube to my_ranges, without any intermediate containers
+            void transformToArray(const double *unit, double *output) const
+            {
+                for (auto it = my_subpriors.begin(), end = my_subpriors.end(); it != end; it++)
+                {
+                    (*it)->transformToArray(unit, output);
+                    unit += (*it)->size();
+                }
+            }
+
             //~CompositePrior() noexcept
             ~CompositePrior()
             {
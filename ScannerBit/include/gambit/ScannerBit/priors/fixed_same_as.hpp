@@ -84,6 +84,16 @@ namespace Gambit
 
                 iter = (iter + 1)%value.size();
             }
+
+            void transformToArray(const double *, double *output) const
+            {
+                for (auto it = param_slots.begin(), end = param_slots.end(); it != end; it++)
+                {
+                    if (*it >= 0) output[*it] = value[iter];
+                }
+
+                iter = (iter + 1)%value.size();
+            }
         };
 
         //if the parameter shares multiple different parameters
@@ -92,9 +102,10 @@ namespace Gambit
         private:
             std::string name;
             std::vector<double> scale, shift;
+            int name_slot;
 
         public:
-            MultiPriors(const std::vector<std::string>& param, const Options& options) : BasePrior(param), scale(param.size(), 1.0), shift(param.size(), 0.0)
+            MultiPriors(const std::vector<std::string>& param, const Options& options) : BasePrior(param), scale(param.size(), 1.0), shift(param.size(), 0.0), name_slot(-1)
             {
                 if (options.hasKey("same_as"))
                 {
@@ -117,7 +128,7 @@ namespace Gambit
                 }
             }
 
-            MultiPriors(std::string name_in, std::unordered_map<std::string, std::pair<double, double> > &map_in)
+            MultiPriors(std::string name_in, std::unordered_map<std::string, std::pair<double, double> > &map_in) : name_slot(-1)
             {
                 std::string::size_type pos_old = 0;
                 std::string::size_type pos = name_in.find("+");
@@ -153,6 +164,24 @@ namespace Gambit
                     outputMap[*it] = (*it1)*value + *it2;
                 }
             }
+
+            void resolveSlots(const std::vector<std::string> &names)
+            {
+                BasePrior::resolveSlots(names);
+                auto it = std::find(names.begin(), names.end(), name);
+                name_slot = (it == names.end()) ? -1 : it - names.begin();
+            }
+
+            void transformToArray(const double *, double *output) const
+            {
+                if (name_slot < 0) return;
+                double value = output[name_slot];
+
+                for (unsigned int i = 0, end = std::min(param_slots.size(), scale.size()); i < end; i++)
+                {
+                    if (param_slots[i] >= 0) output[param_slots[i]] = scale[i]*value + shift[i];
+                }
+            }
         };
 
         LOAD_PRIOR(fixed_value, FixedPrior)
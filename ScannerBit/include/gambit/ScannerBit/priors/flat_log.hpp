@@ -211,6 +211,12 @@ namespace Gambit
                 output[myparameter] = (T::inv(unitpars[0]*(upper-lower) + lower)-shift_out)/scale_out;
             }
 
+            // Transformation from unit interval to specified range, straight into the output array
+            void transformToArray(const double *unitpars, double *output) const
+            {
+                if (param_slots[0] >= 0) output[param_slots[0]] = (T::inv(unitpars[0]*(upper-lower) + lower)-shift_out)/scale_out;
+            }
+
             double operator()(const std::vector<double> &vec) const {return T::prior(vec[0]*scale+shift)*scale;}
         };
 
@@ -14,10 +14,6 @@
 ///
 ///  *********************************************
 
-#ifdef WITH_MPI
-#include "mpi.h"
-#endif
-
 #include <vector>
 #include <string>
 #include <cmath>
@@ -25,6 +21,7 @@
 #include <sstream>
 
 #include "gambit/ScannerBit/scanner_plugin.hpp"
+#include "gambit/ScannerBit/async_evaluator.hpp"
 
 scanner_plugin(grid, version(1, 0, 0))
 {
@@ -33,16 +30,6 @@ scanner_plugin(grid, version(1, 0, 0))
     int plugin_main()
     {
         int ma = get_dimension();
-        int numtasks;
-        int rank;
-        
-#ifdef WITH_MPI
-        MPI_Comm_size(MPI_COMM_WORLD, &numtasks);
-        MPI_Comm_rank(MPI_COMM_WORLD, &rank);
-#else
-        numtasks = 1;
-        rank = 0;
-#endif
 
         std::vector<int> N = get_inifile_value<std::vector<int>>("grid_pts");
         int NTot = 1;
@@ -64,7 +51,17 @@ scanner_plugin(grid, version(1, 0, 0))
         LogLike = get_purpose(get_inifile_value<std::string>("like"));
         std::vector<double> vec(ma, 0.0);
 
-        for (int i = rank, end = NTot; i < end; i+=numtasks)
+        Gambit::Scanner::AsyncEvaluator evaluator(LogLike, ma);
+        if (!evaluator.is_master())
+        {
+            evaluator.serve();
+            return 0;
+        }
+
+        // Only keep enough grid points queued to keep the workers busy
+        std::size_t ahead = 64*evaluator.workers();
+        std::vector<Gambit::Scanner::EvaluatedPoint> results;
+        for (int i = 0; i < NTot; i++)
         {
             int n = i;
             for (int j = 0; j < ma; j++)
@@ -77,8 +74,20 @@ scanner_plugin(grid, version(1, 0, 0))
                 n /= N[j];
             }
 
-            LogLike(vec);
+            evaluator.submit(vec);
+            while (evaluator.pending() >= ahead)
+            {
+                results.clear();
+                evaluator.collect(results);
+            }
+        }
+
+        while (evaluator.pending() > 0)
+        {
+            results.clear();
+            evaluator.collect(results);
         }
+        evaluator.finish();
 
         return 0;
     }
@@ -23,6 +23,7 @@
 #include <iostream>
 
 #include "gambit/ScannerBit/scanner_plugin.hpp"
+#include "gambit/ScannerBit/async_evaluator.hpp"
 #include "gambit/Utils/threadsafe_rng.hpp"
   
 scanner_plugin(random, version(1, 0, 0))
@@ -49,19 +50,39 @@ scanner_plugin(random, version(1, 0, 0))
     {
         std::vector<double> a(dim);
 
+        Gambit::Scanner::AsyncEvaluator evaluator(LogLike, dim);
+        if (!evaluator.is_master())
+        {
+            evaluator.serve();
+            return 0;
+        }
+
         std::cout << "Entering random sampler." << "\n\tnumber of points to calculate:  " << num << std::endl;
         
-        for (int k = 0; k < num; k++)
+        std::size_t ahead = 64*evaluator.workers();
+        std::vector<Gambit::Scanner::EvaluatedPoint> results;
+        int submitted = 0, done = 0;
+        while (done < num)
         {
-            for (int i = rank; i < dim; i+=numtasks)
+            while (submitted < num && evaluator.pending() < ahead)
+            {
+                for (auto &&val : a)
+                {
+                    val = Gambit::Random::draw();
+                }
+                evaluator.submit(a);
+                submitted++;
+            }
+
+            results.clear();
+            evaluator.collect(results);
+            for (std::size_t i = 0; i < results.size(); i++, done++)
             {
-                a[i] = Gambit::Random::draw();
+                if (done%1000 == 0)
+                    std::cout << "points:  " << done << " / " << num << std::endl;
             }
-            LogLike(a);
-            
-            if (k%1000 == 0)
-                std::cout << "points:  " << k << " / " << num << std::endl;
         }
+        evaluator.finish();
         
         return 0;
     }
@@ -26,6 +26,7 @@
 #include <sstream>
 
 #include "gambit/ScannerBit/scanner_plugin.hpp"
+#include "gambit/ScannerBit/async_evaluator.hpp"
 #include "gambit/Utils/threadsafe_rng.hpp"
 
 scanner_plugin(toy_mcmc, version(1, 0, 0))
@@ -75,114 +76,58 @@ scanner_plugin(toy_mcmc, version(1, 0, 0))
 
         std::cout << "Metropolis Hastings Algorthm Started" << std::endl; // << "tpoints = " << "\n\taccept ratio = " << std::endl;
 
+        Gambit::Scanner::AsyncEvaluator evaluator(LogLike, ma);
+        if (!evaluator.is_master())
+        {
+            evaluator.serve();
+            return 0;
+        }
+
         chisq = -LogLike(a);
         id = LogLike->getPtID();
-#ifdef WITH_MPI
-        if (numtasks > 1) 
+        int id_rank = rank;
+
+        // The proposals do not depend on the current point, so they can be drawn ahead
+        // and their results taken in whatever order the workers finish them.
+        std::size_t ahead = 4*evaluator.workers();
+        std::vector<Gambit::Scanner::EvaluatedPoint> results;
+        while (count < N)
         {
-            int countsofar = 0, idnext;
-            MPI_Status stat;
-            std::vector<unsigned long long int> buffer_ids(N);
-            std::vector<double> buffer_chisqs(N);
-            
-            do
+            while (evaluator.pending() < ahead)
             {
-                int countsofarnext = N-count;
-                if (countsofarnext < numtasks)
-                    countsofarnext = numtasks;
-                
-                if (countsofarnext != countsofar)
+                for (auto &&val : a)
                 {
-                    countsofar = countsofarnext;
-                    buffer_ids.resize(countsofar);
-                    buffer_chisqs.resize(countsofar);
+                    val = Gambit::Random::draw();
                 }
-                
-                total += countsofar;
-                for (int i = rank, end = countsofar; i < end; i+=numtasks)
-                {
-                    for (auto &&val : a)
-                    {
-                        val = Gambit::Random::draw();
-                    }
+                evaluator.submit(a);
+            }
 
-                    buffer_chisqs[i] = -LogLike(a);
-                    buffer_ids[i] = LogLike->getPtID();
-                }
-                
-                if (rank == 0)
+            results.clear();
+            evaluator.collect(results);
+            for (auto &&result : results)
+            {
+                total++;
+                chisqnext = -result.loglike;
+
+                ans = chisqnext - chisq;
+                if ((ans <= 0.0)||(-std::log(Gambit::Random::draw()) >= ans))
                 {
-                    for (int i = 0, end = countsofar; i < end; i++)
-                    {
-                        int tag = i%numtasks;
-                        if (tag != 0)
-                        {
-                            MPI_Recv (&buffer_ids[i], 1, MPI_UNSIGNED_LONG_LONG, tag, tag, MPI_COMM_WORLD, &stat);
-                            MPI_Recv (&buffer_chisqs[i], 1, MPI_DOUBLE, tag, tag, MPI_COMM_WORLD, &stat);
-                        }
-                    }
-                
-                    for (auto &&iter : zip(buffer_ids, buffer_chisqs))
-                    {
-                        boost::tie(idnext, chisqnext) = iter;
-                        ans = chisqnext - chisq;
-                        if ((ans <= 0.0)||(-std::log(Gambit::Random::draw()) >= ans))
-                        {
-                            out_stream->print(mult, "mult", rank, id);
-                            id = idnext;
-                            chisq = chisqnext;
-                            mult = 1;
-                            count++;
-                        }
-                        else
-                        {
-                            mult++;
-                        }
-                    }
-                    
+                    out_stream->print(mult, "mult", id_rank, id);
+                    id = result.id;
+                    id_rank = result.rank;
+                    chisq = chisqnext;
+                    mult = 1;
+                    count++;
                     std::cout << "points = " << count << "; accept ratio = " << (double)count/(double)total << std::endl;
+                    if (count >= N) break;
                 }
                 else
                 {
-                    for (int i = rank, end = countsofar; i < end; i+=numtasks)
-                    {
-                        MPI_Send (&buffer_ids[i], 1, MPI_UNSIGNED_LONG_LONG, 0, rank, MPI_COMM_WORLD);
-                        MPI_Send (&buffer_chisqs[i], 1, MPI_DOUBLE, 0, rank, MPI_COMM_WORLD);
-                    }
+                    mult++;
                 }
             }
-            while(count < N); 
-        } else
-#endif
-        do
-        {
-            total++;
-            
-            for (auto &&val : a)
-            {
-                val = Gambit::Random::draw();
-            }
-
-            chisqnext = -LogLike(a);
-            
-            ans = chisqnext - chisq;
-            if ((ans <= 0.0)||(-std::log(Gambit::Random::draw()) >= ans))
-            //if (true)
-            {
-                out_stream->print(mult, "mult", rank, id);
-                id = LogLike->getPtID();
-                chisq = chisqnext;
-                mult = 1;
-                count++;
-                // cout << "\033[2A\tpoints = " << count << "\n\taccept ratio = " << "               \033[15D" << (double)count/(double)total << endl;
-                std::cout << "points = " << count << "; accept ratio = " << (double)count/(double)total << std::endl;
-            }
-            else
-            {
-                mult++;
-            }
         }
-        while(count < N);
+        evaluator.finish();
 
         return 0;
     }
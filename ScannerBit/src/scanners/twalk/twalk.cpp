@@ -18,6 +18,8 @@
 #include "mpi.h"
 #endif
 
+#include <cstring>
+
 #include "plugin_interface.hpp"
 #include "scanner_plugin.hpp"
 #include "twalk.hpp"
@@ -62,6 +64,73 @@ scanner_plugin(twalk, version(1, 0, 0))
     }
 }
 
+#ifdef WITH_MPI
+namespace
+{
+    /// State of a chain, other than its position, exchanged between ranks
+    struct ChainState
+    {
+        double chisq;
+        unsigned long long int id;
+        int mult;
+        int count;
+        int rank;
+    };
+
+    /// Share the chain each rank has just updated (chain talls[i] for rank i) with all
+    /// the other ranks, packing each chain into one block so that a single collective suffices.
+    void shareChains(std::vector<std::vector<double>> &a0, std::vector<double> &chisq,
+                     std::vector<int> &mult, std::vector<int> &count, std::vector<int> &ranks,
+                     std::vector<unsigned long long int> &ids, const std::vector<int> &talls,
+                     int rank, int numtasks, std::vector<char> &sendbuf, std::vector<char> &recvbuf)
+    {
+        const size_t pos_size = a0[0].size()*sizeof(double);
+        const size_t block = sizeof(ChainState) + pos_size;
+        sendbuf.resize(block);
+        recvbuf.resize(block*numtasks);
+
+        int t = talls[rank];
+        ChainState state = {chisq[t], ids[t], mult[t], count[t], ranks[t]};
+        std::memcpy(&sendbuf[0], &state, sizeof(ChainState));
+        std::memcpy(&sendbuf[sizeof(ChainState)], c_ptr(a0[t]), pos_size);
+
+        MPI_Allgather(&sendbuf[0], block, MPI_BYTE, &recvbuf[0], block, MPI_BYTE, MPI_COMM_WORLD);
+
+        for (int i = 0; i < numtasks; i++)
+        {
+            t = talls[i];
+            const char *in = &recvbuf[i*block];
+            std::memcpy(&state, in, sizeof(ChainState));
+            std::memcpy(c_ptr(a0[t]), in + sizeof(ChainState), pos_size);
+            chisq[t] = state.chisq;
+            ids[t] = state.id;
+            mult[t] = state.mult;
+            count[t] = state.count;
+            ranks[t] = state.rank;
+        }
+    }
+
+    /// Randomly choose the chain to be updated by each rank (talls[0 to numtasks-1], all different),
+    /// and the chain that each of them is to be updated with (talls[numtasks to 2*numtasks-1]).
+    void pickChains(std::vector<int> &talls, std::vector<int> &tints, int numtasks, RanNumGen &gDev)
+    {
+        int j = tints.size();
+        for(int i = 0; i < numtasks; i++)
+        {
+            int temp = int((j--)*gDev.Doub());
+            talls[i] = tints[temp];
+            tints[temp] = tints[j];
+            tints[j] = talls[i];
+        }
+
+        for(int i = numtasks, end = talls.size(); i < end; i++)
+        {
+            talls[i] = tints[int(j*gDev.Doub())];
+        }
+    }
+}
+#endif
+
 void TWalk(Gambit::Scanner::like_ptr LogLike, 
            Gambit::Scanner::printer_interface &printer, 
            Gambit::Scanner::resume_params_func set_resume_params, 
@@ -113,6 +182,10 @@ void TWalk(Gambit::Scanner::like_ptr LogLike,
     for (int i = 0; i < NThreads; i++) tints[i] = i;
     std::vector<int> talls(2*numtasks);
     set_resume_params(tints, talls);
+
+    // Buffers for exchanging chains, and for broadcasting the control flag and chain choices
+    std::vector<char> sendbuf, recvbuf;
+    std::vector<int> control(1 + talls.size() + tints.size());
 #else
     int numtasks = 1;
     int rank = 0;
@@ -129,16 +202,7 @@ void TWalk(Gambit::Scanner::like_ptr LogLike,
     if (set_resume_params.resume_mode())
     {
 #ifdef WITH_MPI
-        for (int i = 0; i < numtasks; i++)
-        {
-            MPI_Barrier(MPI_COMM_WORLD);
-            MPI_Bcast (c_ptr(a0[talls[i]]), a0[talls[i]].size(), MPI_DOUBLE, i, MPI_COMM_WORLD);
-            MPI_Bcast (&chisq[talls[i]], 1, MPI_DOUBLE, i, MPI_COMM_WORLD);
-            MPI_Bcast (&mult[talls[i]], 1, MPI_INT, i, MPI_COMM_WORLD);
-            MPI_Bcast (&count[talls[i]], 1, MPI_INT, i, MPI_COMM_WORLD);
-            MPI_Bcast (&ranks[talls[i]], 1, MPI_INT, i, MPI_COMM_WORLD);
-            MPI_Bcast (&ids[talls[i]], 1, MPI_UNSIGNED_LONG_LONG, i, MPI_COMM_WORLD);
-        }
+        shareChains(a0, chisq, mult, count, ranks, ids, talls, rank, numtasks, sendbuf, recvbuf);
 #endif
     }
     else
@@ -156,17 +220,20 @@ void TWalk(Gambit::Scanner::like_ptr LogLike,
                 ranks[t] = rank;
 #ifdef WITH_MPI
             }
-            MPI_Barrier(MPI_COMM_WORLD);
             MPI_Bcast (c_ptr(a0[t]), a0[t].size(), MPI_DOUBLE, 0, MPI_COMM_WORLD);
 #endif
         }
     }
 
 #ifdef WITH_MPI
-    MPI_Barrier(MPI_COMM_WORLD);
     MPI_Bcast (c_ptr(chisq), chisq.size(), MPI_DOUBLE, 0, MPI_COMM_WORLD);
     MPI_Bcast (c_ptr(ids), ids.size(), MPI_UNSIGNED_LONG_LONG, 0, MPI_COMM_WORLD);
     MPI_Bcast (c_ptr(ranks), ranks.size(), MPI_INT, 0, MPI_COMM_WORLD);
+
+    // Choose the chains for the first step
+    if (rank == 0) pickChains(talls, tints, numtasks, *gDev[0]);
+    MPI_Bcast (c_ptr(talls), talls.size(), MPI_INT, 0, MPI_COMM_WORLD);
+    MPI_Bcast (c_ptr(tints), tints.size(), MPI_INT, 0, MPI_COMM_WORLD);
 #endif
 
     std::cout << "Metropolis Hastings/TWalk Algorithm Started"  << std::endl;
@@ -174,27 +241,6 @@ void TWalk(Gambit::Scanner::like_ptr LogLike,
     do
     {
 #ifdef WITH_MPI
-        if (rank == 0)
-        {
-            int j = NThreads;
-            for(int i = 0; i < numtasks; i++)
-            {
-                int temp = int((j--)*gDev[0]->Doub());
-                talls[i] = tints[temp];
-                tints[temp] = tints[j];
-                tints[j] = talls[i];
-            }
-
-            for(int i = numtasks, end = talls.size(); i < end; i++)
-            {
-                talls[i] = tints[int(j*gDev[0]->Doub())];
-            }
-        }
-
-        MPI_Barrier(MPI_COMM_WORLD);
-        MPI_Bcast (c_ptr(talls), talls.size(), MPI_INT, 0, MPI_COMM_WORLD);
-        MPI_Bcast (c_ptr(tints), tints.size(), MPI_INT, 0, MPI_COMM_WORLD);
-
         t = talls[rank];
         tt = talls[rank + numtasks];
         double logZ = gDev[t]->Dev(aNext, a0, t, tt, NThreads - numtasks, tints);
@@ -228,16 +274,7 @@ void TWalk(Gambit::Scanner::like_ptr LogLike,
         }
 
 #ifdef WITH_MPI
-        for (int i = 0; i < numtasks; i++)
-        {
-            MPI_Barrier(MPI_COMM_WORLD);
-            MPI_Bcast (c_ptr(a0[talls[i]]), a0[talls[i]].size(), MPI_DOUBLE, i, MPI_COMM_WORLD);
-            MPI_Bcast (&chisq[talls[i]], 1, MPI_DOUBLE, i, MPI_COMM_WORLD);
-            MPI_Bcast (&mult[talls[i]], 1, MPI_INT, i, MPI_COMM_WORLD);
-            MPI_Bcast (&count[talls[i]], 1, MPI_INT, i, MPI_COMM_WORLD);
-            MPI_Bcast (&ranks[talls[i]], 1, MPI_INT, i, MPI_COMM_WORLD);
-            MPI_Bcast (&ids[talls[i]], 1, MPI_UNSIGNED_LONG_LONG, i, MPI_COMM_WORLD);
-        }
+        shareChains(a0, chisq, mult, count, ranks, ids, talls, rank, numtasks, sendbuf, recvbuf);
 #endif
         for (int l = 0; l < NThreads; l++)
             mult[l]++;
@@ -317,9 +354,16 @@ void TWalk(Gambit::Scanner::like_ptr LogLike,
             if (cnt % 100 == 0)
             std::cout << "points = " << cnt  << "( " << cnt/double(NThreads) << ")" << "\n\taccept ratio = " << (double)cnt/(double)total/(double)numtasks << "\n\tR = " << Ravg/ma << std::endl;
 #ifdef WITH_MPI
+            // Choose the chains for the next step, and send them out with the decision to continue
+            if (cont) pickChains(talls, tints, numtasks, *gDev[0]);
+            control[0] = cont;
+            std::copy(talls.begin(), talls.end(), control.begin() + 1);
+            std::copy(tints.begin(), tints.end(), control.begin() + 1 + talls.size());
         }
-        MPI_Barrier(MPI_COMM_WORLD);
-        MPI_Bcast (&cont, 1, MPI_C_BOOL, 0, MPI_COMM_WORLD);
+        MPI_Bcast (c_ptr(control), control.size(), MPI_INT, 0, MPI_COMM_WORLD);
+        cont = control[0];
+        std::copy(control.begin() + 1, control.begin() + 1 + talls.size(), talls.begin());
+        std::copy(control.begin() + 1 + talls.size(), control.end(), tints.begin());
 #endif
     }
     while((cont));
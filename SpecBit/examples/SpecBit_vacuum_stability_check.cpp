@@ -0,0 +1,200 @@
+//   GAMBIT: Global and Modular BSM Inference Tool
+//   *********************************************
+///  \file
+///
+///  Regression check for the SingletDM vacuum
+///  stability calculation in SpecBit, which finds
+///  the minimum of the Higgs quartic coupling on
+///  splines of the running couplings.  The scale
+///  of the minimum is compared against a dense
+///  scan that runs the couplings directly, and
+///  against a finer tabulation of the couplings.
+///
+///  Returns non-zero if any check fails.
+///
+///  *********************************************
+///
+///  Authors (add name and date if you modify):
+///
+///  \author agent
+///          (agent@local)
+///  \date 2026 Oct
+///
+///  *********************************************
+
+// Always required in any standalone module main file
+#include "gambit/Elements/standalone_module.hpp"
+#include "gambit/SpecBit/SpecBit_rollcall.hpp"
+
+// Only needed here
+#include <cmath>
+#include <memory>
+#include <sstream>
+
+using namespace SpecBit::Functown;
+
+namespace
+{
+
+  int failures = 0;
+
+  void check(bool passed, const std::string& what)
+  {
+    std::cout << (passed ? "  passed: " : "  FAILED: ") << what << std::endl;
+    if (not passed) failures++;
+  }
+
+  const double high_scale = 1.22e19;
+
+  /// Scale and value of the lowest Higgs quartic coupling found by running a copy of the
+  /// spectrum up from 100 GeV to the high scale in steps of 1/points_per_decade decades
+  std::pair<double, double> scan_min_lambda(const Spectrum& spec, int points_per_decade)
+  {
+    std::unique_ptr<SubSpectrum> he = spec.clone_HE();
+    int n = int(std::ceil((std::log10(high_scale) - 2.0)*points_per_decade));
+    std::pair<double, double> lowest(100.0, INFINITY);
+    for (int i = 0; i <= n; i++)
+    {
+      double scale = std::pow(10, std::min(2.0 + double(i)/points_per_decade, std::log10(high_scale)));
+      he->RunToScale(scale);
+      double lambda = he->get(Par::dimensionless, "lambda_h");
+      if (lambda < lowest.second) lowest = std::make_pair(scale, lambda);
+    }
+    return lowest;
+  }
+
+  /// Higgs quartic coupling at a given scale, running a fresh copy of the spectrum
+  double lambda_at(const Spectrum& spec, double scale)
+  {
+    std::unique_ptr<SubSpectrum> he = spec.clone_HE();
+    he->RunToScale(scale);
+    return he->get(Par::dimensionless, "lambda_h");
+  }
+
+}
+
+int main()
+{
+
+  try
+  {
+
+    std::cout << std::endl << "Starting SpecBit vacuum stability check" << std::endl;
+    std::cout << "----------" << std::endl;
+
+    initialise_standalone_logs("runs/SpecBit_vacuum_stability_check/logs/");
+    model_warning().set_fatal(true);
+
+    // Standard Model inputs, as in yaml_files/SpecBit_vacuum_stability.yaml
+    ModelParameters* SM = Models::StandardModel_SLHA2::Functown::primary_parameters.getcontentsPtr();
+    SM->setValue("alphainv", 1.27940010E+02);
+    SM->setValue("GF", 1.16637870E-05);
+    SM->setValue("alphaS", 1.18400000E-01);
+    SM->setValue("mZ", 9.11876000E+01);
+    SM->setValue("mBmB", 4.18000000E+00);
+    SM->setValue("mT", 173.34);
+    SM->setValue("mTau", 1.77682000E+00);
+    SM->setValue("mNu3", 0);
+    SM->setValue("mE", 5.10998928E-04);
+    SM->setValue("mNu1", 0);
+    SM->setValue("mMu", 1.05658372E-01);
+    SM->setValue("mNu2", 0);
+    SM->setValue("mD", 4.80000000E-03);
+    SM->setValue("mU", 2.30000000E-03);
+    SM->setValue("mS", 9.50000000E-02);
+    SM->setValue("mCmC", 1.27500000E+00);
+    SM->setValue("CKM_lambda", 0.22537);
+    SM->setValue("CKM_A", 0.814);
+    SM->setValue("CKM_rhobar", 0.117);
+    SM->setValue("CKM_etabar", 0.353);
+    SM->setValue("theta12", 0.58376);
+    SM->setValue("theta23", 0.76958);
+    SM->setValue("theta13", 0.15495);
+    SM->setValue("delta13", 0);
+    SM->setValue("alpha1", 0);
+    SM->setValue("alpha2", 0);
+    ModelParameters* Higgs = Models::StandardModel_Higgs_running::Functown::primary_parameters.getcontentsPtr();
+    Higgs->setValue("mH", 125.0);
+    Higgs->setValue("QEWSB", 173.0);
+    ModelParameters* Singlet = Models::SingletDM_running::Functown::primary_parameters.getcontentsPtr();
+
+    // Resolve dependencies 'by hand'
+    get_SMINPUTS.notifyOfModel("StandardModel_SLHA2");
+    get_SMINPUTS.resolveDependency(&Models::StandardModel_SLHA2::Functown::primary_parameters);
+    get_SingletDM_spectrum_pole.notifyOfModel("StandardModel_Higgs_running");
+    get_SingletDM_spectrum_pole.notifyOfModel("SingletDM_running");
+    get_SingletDM_spectrum_pole.resolveDependency(&get_SMINPUTS);
+    get_SingletDM_spectrum_pole.resolveDependency(&Models::StandardModel_Higgs_running::Functown::primary_parameters);
+    get_SingletDM_spectrum_pole.resolveDependency(&Models::SingletDM_running::Functown::primary_parameters);
+    find_min_lambda.notifyOfModel("StandardModel_Higgs_running");
+    find_min_lambda.notifyOfModel("SingletDM_running");
+    find_min_lambda.resolveDependency(&get_SMINPUTS);
+    find_min_lambda.resolveDependency(&get_SingletDM_spectrum_pole);
+    find_min_lambda.setOption<double>("set_high_scale", high_scale);
+
+    // A small singlet barely changes the SM running (and its instability); larger couplings stabilise it
+    const double singlets[4][3] = {{100., 0.01, 0.01}, {500., 0.1, 0.1}, {1000., 0.3, 0.2}, {2000., 0.5, 0.5}};
+    for (int i = 0; i < 4; i++)
+    {
+      Singlet->setValue("mS", singlets[i][0]);
+      Singlet->setValue("lambda_hS", singlets[i][1]);
+      Singlet->setValue("lambda_S", singlets[i][2]);
+      std::ostringstream point;
+      point << "mS = " << singlets[i][0] << ", lambda_hS = " << singlets[i][1] << ", lambda_S = " << singlets[i][2];
+      std::cout << std::endl << point.str() << ":" << std::endl;
+
+      try
+      {
+        get_SMINPUTS.reset_and_calculate();
+        get_SingletDM_spectrum_pole.reset_and_calculate();
+        find_min_lambda.setOption<int>("rge_points_per_decade", 4);
+        find_min_lambda.reset_and_calculate();
+        dbl_dbl_bool coarse = find_min_lambda(0);
+        find_min_lambda.setOption<int>("rge_points_per_decade", 16);
+        find_min_lambda.reset_and_calculate();
+        dbl_dbl_bool fine = find_min_lambda(0);
+
+        const Spectrum& spec = get_SingletDM_spectrum_pole(0);
+        std::pair<double, double> scanned = scan_min_lambda(spec, 40);
+        std::cout << "  minimum of lambda_h from the scan: " << scanned.second << " at " << scanned.first << " GeV" << std::endl;
+        std::cout << "  scale found with 4 (16) points per decade: " << coarse.second << " (" << fine.second << ") GeV" << std::endl;
+
+        if (scanned.second < 0)
+        {
+          // The scale of the minimum must be found to well within one step of the scan
+          check(std::abs(std::log10(coarse.second/scanned.first)) < 0.05, "scale of the minimum agrees with the scan");
+          check(lambda_at(spec, coarse.second) <= scanned.second + 1e-6*std::abs(scanned.second), "minimum is no higher than the scan's");
+          check(std::abs(std::log10(coarse.second/fine.second)) < 0.01, "scale of the minimum agrees with a finer tabulation");
+          check(coarse.first < 1e300, "vacuum is reported as unstable or metastable");
+        }
+        else
+        {
+          check(coarse.second == high_scale and fine.second == high_scale and coarse.first == 1e300, "vacuum is reported as stable");
+        }
+        check(coarse.flag == fine.flag, "perturbativity agrees with a finer tabulation");
+      }
+      catch (Gambit::invalid_point_exception& e)
+      {
+        std::cout << "  point invalidated by the spectrum generator: " << e.what() << std::endl;
+      }
+    }
+
+    std::cout << std::endl;
+    if (failures > 0)
+    {
+      std::cout << "SpecBit vacuum stability check: " << failures << " FAILED." << std::endl << std::endl;
+      return 1;
+    }
+    std::cout << "SpecBit vacuum stability check passed." << std::endl << std::endl;
+
+  }
+
+  catch (std::exception& e)
+  {
+    std::cout << "SpecBit vacuum stability check has exited with fatal exception: " << e.what() << std::endl;
+    return 1;
+  }
+
+  return 0;
+
+}
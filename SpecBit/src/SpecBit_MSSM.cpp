@@ -942,19 +942,34 @@ namespace Gambit
     /// Helper function to work out if the LSP is invisible, and if so, which particle it is.
     std::vector<str> get_invisibles(const SubSpectrum& spec)
     {
+      // Masses needed, looked up once and retrieved together at each point.  This is
+      // called from more than one module function, so keep one list per thread.
+      static thread_local SpecParSnapshot masses;
+      static thread_local const std::size_t
+        i_chi0 = masses.add(SpecParHandle(Par::Pole_Mass,"~chi0",1)),
+        i_nu   = masses.add(SpecParHandle(Par::Pole_Mass,"~nu",1)),
+        i_chip = masses.add(SpecParHandle(Par::Pole_Mass,"~chi+",1)),
+        i_g    = masses.add(SpecParHandle(Par::Pole_Mass,"~g")),
+        i_d    = masses.add(SpecParHandle(Par::Pole_Mass,"~d",1)),
+        i_u    = masses.add(SpecParHandle(Par::Pole_Mass,"~u",1)),
+        i_e    = masses.add(SpecParHandle(Par::Pole_Mass,"~e-",1)),
+        i_h2   = masses.add(SpecParHandle(Par::Pole_Mass,"h0",2)),
+        i_A0   = masses.add(SpecParHandle(Par::Pole_Mass,"A0"));
+      masses.update(spec);
+
       // Get the lighter of the lightest neutralino and the lightest sneutrino
-      std::pair<str,double> neutralino("~chi0_1", spec.get(Par::Pole_Mass,"~chi0",1));
-      std::pair<str,double> sneutrino("~nu_1", spec.get(Par::Pole_Mass,"~nu",1));
+      std::pair<str,double> neutralino("~chi0_1", masses[i_chi0]);
+      std::pair<str,double> sneutrino("~nu_1", masses[i_nu]);
       std::pair<str,double> lnp = (neutralino.second < sneutrino.second ? neutralino : sneutrino);
 
       // Work out if this is indeed the LSP, and if decays of at least one neutral higgs to it are kinematically possible.
-      bool inv_lsp = spec.get(Par::Pole_Mass,"~chi+",1) > lnp.second and
-                     spec.get(Par::Pole_Mass,"~g") > lnp.second and
-                     spec.get(Par::Pole_Mass,"~d",1) > lnp.second and
-                     spec.get(Par::Pole_Mass,"~u",1) > lnp.second and
-                     spec.get(Par::Pole_Mass,"~e-",1) > lnp.second and
-                     (spec.get(Par::Pole_Mass,"h0",2) > 2.*lnp.second or
-                      spec.get(Par::Pole_Mass,"A0") > 2.*lnp.second);
+      bool inv_lsp = masses[i_chip] > lnp.second and
+                     masses[i_g] > lnp.second and
+                     masses[i_d] > lnp.second and
+                     masses[i_u] > lnp.second and
+                     masses[i_e] > lnp.second and
+                     (masses[i_h2] > 2.*lnp.second or
+                      masses[i_A0] > 2.*lnp.second);
 
       // Create a vector containing all invisible products of higgs decays.
       if (inv_lsp) return initVector<str>(lnp.first);
@@ -1146,13 +1161,17 @@ namespace Gambit
     void add_extra_MSSM_parameter_combinations(std::map<std::string,double>& specmap, const SubSpectrum& mssm)
     {
       double At = 0;
-      double Yt = mssm.get(Par::dimensionless, "Yu", 3, 3);
+      static thread_local const SpecParHandle Yu33(Par::dimensionless, "Yu", 3, 3);
+      static thread_local const SpecParHandle TYu33(Par::mass1, "TYu", 3, 3);
+      static thread_local const SpecParHandle Mu(Par::mass1, "Mu");
+      static thread_local const SpecParHandle tanbeta(Par::dimensionless, "tanbeta");
+      double Yt = Yu33.get(mssm);
       if(std::abs(Yt) > 1e-12)
       {
-        At = mssm.get(Par::mass1, "TYu", 3, 3) / Yt;
+        At = TYu33.get(mssm) / Yt;
       }
-      double MuSUSY = mssm.get(Par::mass1, "Mu");
-      double tb = mssm.get(Par::dimensionless, "tanbeta");
+      double MuSUSY = Mu.get(mssm);
+      double tb = tanbeta.get(mssm);
       specmap["Xt"] = At - MuSUSY / tb;
       /// Determine which states are the third gens then add them for printing
       str msf1, msf2;
@@ -20,9 +20,11 @@
 
 #include <string>
 #include <sstream>
+#include <algorithm>
 
 #include <gsl/gsl_math.h>
 #include <gsl/gsl_min.h>
+#include <gsl/gsl_spline.h>
 
 #include "gambit/Elements/gambit_module_headers.hpp"
 #include "gambit/Elements/spectrum.hpp"
@@ -53,13 +55,123 @@ namespace Gambit
     using namespace LogTags;
     using namespace flexiblesusy;
     
-    bool check_perturb_to_min_lambda(const Spectrum& spec,double scale,int pts)
+    /// Running dimensionless couplings of a spectrum, tabulated by running the
+    /// RGEs once from a low to a high scale in small steps (so every step only
+    /// integrates over a short range), with cubic splines in log10(scale) in
+    /// between. This replaces re-running a clone of the spectrum from the
+    /// input scale every time a coupling is needed at a new scale.
+    class RGETrajectory
+    {
+      public:
+        /// Tabulate all components of the given parameters of spec (which is
+        /// run to high_scale in the process) between low_scale and high_scale
+        RGETrajectory(SubSpectrum& spec, double low_scale, double high_scale, int points_per_decade,
+                      const std::vector<SpectrumParameter>& parameters)
+          : logmu_low(log10(low_scale)), logmu_high(log10(high_scale))
+        {
+          // Work out the individual components of all parameters
+          for(std::vector<SpectrumParameter>::const_iterator it = parameters.begin(); it != parameters.end(); ++it)
+          {
+            const std::vector<int> shape = it->shape();
+            if(shape.size()==1 and shape[0]==1) components.push_back(Component(it->tag(), it->name(), 0, 0));
+            else if(shape.size()==1) for(int k = 1; k<=shape[0]; ++k) components.push_back(Component(it->tag(), it->name(), k, 0));
+            else if(shape.size()==2) for(int k = 1; k<=shape[0]; ++k) for(int l = 1; l<=shape[1]; ++l) components.push_back(Component(it->tag(), it->name(), k, l));
+          }
+
+          // Run up through the grid, recording every component at every node
+          int n = std::max(3, int(ceil((logmu_high - logmu_low) * points_per_decade)) + 1);
+          logmu.resize(n);
+          std::vector<std::vector<double> > values(components.size(), std::vector<double>(n));
+          for(int i=0; i<n; ++i)
+          {
+            logmu[i] = (i == n-1) ? logmu_high : logmu_low + i*(logmu_high - logmu_low)/(n-1);
+            spec.RunToScale(pow(10,logmu[i]));
+            for(size_t c=0; c<components.size(); ++c) values[c][i] = components[c].get(spec);
+          }
+
+          for(size_t c=0; c<components.size(); ++c)
+          {
+            gsl_spline* spline = gsl_spline_alloc(gsl_interp_cspline, n);
+            gsl_spline_init(spline, &logmu[0], &values[c][0], n);
+            splines.push_back(spline);
+          }
+        }
+
+        ~RGETrajectory()
+        {
+          for(size_t c=0; c<splines.size(); ++c) gsl_spline_free(splines[c]);
+        }
+
+        /// Index of a component (i, j = 0 for scalars, j = 0 for vectors)
+        size_t index(Par::Tags tag, const std::string& name, int i = 0, int j = 0) const
+        {
+          for(size_t c=0; c<components.size(); ++c)
+          {
+            if(components[c].tag == tag and components[c].name == name and components[c].i == i and components[c].j == j) return c;
+          }
+          std::ostringstream msg;
+          msg << "Parameter " << name << " is not part of the RGE trajectory.";
+          SpecBit_error().raise(LOCAL_INFO, msg.str());
+          return 0;
+        }
+
+        /// Number of components
+        size_t size() const { return components.size(); }
+
+        /// Value of a component at a given log10(scale), clamped to the tabulated range
+        double value(size_t c, double log_scale) const
+        {
+          return gsl_spline_eval(splines[c], std::min(std::max(log_scale, logmu_low), logmu_high), NULL);
+        }
+
+        /// Derivative of a component with respect to log10(scale)
+        double derivative(size_t c, double log_scale) const
+        {
+          return gsl_spline_eval_deriv(splines[c], std::min(std::max(log_scale, logmu_low), logmu_high), NULL);
+        }
+
+        /// The log10(scale) grid
+        const std::vector<double>& grid() const { return logmu; }
+
+      private:
+        struct Component
+        {
+          Par::Tags tag;
+          std::string name;
+          int i, j;
+          Component(Par::Tags tag, const std::string& name, int i, int j) : tag(tag), name(name), i(i), j(j) {}
+          double get(const SubSpectrum& spec) const
+          {
+            if(i == 0) return spec.get(tag, name);
+            if(j == 0) return spec.get(tag, name, i);
+            return spec.get(tag, name, i, j);
+          }
+        };
+
+        double logmu_low, logmu_high;
+        std::vector<double> logmu;
+        std::vector<Component> components;
+        std::vector<gsl_spline*> splines;
+
+        RGETrajectory(const RGETrajectory&);
+        RGETrajectory& operator=(const RGETrajectory&);
+    };
+
+    /// Wrapper around RGETrajectory::value for the GSL minimiser
+    struct TrajectoryComponent
+    {
+      const RGETrajectory* trajectory;
+      size_t index;
+    };
+
+    double trajectory_value(double log_scale, void *params)
+    {
+      const TrajectoryComponent* tc = (const TrajectoryComponent*) params;
+      return tc->trajectory->value(tc->index, log_scale);
+    }
+
+    bool check_perturb_to_min_lambda(const RGETrajectory& trajectory,double scale,int pts)
     {
-      using namespace flexiblesusy;
-      using namespace Gambit;
-      using namespace SpecBit;
-      
-      std::unique_ptr<SubSpectrum> SingletDM = spec.clone_HE();
       double step = log10(scale) / pts;
       double runto;
       
@@ -69,48 +181,11 @@ namespace Gambit
         runto = pow(10,step*float(i+1.0)); // scale to run spectrum to
         if (runto<100){runto=200.0;}// avoid running to low scales
         
-        
-        SingletDM -> RunToScale(runto);
-        
-        static const SpectrumContents::SingletDM contents;
-        static const std::vector<SpectrumParameter> required_parameters = contents.all_parameters_with_tag(Par::dimensionless);
-        
-        for(std::vector<SpectrumParameter>::const_iterator it = required_parameters.begin();
-            it != required_parameters.end(); ++it)
+        for(size_t c=0; c<trajectory.size(); ++c)
         {
-          const Par::Tags        tag   = it->tag();
-          const std::string      name  = it->name();
-          const std::vector<int> shape = it->shape();
-          std::ostringstream label;
-          label << name <<" "<< Par::toString.at(tag);
-          if(shape.size()==1 and shape[0]==1)
-          {
-            if (abs(SingletDM->get(tag,name))>ul)
-            {
-              return false;
-            }
-          }
-          
-          else if(shape.size()==1 and shape[0]>1)
+          if (abs(trajectory.value(c,log10(runto)))>ul)
           {
-            for(int k = 1; k<=shape[0]; ++k) {
-              if (abs(SingletDM->get(tag,name,k))>ul)
-              {
-                return false;
-              }
-              
-            }
-          }
-          else if(shape.size()==2)
-          {
-            for(int k = 1; k<=shape[0]; ++k) {
-              for(int j = 1; j<=shape[0]; ++j) {
-                if (abs(SingletDM->get(tag,name,k,j))>ul)
-                {
-                  return false;
-                }
-              }
-            }
+            return false;
           }
         }
       }
@@ -118,25 +193,6 @@ namespace Gambit
       return true;
     }
     
-    double run_lambda(double scale ,  void *params)
-    {
-      using namespace flexiblesusy;
-      using namespace Gambit;
-      using namespace SpecBit;
-      std::unique_ptr<SubSpectrum>* spec=(std::unique_ptr<SubSpectrum>* )params;
-      
-      if (scale>1.0e21){scale=1.0e21;}// avoid running to high scales
-      
-      if (scale<1.0){scale=1.0;}// avoid running to very low scales
-      
-      // clone the original spectrum incase the running takes the spectrum
-      // into a non-perturbative scale and thus the spectrum is no longer reliable
-      
-      (*spec)->RunToScale(scale);
-      
-      return (*spec)->get(Par::dimensionless,"lambda_h");
-    }
-    
     void find_min_lambda(dbl_dbl_bool& vs_tuple)
     {
       using namespace flexiblesusy;
@@ -145,88 +201,91 @@ namespace Gambit
       const Options& runOptions=*myPipe::runOptions;
       double high_energy_limit = runOptions.getValueOrDef<double>(1.22e19,"set_high_scale");
       int check_perturb_pts = runOptions.getValueOrDef<double>(10,"check_perturb_pts");
+      /// Option rge_points_per_decade<int>: density of the grid on which the running couplings are tabulated (default 4)
+      int points_per_decade = runOptions.getValueOrDef<int>(4,"rge_points_per_decade");
       using namespace Gambit;
       using namespace SpecBit;
       
       const Spectrum& fullspectrum = *myPipe::Dep::SingletDM_spectrum;
       std::unique_ptr<SubSpectrum> speccloned = fullspectrum.clone_HE();
-      
-      // three scales at which we choose to run the quartic coupling up to, and then use a Lagrange interpolating polynomial
-      // to get an estimate for the location of the minimum, this is an efficient way to narrow down over a huge energy range
-      double u_1 = 1, u_2 = 5, u_3 = 12;
-      double lambda_1,lambda_2,lambda_3;
+
+      // Run the couplings up once, from the electroweak scale to the high scale
+      static const SpectrumContents::SingletDM contents;
+      static const std::vector<SpectrumParameter> required_parameters = contents.all_parameters_with_tag(Par::dimensionless);
+      const double ew_scale = 100.0;
+      RGETrajectory trajectory(*speccloned, ew_scale, high_energy_limit, points_per_decade, required_parameters);
+      TrajectoryComponent lambda_h = {&trajectory, trajectory.index(Par::dimensionless,"lambda_h")};
+      const std::vector<double>& grid = trajectory.grid();
+
       double lambda_min = 0;
       
-      
       bool min_exists = 1;// check if gradient is positive at electroweak scale
-      if ( run_lambda(101.0, &speccloned ) > run_lambda(100.0, &speccloned ) )
+      if ( trajectory.derivative(lambda_h.index, log10(ew_scale)) > 0 )
       {
         // gradient is positive, the minimum is less than electroweak scale so
         // lambda_h must be monotonally increasing
         min_exists = 0;
-        lambda_min = run_lambda(100.0,&speccloned);
+        lambda_min = trajectory_value(log10(ew_scale), &lambda_h);
       }
       
       double mu_min = 0;
       if (min_exists)
       {
-        // fit parabola (in log space) to the 3 trial points and use this to estimate the minimum
-        for (int i=1;i<3;i++)
+        // find the lowest tabulated point; the minimum lies within one grid step of it
+        size_t k_min = 0;
+        for (size_t k=1;k<grid.size();k++)
         {
-          
-          lambda_1 = run_lambda(pow(10,u_1),&speccloned);
-          lambda_2 = run_lambda(pow(10,u_2),&speccloned);
-          lambda_3 = run_lambda(pow(10,u_3),&speccloned);
- 
-          double min_u= (lambda_1*(pow(u_2,2)-pow(u_3,2))  - lambda_2*(pow(u_1,2)-pow(u_3,2)) + lambda_3*(pow(u_1,2)-pow(u_2,2)));
-          double denominator = ( lambda_1*(u_2-u_3)+ lambda_2*(u_3-u_1)  +lambda_3*(u_1-u_2));
-          
-          min_u=0.5*(min_u/denominator);
-          u_1=min_u-2/(pow(float(i),0.01));
-          u_2=min_u;
-          u_3=min_u+2/(pow(float(i),0.01));
-          
+          if (trajectory_value(grid[k],&lambda_h) < trajectory_value(grid[k_min],&lambda_h)) k_min = k;
         }
-        // run downhill minimization routine to find exact minimum
-        double mu_lower = pow(10,u_1);
-        double mu_upper = pow(10,u_3);
-        mu_min = pow(10,u_2);
-        
-        gsl_function F;
-        F.function = &run_lambda;
-        F.params = &speccloned;
+        double u_min = grid[k_min];
+
+        // run downhill minimization routine on the interpolated coupling to find exact minimum
+        // (unless the coupling is still falling at one end of the range)
+        if (k_min > 0 and k_min < grid.size()-1)
+        {
+          double u_lower = grid[k_min-1];
+          double u_upper = grid[k_min+1];
+
+          gsl_function F;
+          F.function = &trajectory_value;
+          F.params = &lambda_h;
         
-        int status;
-        int iteration = 0, max_iteration = 1000;
+          int status;
+          int iteration = 0, max_iteration = 1000;
         
-        const gsl_min_fminimizer_type *T;
-        gsl_min_fminimizer *s;
+          const gsl_min_fminimizer_type *T;
+          gsl_min_fminimizer *s;
         
-        T = gsl_min_fminimizer_brent;
-        s = gsl_min_fminimizer_alloc (T);
-        gsl_min_fminimizer_set (s, &F, mu_min, mu_lower, mu_upper);
+          T = gsl_min_fminimizer_brent;
+          s = gsl_min_fminimizer_alloc (T);
+          gsl_min_fminimizer_set (s, &F, u_min, u_lower, u_upper);
  
-        do
-        {
-          iteration++;
-          status = gsl_min_fminimizer_iterate (s);
+          do
+          {
+            iteration++;
+            status = gsl_min_fminimizer_iterate (s);
           
-          mu_min = gsl_min_fminimizer_x_minimum (s);
-          mu_lower = gsl_min_fminimizer_x_lower (s);
-          mu_upper = gsl_min_fminimizer_x_upper (s);
+            u_min = gsl_min_fminimizer_x_minimum (s);
+            u_lower = gsl_min_fminimizer_x_lower (s);
+            u_upper = gsl_min_fminimizer_x_upper (s);
           
-          status = gsl_min_test_interval (mu_lower, mu_upper, 0.0001, 0.0001);
-        }
-        while (status == GSL_CONTINUE && iteration < max_iteration);
+            // same relative tolerance in the scale as before
+            status = gsl_min_test_interval (u_lower, u_upper, 0.0001/log(10.), 0.0);
+          }
+          while (status == GSL_CONTINUE && iteration < max_iteration);
         
-        if (iteration == max_iteration)
-        {
-          SpecBit_error().raise(LOCAL_INFO,"The minimum of the quartic coupling could not be found");
+          gsl_min_fminimizer_free (s);
+
+          if (iteration == max_iteration)
+          {
+            SpecBit_error().raise(LOCAL_INFO,"The minimum of the quartic coupling could not be found");
+          }
         }
-        
-        gsl_min_fminimizer_free (s);
-        
-        lambda_min = run_lambda(mu_min,&speccloned);
+        mu_min = pow(10,u_min);
+
+        // evaluate the coupling exactly at the minimum
+        speccloned->RunToScale(mu_min);
+        lambda_min = speccloned->get(Par::dimensionless,"lambda_h");
         
       }
       
@@ -262,7 +321,7 @@ namespace Gambit
         // vacuum is stable
       }
       // now do a check on the perturbativity of the couplings up to this scale
-      bool perturbative=check_perturb_to_min_lambda(fullspectrum,LB,check_perturb_pts);
+      bool perturbative=check_perturb_to_min_lambda(trajectory,LB,check_perturb_pts);
       double perturb=float(!perturbative);
 #ifdef SPECBIT_DEBUG
       cout << "perturbativity checked up to " << LB << " result = " << perturbative << endl;
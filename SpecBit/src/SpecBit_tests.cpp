@@ -703,7 +703,29 @@ namespace Gambit
          cout << "'(-1000013,0)' pole mass = " << clonedspec->get(Par::Pole_Mass,std::make_pair(-1000013,0)) << endl;
          cout << "'~e+,2' pole mass = " << clonedspec->get(Par::Pole_Mass,"~e+",2) << endl;
          cout << "'~e-,2' pole mass = " << clonedspec->get(Par::Pole_Mass,"~e-",2) << endl;
+         cout << endl;
 
+         /// Tests of parameter handles. The spectrum from SpecBit has overrides set (scales, mass
+         /// uncertainties), but these must not stop handles reusing their lookups for other parameters.
+         cout << "Test reuse of lookups by parameter handles" << endl;
+         const SpecParHandle M2(Par::mass1,"M2"), mstau1(Par::Pole_Mass,"~e-",3), mse2(Par::Pole_Mass,"~e-",2);
+         M2.get(spec); mstau1.get(spec); mse2.get(spec);
+         cout << "M2 lookup reused for SpecBit spectrum? " << M2.reuses_lookup_for(spec) << endl;
+         cout << "~e-(3) lookup reused for SpecBit spectrum? " << mstau1.reuses_lookup_for(spec) << endl;
+         cout << "~e-(3) lookup reused for clone with other overrides? " << mstau1.reuses_lookup_for(*clonedspec) << endl;
+         cout << "~e-(2) lookup reused for clone with ~e-(2) overridden? " << mse2.reuses_lookup_for(*clonedspec) << endl;
+         if(not (M2.reuses_lookup_for(spec) and mstau1.reuses_lookup_for(spec) and mstau1.reuses_lookup_for(*clonedspec)))
+         {
+            report << "------------------------------" << std::endl;
+            report << "TEST FAIL: parameter handles do not reuse their lookups for spectra with overrides of other parameters" << std::endl;
+         }
+         if(mse2.reuses_lookup_for(*clonedspec) or mse2.get(*clonedspec) != clonedspec->get(Par::Pole_Mass,"~e-",2)
+            or M2.get(*clonedspec) != clonedspec->get(Par::mass1,"M2") or mstau1.get(*clonedspec) != clonedspec->get(Par::Pole_Mass,"~e-",3))
+         {
+            report << "------------------------------" << std::endl;
+            report << "TEST FAIL: parameter handles do not return the same values as the getters" << std::endl;
+         }
+         cout << endl;
 
          cout << "Test report:" << std::endl << report.str();
 
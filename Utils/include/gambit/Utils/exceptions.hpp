@@ -338,6 +338,26 @@ namespace Gambit
   /// Global instance of Piped_exceptions class for warnings.
   extern Piped_exceptions piped_warnings;
 
+  /// Scope within which exceptions raised by this thread are caught inside the enclosing
+  /// OpenMP parallel block.  While one is open, errors and invalid points raised at the
+  /// OpenMP level where it was opened are thrown as they would be outside any parallel
+  /// block, rather than causing a hard stop.  Nested parallel blocks are not covered.
+  class Parallel_throw_scope
+  {
+    public:
+      /// Open the scope at the current OpenMP level.
+      Parallel_throw_scope();
+
+      /// Close the scope, restoring any scope opened before it.
+      ~Parallel_throw_scope();
+
+      /// Check whether an exception raised by this thread at the current OpenMP level may be thrown.
+      static bool throw_allowed();
+
+    private:
+      int previous_level;
+  };
+
 }
 
 
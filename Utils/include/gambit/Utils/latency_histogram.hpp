@@ -0,0 +1,83 @@
+//   GAMBIT: Global and Modular BSM Inference Tool
+//   *********************************************
+///  \file
+///
+///  Histogram of run times with logarithmic
+///  bins, for profiling.
+///
+///  *********************************************
+///
+///  Authors (add name and date if you modify):
+///
+///  \author agent
+///          (agent@local)
+///  \date 2026 Oct
+///
+///  *********************************************
+
+#ifndef __latency_histogram_hpp__
+#define __latency_histogram_hpp__
+
+#include <array>
+
+namespace Gambit
+{
+
+  namespace Utils
+  {
+
+    /// Histogram of durations (in seconds), with logarithmically spaced bins
+    /// covering 1 ns to 10^5 s at about 12% resolution. Adding a duration takes
+    /// no locks and allocates no memory, so each thread can keep its own
+    /// histogram and the histograms can be merged once the threads are done.
+    class LatencyHistogram
+    {
+      public:
+
+        LatencyHistogram() { clear(); }
+
+        /// Record a duration
+        void add(double seconds);
+
+        /// Add the contents of another histogram to this one
+        void merge(const LatencyHistogram&);
+
+        /// Empty the histogram
+        void clear();
+
+        /// Number of durations recorded
+        unsigned long long count() const { return n; }
+
+        /// Sum of durations recorded
+        double total() const { return sum; }
+
+        /// Longest duration recorded
+        double max() const { return longest; }
+
+        /// Mean duration recorded
+        double mean() const { return n > 0 ? sum/n : 0.0; }
+
+        /// Estimate of the q-quantile of the recorded durations (0 <= q <= 1),
+        /// accurate to within the width of a bin
+        double quantile(double q) const;
+
+      private:
+
+        static const int bins_per_decade = 20;
+        static const int min_exponent = -9;
+        static const int max_exponent = 5;
+        /// Logarithmic bins, plus one underflow and one overflow bin
+        static const int n_bins = bins_per_decade*(max_exponent - min_exponent) + 2;
+
+        std::array<unsigned long long, n_bins> bins;
+        unsigned long long n;
+        double sum;
+        double longest;
+
+    };
+
+  }
+
+}
+
+#endif
@@ -88,6 +88,10 @@ namespace Gambit {
 
       /// Set single parameter value
       void setValue(std::string const &inkey,double const&value);
+
+      /// Get a pointer to the stored value of a named parameter, for setting it repeatedly without
+      /// name lookups.  Valid for the lifetime of this object, as parameters are never removed.
+      double* getValuePtr(std::string const &inkey);
   
       /// Set many parameter values using a map
       void setValues(std::map<std::string,double> const &params_map, bool missing_is_error = true);
@@ -26,6 +26,7 @@
 #include "gambit/Utils/exceptions.hpp"
 #include "gambit/Utils/standalone_error_handlers.hpp"
 #include "gambit/Logs/logger.hpp"
+#include "gambit/Logs/logmaster.hpp"
 
 namespace Gambit
 {
@@ -258,10 +259,10 @@ namespace Gambit
       logger() << msg.str() << EOM;
     }
 
-    /// Throw the exception onward if running serially, abort if not.
+    /// Throw the exception onward if running serially (or where it will be caught), abort if not.
     void exception::throw_iff_outside_parallel()
     {
-      if (omp_get_level()==0) // If not in an OpenMP parallel block, throw onwards
+      if (Parallel_throw_scope::throw_allowed()) // If not in an OpenMP parallel block (or caught within it), throw onwards
       {
         throw(*this);
       }
@@ -284,6 +285,7 @@ namespace Gambit
              << "may have to be killed manually (though your MPI implementation " << endl
              << "may automatically kill them).  For more 'gentle' handling of " << endl
              << "errors in OpenMP loops, please raise errors using the Piped_exceptions system." << endl;
+        logger().flush();
         #ifdef WITH_MPI
           GMPI::Comm().Abort();
         #else
@@ -420,7 +422,7 @@ namespace Gambit
     /// Raise the exception, i.e. throw it with a message.
     void invalid_point_exception::raise(const std::string& msg)
     {
-      if (omp_get_level()==0) // If not in an OpenMP parallel block, throw onwards
+      if (Parallel_throw_scope::throw_allowed()) // If not in an OpenMP parallel block (or caught within it), throw onwards
       {
         #pragma omp critical (GAMBIT_exception)
         {
@@ -450,6 +452,7 @@ namespace Gambit
       {
         cout << endl << " \033[00;31;1mFATAL ERROR\033[00m" << endl << endl;
         cout << "An invalid_point exception is fatal inside an OpenMP block. " << endl << what() << endl << message() << endl;
+        logger().flush();
         #ifdef WITH_MPI
           GMPI::Comm().Abort();
         #else
@@ -489,6 +492,7 @@ namespace Gambit
           if (this->flag)
             cout << "Invalid point message requested: " << endl << this->message;
           else cout << "No invalid point requested." << endl;
+          logger().flush();
           #ifdef WITH_MPI
             GMPI::Comm().Abort();
           #else
@@ -573,6 +577,7 @@ namespace Gambit
             }
           }
           else cout << "No exceptions stored." << endl;
+          logger().flush();
           #ifdef WITH_MPI
             GMPI::Comm().Abort();
           #else
@@ -593,6 +598,25 @@ namespace Gambit
 
     /// Global instance of Piped_exceptions class for warnings.
     Piped_exceptions piped_warnings(1000);
-}
 
+    /// OpenMP level at which the innermost open Parallel_throw_scope of this thread was opened (-1 if none)
+    static thread_local int parallel_throw_level = -1;
 
+    /// @{ Parallel_throw_scope member functions
+    Parallel_throw_scope::Parallel_throw_scope() : previous_level(parallel_throw_level)
+    {
+      parallel_throw_level = omp_get_level();
+    }
+
+    Parallel_throw_scope::~Parallel_throw_scope()
+    {
+      parallel_throw_level = previous_level;
+    }
+
+    bool Parallel_throw_scope::throw_allowed()
+    {
+      const int level = omp_get_level();
+      return level == 0 or level == parallel_throw_level;
+    }
+    /// @}
+}
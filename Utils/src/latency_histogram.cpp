@@ -0,0 +1,90 @@
+//   GAMBIT: Global and Modular BSM Inference Tool
+//   *********************************************
+///  \file
+///
+///  Histogram of run times with logarithmic
+///  bins, for profiling.
+///
+///  *********************************************
+///
+///  Authors (add name and date if you modify):
+///
+///  \author agent
+///          (agent@local)
+///  \date 2026 Oct
+///
+///  *********************************************
+
+#include <cmath>
+#include <algorithm>
+
+#include "gambit/Utils/latency_histogram.hpp"
+
+namespace Gambit
+{
+
+  namespace Utils
+  {
+
+    const int LatencyHistogram::bins_per_decade;
+    const int LatencyHistogram::min_exponent;
+    const int LatencyHistogram::max_exponent;
+    const int LatencyHistogram::n_bins;
+
+    void LatencyHistogram::add(double seconds)
+    {
+      int bin;
+      if (not (seconds > 0.0)) bin = 0;
+      else
+      {
+        double x = (std::log10(seconds) - min_exponent) * bins_per_decade;
+        if (x < 0.0) bin = 0;
+        else if (x >= n_bins - 2) bin = n_bins - 1;
+        else bin = 1 + int(x);
+      }
+      bins[bin]++;
+      n++;
+      sum += seconds;
+      longest = std::max(longest, seconds);
+    }
+
+    void LatencyHistogram::merge(const LatencyHistogram& other)
+    {
+      for (int i = 0; i < n_bins; ++i) bins[i] += other.bins[i];
+      n += other.n;
+      sum += other.sum;
+      longest = std::max(longest, other.longest);
+    }
+
+    void LatencyHistogram::clear()
+    {
+      bins.fill(0);
+      n = 0;
+      sum = 0.0;
+      longest = 0.0;
+    }
+
+    double LatencyHistogram::quantile(double q) const
+    {
+      if (n == 0) return 0.0;
+      // Rank of the requested duration among all those recorded (1 to n)
+      unsigned long long rank = std::max(1ULL, (unsigned long long)std::ceil(q*n));
+      unsigned long long seen = 0;
+      for (int i = 0; i < n_bins; ++i)
+      {
+        seen += bins[i];
+        if (seen >= rank)
+        {
+          if (i == 0) return std::pow(10.0, min_exponent);
+          if (i == n_bins - 1) return longest;
+          // Geometric centre of the bin, but never more than the longest duration seen
+          double centre = std::pow(10.0, min_exponent + (i - 0.5)/bins_per_decade);
+          return std::min(centre, longest);
+        }
+      }
+      return longest;
+    }
+
+  }
+
+}
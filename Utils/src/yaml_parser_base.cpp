@@ -273,6 +273,15 @@ namespace Gambit
       bool master_debug = (keyValuePairNode["debug"]) ? keyValuePairNode["debug"].as<bool>() : false;
       bool logger_debug = (logNode["debug"])          ? logNode["debug"].as<bool>()          : false;
       logger().set_log_debug_messages(master_debug or logger_debug);
+      // Options for writing the logs from a separate thread
+      bool async = (logNode["async"]) ? logNode["async"].as<bool>() : false;
+      std::size_t async_length = (logNode["async_buffer_length"]) ? logNode["async_buffer_length"].as<std::size_t>() : 1024;
+      std::string async_full = (logNode["async_when_full"]) ? logNode["async_when_full"].as<std::string>() : "block";
+      if (async_full != "block" and async_full != "drop")
+      {
+        inifile_error().raise(LOCAL_INFO, "Logger option async_when_full must be either 'block' or 'drop'.");
+      }
+      logger().set_async_logging(async, async_length, async_full == "block");
       logger().initialise(loggerinfo);
 
       // Parse the Parameters node and expand out some shorthand syntax
@@ -23,3 +23,10 @@ add_standalone(DarkBit_standalone_SingletDM SOURCES DarkBit/examples/DarkBit_sta
 add_standalone(DarkBit_standalone_WIMP SOURCES DarkBit/examples/DarkBit_standalone_WIMP.cpp MODULES DarkBit)
 add_standalone(3bithit SOURCES DecayBit/examples/3bithit.cpp MODULES DecayBit SpecBit PrecisionBit)
 add_standalone(FlavBit_standalone SOURCES FlavBit/examples/FlavBit_standalone_example.cpp MODULES FlavBit)
+
+# Regression checks for the concurrency and numerical optimisations, built in the same way.
+add_standalone(ExampleBit_A_regression_checks SOURCES ExampleBit_A/examples/ExampleBit_A_regression_checks.cpp MODULES ExampleBit_A)
+add_standalone(DarkBit_regression_checks SOURCES DarkBit/examples/DarkBit_regression_checks.cpp MODULES DarkBit)
+add_standalone(FlavBit_regression_checks SOURCES FlavBit/examples/FlavBit_regression_checks.cpp MODULES FlavBit)
+add_standalone(SpecBit_vacuum_stability_check SOURCES SpecBit/examples/SpecBit_vacuum_stability_check.cpp MODULES SpecBit)
+add_standalone(ColliderBit_regression_checks SOURCES ColliderBit/examples/ColliderBit_regression_checks.cpp MODULES ColliderBit)
@@ -10,6 +10,7 @@
 
 #include "HEPUtils/MathUtils.h"
 #include "HEPUtils/Vectors.h"
+#include "HEPUtils/Pool.h"
 
 namespace HEPUtils {
 
@@ -43,6 +44,13 @@ namespace HEPUtils {
     //@}
 
 
+    /// @name Allocation from the calling thread's pool of Jet-sized blocks
+    //@{
+    static void* operator new(size_t n) { return BlockPool<Jet>::allocate(n); }
+    static void operator delete(void* p, size_t n) { BlockPool<Jet>::deallocate(p, n); }
+    //@}
+
+
     /// @name Implicit casts
     //@{
 
@@ -10,6 +10,7 @@
 
 #include "HEPUtils/MathUtils.h"
 #include "HEPUtils/Vectors.h"
+#include "HEPUtils/Pool.h"
 
 namespace HEPUtils {
 
@@ -75,6 +76,13 @@ namespace HEPUtils {
     //@}
 
 
+    /// @name Allocation from the calling thread's pool of Particle-sized blocks
+    //@{
+    static void* operator new(size_t n) { return BlockPool<Particle>::allocate(n); }
+    static void operator delete(void* p, size_t n) { BlockPool<Particle>::deallocate(p, n); }
+    //@}
+
+
     /// @name Implicit casts
     //@{
 
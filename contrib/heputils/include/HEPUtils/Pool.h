@@ -0,0 +1,75 @@
+// -*- C++ -*-
+//
+// This file is part of HEPUtils -- https://bitbucket.org/andybuckley/heputils
+// Copyright (C) 2013-2015 Andy Buckley <andy.buckley@cern.ch>
+//
+// Embedding of HEPUtils code in other projects is permitted provided this
+// notice is retained and the HEPUtils namespace and include path are changed.
+//
+#pragma once
+
+#include <cstddef>
+#include <new>
+
+/// @file Per-thread pools of memory blocks for event objects
+
+namespace HEPUtils {
+
+
+  /// @brief Per-thread free list of memory blocks the size of a T
+  ///
+  /// Used for the class-specific new and delete of the objects that are created and
+  /// destroyed in large numbers for every event (Particle and Jet), so that once the
+  /// first few events have been processed, each thread recycles the objects freed by
+  /// Event::clear() and the efficiency filters instead of going to the heap allocator.
+  ///
+  /// Blocks are handed back to the pool of the thread that frees them, whichever thread
+  /// allocated them. Each thread keeps at most max_free() spare blocks; the spare blocks
+  /// of a thread are not returned to the heap when the thread ends.
+  template <typename T>
+  class BlockPool {
+  public:
+
+    /// Get a block of n bytes
+    static void* allocate(size_t n) {
+      if (n != sizeof(T) || _head() == nullptr) return ::operator new(n);
+      Block* b = _head();
+      _head() = b->next;
+      --_nfree();
+      return b;
+    }
+
+    /// Return a block of n bytes
+    static void deallocate(void* p, size_t n) {
+      if (p == nullptr) return;
+      if (n != sizeof(T) || _nfree() >= max_free()) {
+        ::operator delete(p);
+        return;
+      }
+      Block* b = static_cast<Block*>(p);
+      b->next = _head();
+      _head() = b;
+      ++_nfree();
+    }
+
+    /// Maximum number of spare blocks kept by each thread
+    static size_t max_free() { return 65536; }
+
+    /// Number of spare blocks currently held by the calling thread
+    static size_t num_free() { return _nfree(); }
+
+
+  private:
+
+    struct Block { Block* next; };
+    static_assert(sizeof(T) >= sizeof(Block), "BlockPool needs objects at least as large as a pointer");
+
+    /// @note Plain pointers and counters, so that they need no destruction at thread exit
+    /// and stay usable by objects freed during static destruction.
+    static Block*& _head() { static thread_local Block* head = nullptr; return head; }
+    static size_t& _nfree() { static thread_local size_t nfree = 0; return nfree; }
+
+  };
+
+
+}